@@ -0,0 +1,152 @@
+#pragma once
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "Point2D.h"
+#include "Polygon.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief Gets the peak resident set size of the benchmark process.
+ * @return The peak RSS in megabytes.
+ */
+inline double peakRssMB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<double>(usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#endif
+#endif
+}
+
+/**
+ * @brief Builds the demo domain from main.cpp: a non-convex polygon with concave notches.
+ * @return The polygon.
+ */
+inline Polygon makeNotchedPolygon() {
+    return Polygon({ {.3f,0.f}, {.5f,.5f}, {1.0f, .3f}, {1.2f , 1.0f} ,{1.0f,1.2f}, {.7f,.8f}, {0.6f,.6f}, {0.0f,.8f} });
+}
+
+/**
+ * @brief Generates the vertices of a star-shaped polygon around the origin.
+ * Vertices are evenly spaced in angle; even vertices lie on the outer radius and odd ones on
+ * the inner radius, optionally jittered, so the outline is always simple.
+ * @param n Number of vertices.
+ * @param inner Radius of the odd vertices.
+ * @param outer Radius of the even vertices.
+ * @param jitter Maximum random radial perturbation (default = 0).
+ * @return The vertices in counterclockwise order.
+ */
+inline std::vector<Point2D> starVertices(int n, double inner, double outer, double jitter = 0.0) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> noise(-jitter, jitter);
+
+    std::vector<Point2D> vertices;
+    vertices.reserve(n);
+    for (int k = 0; k < n; k++) {
+        const double angle = 2.0 * 3.14159265358979323846 * k / n;
+        const double radius = ((k % 2 == 0) ? outer : inner) + (jitter > 0.0 ? noise(rng) : 0.0);
+        vertices.emplace_back(static_cast<float>(radius * std::cos(angle)), static_cast<float>(radius * std::sin(angle)));
+    }
+    return vertices;
+}
+
+/**
+ * @brief enum class naming the generated polygon families of the geometry benchmarks.
+ * CONVEX: Regular polygon, the easy case for every query.
+ * STAR: Alternating radii, one concave notch per vertex pair.
+ * SPIRAL: Thick spiral strip of three turns; scan lines cross many edges.
+ * COMB: Base bar with long narrow teeth; many short interior spans.
+ */
+enum class PolygonFamily : int8_t {
+    CONVEX,
+    STAR,
+    SPIRAL,
+    COMB
+};
+
+/**
+ * @brief Gets the name of a polygon family, used as the benchmark label.
+ * @param family The family.
+ * @return The lower-case name.
+ */
+inline const char* familyName(PolygonFamily family) {
+    switch (family) {
+    case PolygonFamily::CONVEX: return "convex";
+    case PolygonFamily::STAR: return "star";
+    case PolygonFamily::SPIRAL: return "spiral";
+    default: return "comb";
+    }
+}
+
+/**
+ * @brief Generates the vertices of a polygon of a family with about n vertices.
+ * All families are simple and fit in [-1, 1]^2; SPIRAL rounds n down to an even count and
+ * COMB to a multiple of 4.
+ * @param family The family.
+ * @param n Requested number of vertices.
+ * @return The vertices in counterclockwise order.
+ */
+inline std::vector<Point2D> familyVertices(PolygonFamily family, int n) {
+    constexpr double pi = 3.14159265358979323846;
+    std::vector<Point2D> vertices;
+    switch (family) {
+    case PolygonFamily::CONVEX:
+        for (int k = 0; k < n; k++) {
+            const double angle = 2.0 * pi * k / n;
+            vertices.emplace_back(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+        }
+        break;
+    case PolygonFamily::STAR:
+        vertices = starVertices(n, 0.5, 1.0);
+        break;
+    case PolygonFamily::SPIRAL: {
+        // Outer arm out along increasing angle, inner arm back; turns are 0.3 apart and the strip 0.15 wide
+        const int half = std::max(3, n / 2);
+        const double sweep = 3 * 2.0 * pi;
+        auto radius = [&](double t) { return 0.2 + 0.3 * t / (2.0 * pi); };
+        for (int k = 0; k < half; k++) {
+            const double t = sweep * k / (half - 1);
+            vertices.emplace_back(static_cast<float>(radius(t) * std::cos(t) / 1.3), static_cast<float>(radius(t) * std::sin(t) / 1.3));
+        }
+        for (int k = half - 1; k >= 0; k--) {
+            const double t = sweep * k / (half - 1);
+            const double r = radius(t) - 0.15;
+            vertices.emplace_back(static_cast<float>(r * std::cos(t) / 1.3), static_cast<float>(r * std::sin(t) / 1.3));
+        }
+        break;
+    }
+    case PolygonFamily::COMB: {
+        // Teeth of width w on [2 k w, (2 k + 1) w] standing on a bar of height 0.2; the last tooth ends at x = 1
+        const int teeth = std::max(1, n / 4);
+        const double w = 1.0 / (2 * teeth - 1);
+        auto at = [&](double x, double y) { vertices.emplace_back(static_cast<float>(2.0 * x - 1.0), static_cast<float>(2.0 * y - 1.0)); };
+        at(0.0, 0.0);
+        at(1.0, 0.0);
+        for (int k = teeth - 1; k >= 0; k--) {
+            if (k < teeth - 1) at((2 * k + 1) * w, 0.2);
+            at((2 * k + 1) * w, 1.0);
+            at(2 * k * w, 1.0);
+            if (k > 0) at(2 * k * w, 0.2);
+        }
+        break;
+    }
+    }
+    return vertices;
+}
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include "DistributedPoissonSolver.h"
+#include "bench_common.h"
+#include <chrono>
+
+namespace {
+    double source(const Point2D& p) {
+        return 1.0 + p.x * p.y;
+    }
+
+    double zero(const Point2D&) {
+        return 0.0;
+    }
+
+    // Distributed CG solve of an n x n grid over in-process ranks; times the solve on rank 0 only,
+    // excluding thread start-up and assembly, and reports the share spent in halo exchanges
+    void runDistributedSolve(benchmark::State& state, int n, int ranks) {
+        Polygon polygon = makeNotchedPolygon();
+        DomainDecomposition decomposition(n, n, ranks);
+        SharedMemoryWorld world(ranks);
+
+        int iterations = 0;
+        double haloMilliseconds = 0.0, solveMilliseconds = 0.0;
+        int64_t valuesPerExchange = 0;
+        for (auto _ : state) {
+            world.run([&](Communicator& comm) {
+                DistributedPoissonSolver solver(polygon, decomposition, comm);
+                comm.barrier();
+                const auto start = std::chrono::steady_clock::now();
+                SolveResult result = solver.solve(source, zero, {1e-8, 100000});
+                const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (comm.getRank() != 0) return;
+                iterations = result.iterations;
+                solveMilliseconds = milliseconds;
+                haloMilliseconds = solver.getHaloStats().milliseconds;
+                valuesPerExchange = solver.getHaloStats().valuesSent / std::max<int64_t>(1, solver.getHaloStats().exchanges);
+            });
+            state.SetIterationTime(solveMilliseconds * 1e-3);
+        }
+        state.counters["ranks"] = ranks;
+        state.counters["iterations"] = iterations;
+        state.counters["halo_fraction"] = solveMilliseconds > 0.0 ? haloMilliseconds / solveMilliseconds : 0.0;
+        state.counters["halo_values"] = static_cast<double>(valuesPerExchange);
+        state.counters["peak_rss_MB"] = peakRssMB();
+    }
+}
+
+// Strong scaling: a fixed 513 x 513 grid over an increasing number of ranks
+static void BM_DistributedStrongScaling(benchmark::State& state) {
+    runDistributedSolve(state, 513, static_cast<int>(state.range(0)));
+}
+BENCHMARK(BM_DistributedStrongScaling)->RangeMultiplier(2)->Range(1, 16)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+// Weak scaling: about 129 x 129 nodes per rank, the grid growing with the rank count
+static void BM_DistributedWeakScaling(benchmark::State& state) {
+    const int ranks = static_cast<int>(state.range(0));
+    const int n = 1 + static_cast<int>(std::lround(128.0 * std::sqrt(static_cast<double>(ranks))));
+    runDistributedSolve(state, n, ranks);
+}
+BENCHMARK(BM_DistributedWeakScaling)->Arg(1)->Arg(4)->Arg(9)->Arg(16)->UseManualTime()->Unit(benchmark::kMillisecond);
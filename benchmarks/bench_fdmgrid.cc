@@ -0,0 +1,185 @@
+#include <benchmark/benchmark.h>
+#include "FDMGrid.h"
+#include "PackedCells.h"
+#include "QuadtreeGrid.h"
+#include "bench_common.h"
+
+namespace {
+    // Star-shaped polygon with alternating inner and outer radius, n vertices
+    Polygon makeStarPolygon(int n) {
+        return Polygon(starVertices(n, 0.8, 1.0));
+    }
+}
+
+// Construction time of an n x n grid; peak RSS is reported as a counter
+static void BM_FDMGridConstruction(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        FDMGrid grid(n, n, polygon);
+        benchmark::DoNotOptimize(grid.getCells().data());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+    state.counters["peak_rss_MB"] = peakRssMB();
+}
+BENCHMARK(BM_FDMGridConstruction)->RangeMultiplier(4)->Range(128, 8192)->Unit(benchmark::kMillisecond);
+
+// Construction of a large grid with an increasing number of classification threads
+static void BM_FDMGridConstructionThreads(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = 8192;
+    const unsigned threads = static_cast<unsigned>(state.range(0));
+
+    for (auto _ : state) {
+        FDMGrid grid(n, n, polygon, threads);
+        benchmark::DoNotOptimize(grid.getCells().data());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_FDMGridConstructionThreads)->RangeMultiplier(2)->Range(1, 64)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Enumerating all interior cells as world coordinates
+static void BM_FDMGridInteriorPoints(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+
+    for (auto _ : state) {
+        std::vector<Point2D> points = grid.getInteriorPoints();
+        benchmark::DoNotOptimize(points.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_FDMGridInteriorPoints)->RangeMultiplier(4)->Range(128, 2048)->Unit(benchmark::kMillisecond);
+
+// Visiting the interior cells as world coordinates through the lazy view, without allocating
+static void BM_FDMGridInteriorView(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const Point2D& p : grid.pointsOfType(INTERIOR)) sum += p.x;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_FDMGridInteriorView)->RangeMultiplier(4)->Range(128, 2048)->Unit(benchmark::kMillisecond);
+
+// The same enumeration from the 2-bit packed classification; runs of other cells are skipped a word at a time
+static void BM_PackedCellsInteriorPoints(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    PackedCells packed(grid);
+
+    for (auto _ : state) {
+        std::vector<Point2D> points = packed.getPointsOfType(INTERIOR);
+        benchmark::DoNotOptimize(points.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+    state.counters["packed_MB"] = static_cast<double>(packed.getMemoryBytes()) / (1024.0 * 1024.0);
+    state.counters["bytes_MB"] = static_cast<double>(grid.getCells().size()) / (1024.0 * 1024.0);
+}
+BENCHMARK(BM_PackedCellsInteriorPoints)->RangeMultiplier(4)->Range(128, 2048)->Unit(benchmark::kMillisecond);
+
+// Counting boundary cells: a byte scan against popcount over the packed words
+static void BM_CountBoundaryCells(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    const bool usePacked = state.range(1) != 0;
+    FDMGrid grid(n, n, polygon);
+    PackedCells packed(grid);
+
+    for (auto _ : state) {
+        std::span<const GridType> cells = grid.getCells();
+        size_t count = usePacked ? packed.count(BOUNDARY) : static_cast<size_t>(std::count(cells.begin(), cells.end(), BOUNDARY));
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_CountBoundaryCells)->ArgsProduct({{512, 4096}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// Construction cost as the edge count grows on a fixed 2048^2 grid
+static void BM_FDMGridConstructionEdges(benchmark::State& state) {
+    Polygon polygon = makeStarPolygon(static_cast<int>(state.range(0)));
+    const int n = 2048;
+
+    for (auto _ : state) {
+        FDMGrid grid(n, n, polygon);
+        benchmark::DoNotOptimize(grid.getCells().data());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_FDMGridConstructionEdges)->RangeMultiplier(4)->Range(16, 2048)->Unit(benchmark::kMillisecond);
+
+// One shape-optimization step: an inner vertex of a 1024-vertex star moves, then the grid is
+// updated in place (rebuild = 0) or constructed again (rebuild = 1)
+static void BM_FDMGridMoveVertex(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const bool rebuild = state.range(1) != 0;
+    const int vertices = 1024;
+    Polygon polygon = makeStarPolygon(vertices);
+    FDMGrid grid(n, n, polygon);
+
+    const size_t k = vertices / 4 + 1;
+    const double angle = 2.0 * 3.14159265358979323846 * k / vertices;
+    const Point2D positions[] = {
+        Point2D(static_cast<float>(0.75 * std::cos(angle)), static_cast<float>(0.75 * std::sin(angle))),
+        Point2D(static_cast<float>(0.85 * std::cos(angle)), static_cast<float>(0.85 * std::sin(angle)))};
+    size_t step = 0, changed = 0;
+    for (auto _ : state) {
+        const VertexMove move{k, positions[step++ % 2]};
+        if (rebuild) {
+            polygon.moveVertices({&move, 1});
+            FDMGrid fresh(n, n, polygon);
+            benchmark::DoNotOptimize(fresh.getCells().data());
+        }
+        else {
+            changed += grid.moveVertices(polygon, {&move, 1}).changedCells.size();
+        }
+    }
+    state.counters["changed_cells"] = benchmark::Counter(static_cast<double>(changed), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FDMGridMoveVertex)->ArgsProduct({{512, 2048}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// Quadtree refined to the resolution of a 2^depth x 2^depth grid; compare with BM_FDMGridConstruction
+// at n = 2^depth. leaf_ratio is the fraction of the uniform grid's cells the tree keeps
+static void BM_QuadtreeConstruction(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    QuadtreeOptions options;
+    options.maxDepth = static_cast<int>(state.range(0));
+
+    size_t leaves = 0;
+    for (auto _ : state) {
+        QuadtreeGrid tree(polygon, options);
+        leaves = tree.getLeafCount();
+        benchmark::DoNotOptimize(tree.getLeaves().data());
+    }
+    state.SetItemsProcessed(state.iterations() * leaves);
+    state.counters["leaves"] = static_cast<double>(leaves);
+    state.counters["leaf_ratio"] = static_cast<double>(leaves) / static_cast<double>(uint64_t{1} << (2 * options.maxDepth));
+}
+BENCHMARK(BM_QuadtreeConstruction)->DenseRange(7, 13, 2)->Unit(benchmark::kMillisecond);
+
+// Neighbour lookup over every leaf and side, the access pattern of a stencil sweep
+static void BM_QuadtreeNeighbours(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    QuadtreeOptions options;
+    options.maxDepth = static_cast<int>(state.range(0));
+    QuadtreeGrid tree(polygon, options);
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (size_t k = 0; k < tree.getLeafCount(); k++) {
+            for (QuadDirection direction : {QuadDirection::WEST, QuadDirection::EAST, QuadDirection::SOUTH, QuadDirection::NORTH}) {
+                sum += tree.findNeighbour(k, direction);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * tree.getLeafCount() * 4);
+}
+BENCHMARK(BM_QuadtreeNeighbours)->DenseRange(7, 13, 2)->Unit(benchmark::kMillisecond);
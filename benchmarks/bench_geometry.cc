@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include "FDMGrid.h"
+#include "bench_common.h"
+
+// Geometry and grid hot paths over the generated polygon families: arg 0 is the PolygonFamily,
+// arg 1 the vertex count. The family name is the label, so JSON output can be grouped by it
+
+namespace {
+    const std::vector<int64_t> families = {
+        static_cast<int>(PolygonFamily::CONVEX), static_cast<int>(PolygonFamily::STAR),
+        static_cast<int>(PolygonFamily::SPIRAL), static_cast<int>(PolygonFamily::COMB)};
+
+    PolygonFamily familyOf(const benchmark::State& state) {
+        return static_cast<PolygonFamily>(state.range(0));
+    }
+
+    // Query points uniformly covering [-1.1, 1.1]^2, around every family
+    std::vector<Point2D> makeQueries(size_t count) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coordinate(-1.1f, 1.1f);
+        std::vector<Point2D> queries;
+        queries.reserve(count);
+        for (size_t q = 0; q < count; q++) queries.emplace_back(coordinate(rng), coordinate(rng));
+        return queries;
+    }
+
+    // A k x k array of square holes of half the pitch, centred in the cells of the unit square
+    std::vector<std::vector<Point2D>> squareHoles(int k) {
+        std::vector<std::vector<Point2D>> holes;
+        for (int hy = 0; hy < k; hy++) {
+            for (int hx = 0; hx < k; hx++) {
+                const float x0 = (hx + 0.25f) / k, y0 = (hy + 0.25f) / k, size = 0.5f / k;
+                holes.push_back({ {x0, y0}, {x0 + size, y0}, {x0 + size, y0 + size}, {x0, y0 + size} });
+            }
+        }
+        return holes;
+    }
+}
+
+// Polygon construction: bounds, validation (sweep line) and the query index
+static void BM_FamilyPolygonConstruction(benchmark::State& state) {
+    const std::vector<Point2D> vertices = familyVertices(familyOf(state), static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        Polygon polygon(vertices);
+        benchmark::DoNotOptimize(polygon.getMinX());
+    }
+    state.SetLabel(familyName(familyOf(state)));
+    state.SetItemsProcessed(state.iterations() * vertices.size());
+    state.counters["vertices"] = static_cast<double>(vertices.size());
+}
+BENCHMARK(BM_FamilyPolygonConstruction)->ArgsProduct({families, {64, 4096, 262144}})->Unit(benchmark::kMillisecond);
+
+// containsPoint on points spread over the bounding box
+static void BM_FamilyContainsPoint(benchmark::State& state) {
+    Polygon polygon(familyVertices(familyOf(state), static_cast<int>(state.range(1))));
+    const std::vector<Point2D> queries = makeQueries(1 << 14);
+    for (auto _ : state) {
+        int inside = 0;
+        for (const Point2D& q : queries) inside += polygon.containsPoint(q);
+        benchmark::DoNotOptimize(inside);
+    }
+    state.SetLabel(familyName(familyOf(state)));
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_FamilyContainsPoint)->ArgsProduct({families, {64, 4096, 65536}})->Unit(benchmark::kMillisecond);
+
+// isOnBoundary on points lying on the edges, half of them nudged off
+static void BM_FamilyIsOnBoundary(benchmark::State& state) {
+    const std::vector<Point2D> vertices = familyVertices(familyOf(state), static_cast<int>(state.range(1)));
+    Polygon polygon(vertices);
+    std::vector<Point2D> queries;
+    for (size_t q = 0; q < 4096; q++) {
+        const Point2D& a = vertices[q % vertices.size()];
+        const Point2D& b = vertices[(q + 1) % vertices.size()];
+        queries.push_back(a + (b - a) * 0.37f + Point2D(0.0f, q % 2 ? 1e-3f : 0.0f));
+    }
+    for (auto _ : state) {
+        int hits = 0;
+        for (const Point2D& q : queries) hits += polygon.isOnBoundary(q, 1e-5f);
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetLabel(familyName(familyOf(state)));
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_FamilyIsOnBoundary)->ArgsProduct({families, {64, 4096, 65536}})->Unit(benchmark::kMillisecond);
+
+// FDMGrid construction (classification and boundary arms); arg 2 is the grid size n x n
+static void BM_FamilyFDMGridConstruction(benchmark::State& state) {
+    Polygon polygon(familyVertices(familyOf(state), static_cast<int>(state.range(1))));
+    const int n = static_cast<int>(state.range(2));
+    size_t interior = 0;
+    for (auto _ : state) {
+        FDMGrid grid(n, n, polygon);
+        interior = grid.getCellCount(INTERIOR);
+        benchmark::DoNotOptimize(grid.getCells().data());
+    }
+    state.SetLabel(familyName(familyOf(state)));
+    state.SetItemsProcessed(state.iterations() * n * n);
+    state.counters["interior_fraction"] = static_cast<double>(interior) / (static_cast<double>(n) * n);
+    state.counters["peak_rss_MB"] = peakRssMB();
+}
+BENCHMARK(BM_FamilyFDMGridConstruction)->ArgsProduct({families, {64, 4096}, {512, 2048}})->Unit(benchmark::kMillisecond);
+
+// FDMGrid construction over a plate with a k x k array of square holes (arg 0 = k) on a 1024^2 grid:
+// every ring goes through one edge table, so the cost follows the total edge count
+static void BM_DomainFDMGridConstruction(benchmark::State& state) {
+    const std::vector<std::vector<Point2D>> holes = squareHoles(static_cast<int>(state.range(0)));
+    const Domain domain({ {0.f, 0.f}, {1.f, 0.f}, {1.f, 1.f}, {0.f, 1.f} }, holes);
+
+    size_t interior = 0;
+    for (auto _ : state) {
+        FDMGrid grid(1024, 1024, domain);
+        interior = grid.getCellCount(INTERIOR);
+        benchmark::DoNotOptimize(grid.getCells().data());
+    }
+    state.SetItemsProcessed(state.iterations() * 1024 * 1024);
+    state.counters["edges"] = static_cast<double>(domain.getEdgeCount());
+    state.counters["interior_fraction"] = static_cast<double>(interior) / (1024.0 * 1024.0);
+}
+BENCHMARK(BM_DomainFDMGridConstruction)->Arg(0)->Arg(4)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
+
+// Validating all rings of the same plates with one sweep
+static void BM_DomainValidation(benchmark::State& state) {
+    const std::vector<std::vector<Point2D>> holes = squareHoles(static_cast<int>(state.range(0)));
+    const std::vector<Point2D> outer = { {0.f, 0.f}, {1.f, 0.f}, {1.f, 1.f}, {0.f, 1.f} };
+    for (auto _ : state) {
+        Domain domain(outer, holes);
+        benchmark::DoNotOptimize(domain.getMinX());
+    }
+    state.counters["holes"] = static_cast<double>(holes.size());
+}
+BENCHMARK(BM_DomainValidation)->Arg(4)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
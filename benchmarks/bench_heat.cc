@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include "HeatStepper.h"
+#include "ImplicitHeatStepper.h"
+#include "RedBlackSmoother.h"
+#include "bench_common.h"
+
+namespace {
+    constexpr int stepsPerIteration = 16;
+
+    // A naive step streams the field in and out once: 16 bytes per node and step
+    void setCounters(benchmark::State& state, int n) {
+        const double updates = static_cast<double>(state.iterations()) * stepsPerIteration * n * n;
+        state.counters["node_updates"] = benchmark::Counter(updates, benchmark::Counter::kIsRate);
+        state.counters["naive_GB"] = benchmark::Counter(updates * 2 * sizeof(double) * 1e-9, benchmark::Counter::kIsRate);
+        state.counters["peak_rss_MB"] = peakRssMB();
+    }
+}
+
+// One full-grid sweep per time step
+static void BM_HeatStepNaive(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    HeatStepper stepper(grid, 1.0, 0.9 * HeatStepper::maxStableTimeStep(grid, 1.0));
+    GridField u = RedBlackSmoother::sample(grid, [](const Point2D& p) { return p.x * p.y; });
+
+    for (auto _ : state) {
+        stepper.stepNaive(u, stepsPerIteration);
+        benchmark::DoNotOptimize(u.getValues().data());
+    }
+    setCounters(state, n);
+}
+BENCHMARK(BM_HeatStepNaive)->Arg(512)->Arg(2048)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// Temporally tiled steps; the second argument is the number of steps per pass over memory
+static void BM_HeatStepTiled(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    HeatTiling tiling;
+    tiling.timeSteps = static_cast<int>(state.range(1));
+    HeatStepper stepper(grid, 1.0, 0.9 * HeatStepper::maxStableTimeStep(grid, 1.0), tiling);
+    GridField u = RedBlackSmoother::sample(grid, [](const Point2D& p) { return p.x * p.y; });
+
+    for (auto _ : state) {
+        stepper.step(u, stepsPerIteration);
+        benchmark::DoNotOptimize(u.getValues().data());
+    }
+    setCounters(state, n);
+}
+BENCHMARK(BM_HeatStepTiled)->ArgsProduct({{512, 2048, 4096}, {1, 4, 8, 16}})->Unit(benchmark::kMillisecond);
+
+// Implicit steps at 50x the explicit limit; the time per step is the latency of one warm-started solve
+static void BM_ImplicitHeatStep(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    ImplicitHeatStepper stepper(grid, 1.0, 50 * HeatStepper::maxStableTimeStep(grid, 1.0),
+        static_cast<TimeScheme>(state.range(1)), static_cast<PreconditionerType>(state.range(2)));
+    GridField u = RedBlackSmoother::sample(grid, [](const Point2D& p) { return std::sin(5.0 * p.x) + p.y * p.y; });
+
+    for (auto _ : state) {
+        stepper.step(u, 1);
+        benchmark::DoNotOptimize(u.getValues().data());
+    }
+
+    double iterations = 0.0;
+    for (const TimeStepStats& stats : stepper.getHistory()) iterations += stats.iterations;
+    state.counters["iterations_per_step"] = iterations / stepper.getHistory().size();
+    state.counters["setup_ms"] = stepper.getSetupMilliseconds();
+    state.counters["peak_rss_MB"] = peakRssMB();
+}
+BENCHMARK(BM_ImplicitHeatStep)
+    ->ArgsProduct({{256, 1024},
+                   {static_cast<int>(TimeScheme::BACKWARD_EULER), static_cast<int>(TimeScheme::CRANK_NICOLSON)},
+                   {static_cast<int>(PreconditionerType::JACOBI), static_cast<int>(PreconditionerType::IC0)}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+#include "GridFile.h"
+#include "GridField.h"
+#include "HeatStepper.h"
+#include "PolygonFile.h"
+#include "SnapshotWriter.h"
+#include "bench_common.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    std::string benchmarkPath(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    // Writes an n x n checkpoint with one field and returns its path
+    std::string writeCheckpoint(int n) {
+        Polygon polygon = makeNotchedPolygon();
+        const FDMGrid grid(n, n, polygon);
+        const GridField field(n, n, 1.0);
+        const GridFileField fields[] = {{"u", field.getValues()}};
+        const std::string path = benchmarkPath("pde_solver_bench_open.grid");
+        GridFile::write(path, grid, fields);
+        return path;
+    }
+
+    // Writes an n-vertex star outline in the given format and returns its path
+    std::string writeOutline(int n, PolygonFormat format) {
+        const std::vector<Point2D> vertices = starVertices(n, 0.9, 1.0);
+        const char* names[] = {"pde_solver_bench_outline.csv", "pde_solver_bench_outline.wkt", "pde_solver_bench_outline.bin"};
+        const std::string path = benchmarkPath(names[static_cast<int>(format)]);
+        if (format == PolygonFormat::BINARY) {
+            PolygonFile::writeBinary(path, vertices);
+            return path;
+        }
+        std::ofstream out(path);
+        out << (format == PolygonFormat::CSV ? "x,y\n" : "POLYGON ((");
+        char line[64];
+        for (int k = 0; k < n; k++) {
+            const char* pattern = format == PolygonFormat::CSV ? "%.9g,%.9g\n" : (k + 1 < n ? "%.9g %.9g, " : "%.9g %.9g))\n");
+            out.write(line, std::snprintf(line, sizeof(line), pattern, vertices[k].x, vertices[k].y));
+        }
+        return path;
+    }
+}
+
+// Checkpoint of an n x n grid and one field, written section by section
+static void BM_GridFileWrite(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    const FDMGrid grid(n, n, polygon);
+    const GridField field(n, n, 1.0);
+    const GridFileField fields[] = {{"u", field.getValues()}};
+    const std::string path = benchmarkPath("pde_solver_bench_write.grid");
+
+    for (auto _ : state) {
+        GridFile::write(path, grid, fields);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path)));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_GridFileWrite)->RangeMultiplier(4)->Range(256, 4096)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Opening a checkpoint maps it and checks the section table; no section is read
+static void BM_GridFileOpen(benchmark::State& state) {
+    const std::string path = writeCheckpoint(static_cast<int>(state.range(0)));
+
+    for (auto _ : state) {
+        GridFile file(path);
+        benchmark::DoNotOptimize(file.getCells().data());
+    }
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_GridFileOpen)->RangeMultiplier(4)->Range(256, 4096)->Unit(benchmark::kMicrosecond);
+
+// Opening a checkpoint and summing its field, touching every mapped page of it once
+static void BM_GridFileReadField(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const std::string path = writeCheckpoint(n);
+
+    for (auto _ : state) {
+        GridFile file(path);
+        double sum = 0.0;
+        for (double value : file.getField("u")) sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(n) * n * static_cast<int64_t>(sizeof(double)));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_GridFileReadField)->RangeMultiplier(4)->Range(256, 4096)->Unit(benchmark::kMillisecond);
+
+// Opening a checkpoint into an owning FDMGrid, one copy per array
+static void BM_GridFileLoadGrid(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const std::string path = writeCheckpoint(n);
+
+    for (auto _ : state) {
+        GridFile file(path);
+        FDMGrid grid(file);
+        benchmark::DoNotOptimize(grid.getCells().data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n) * n);
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_GridFileLoadGrid)->RangeMultiplier(4)->Range(256, 4096)->Unit(benchmark::kMillisecond);
+
+// Heat stepping with a snapshot every 2 steps, written in the background; the counters show
+// how much of the run the solver spent waiting for I/O with 1 to 3 buffers
+static void BM_SnapshotWriterHeat(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    const FDMGrid grid(n, n, polygon);
+    const HeatStepper stepper(grid, 1.0, 0.5 * HeatStepper::maxStableTimeStep(grid, 1.0));
+    const std::string directory = benchmarkPath("pde_solver_bench_snapshots");
+    std::filesystem::create_directory(directory);
+
+    SnapshotStats stats;
+    for (auto _ : state) {
+        GridField u(n, n, 1.0);
+        SnapshotWriter writer(grid, directory, "u", static_cast<int>(state.range(1)));
+        for (int s = 0; s < 8; s++) {
+            stepper.step(u, 2);
+            writer.submit(u, s * 2 * stepper.getTimeStep());
+        }
+        writer.close();
+        stats = writer.getStats();
+    }
+    state.counters["stalls"] = static_cast<double>(stats.stalls);
+    state.counters["stall_ms"] = stats.stallMilliseconds;
+    state.counters["copy_ms"] = stats.copyMilliseconds;
+    state.counters["write_ms"] = stats.writeMilliseconds;
+    state.counters["series_ms"] = stats.seriesMilliseconds;
+    state.counters["snapshot_MB"] = static_cast<double>(stats.bytesWritten) / stats.written / (1 << 20);
+    std::filesystem::remove_all(directory);
+}
+BENCHMARK(BM_SnapshotWriterHeat)->ArgsProduct({{512, 2048}, {1, 2, 3}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Parsing a mapped outline file of n vertices in each format (0 = CSV, 1 = WKT, 2 = BINARY)
+static void BM_PolygonFileReadVertices(benchmark::State& state) {
+    const auto format = static_cast<PolygonFormat>(state.range(0));
+    const std::string path = writeOutline(static_cast<int>(state.range(1)), format);
+
+    for (auto _ : state) {
+        std::vector<Point2D> vertices = PolygonFile::readVertices(path, format);
+        benchmark::DoNotOptimize(vertices.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(path)));
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_PolygonFileReadVertices)->ArgsProduct({{0, 1, 2}, {1 << 16, 1 << 20}})->Unit(benchmark::kMillisecond);
+
+// Loading a validated Polygon from a binary outline, dominated by the self-intersection sweep
+static void BM_PolygonFileRead(benchmark::State& state) {
+    const std::string path = writeOutline(static_cast<int>(state.range(0)), PolygonFormat::BINARY);
+
+    for (auto _ : state) {
+        Polygon polygon = PolygonFile::read(path, PolygonFormat::BINARY);
+        benchmark::DoNotOptimize(polygon.getVertices().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_PolygonFileRead)->RangeMultiplier(16)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond);
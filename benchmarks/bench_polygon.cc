@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+#include "Polygon.h"
+#include "bench_common.h"
+
+// Polygon construction (dominated by the self-intersection check) with the Shamos–Hoey sweep
+static void BM_PolygonValidateSweepLine(benchmark::State& state) {
+    const std::vector<Point2D> vertices = starVertices(static_cast<int>(state.range(0)), 0.5, 1.0, 0.2);
+
+    for (auto _ : state) {
+        Polygon polygon(vertices, ValidationMethod::SWEEP_LINE);
+        benchmark::DoNotOptimize(polygon.getMinX());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PolygonValidateSweepLine)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oNLogN);
+
+// The same polygons with the O(n^2) brute force reference
+static void BM_PolygonValidateBruteForce(benchmark::State& state) {
+    const std::vector<Point2D> vertices = starVertices(static_cast<int>(state.range(0)), 0.5, 1.0, 0.2);
+
+    for (auto _ : state) {
+        Polygon polygon(vertices, ValidationMethod::BRUTE_FORCE);
+        benchmark::DoNotOptimize(polygon.getMinX());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PolygonValidateBruteForce)->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMillisecond)->Complexity(benchmark::oNSquared);
+
+namespace {
+    // Query points uniformly covering the bounding box of the unit star
+    void makeQueryPoints(size_t count, std::vector<float>& xs, std::vector<float>& ys) {
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> coordinate(-1.2f, 1.2f);
+        xs.resize(count);
+        ys.resize(count);
+        for (size_t p = 0; p < count; p++) {
+            xs[p] = coordinate(rng);
+            ys[p] = coordinate(rng);
+        }
+    }
+}
+
+// One containsPoint call per query point, linear scan over all edges
+static void BM_PolygonContainsPoint(benchmark::State& state) {
+    Polygon polygon(starVertices(static_cast<int>(state.range(0)), 0.5, 1.0, 0.2));
+    polygon.setIndexMinEdges(SIZE_MAX);
+    std::vector<float> xs, ys;
+    makeQueryPoints(1 << 16, xs, ys);
+    std::vector<uint8_t> inside(xs.size());
+
+    for (auto _ : state) {
+        for (size_t p = 0; p < xs.size(); p++) {
+            inside[p] = polygon.containsPoint({xs[p], ys[p]});
+        }
+        benchmark::DoNotOptimize(inside.data());
+    }
+    state.SetItemsProcessed(state.iterations() * xs.size());
+}
+BENCHMARK(BM_PolygonContainsPoint)->RangeMultiplier(4)->Range(16, 4096)->Unit(benchmark::kMillisecond);
+
+// Batch query at each SIMD level, arg 1 is the SimdLevel
+static void BM_PolygonContainsPoints(benchmark::State& state) {
+    Polygon polygon(starVertices(static_cast<int>(state.range(0)), 0.5, 1.0, 0.2));
+    polygon.setIndexMinEdges(SIZE_MAX);
+    const SimdLevel level = static_cast<SimdLevel>(state.range(1));
+    if (resolveSimdLevel(level) != level) {
+        state.SkipWithError("SIMD level not supported on this CPU");
+        return;
+    }
+    std::vector<float> xs, ys;
+    makeQueryPoints(1 << 16, xs, ys);
+    std::vector<uint8_t> inside(xs.size());
+
+    for (auto _ : state) {
+        polygon.containsPoints(xs, ys, inside, level);
+        benchmark::DoNotOptimize(inside.data());
+    }
+    state.SetItemsProcessed(state.iterations() * xs.size());
+}
+BENCHMARK(BM_PolygonContainsPoints)->ArgsProduct({benchmark::CreateRange(16, 4096, 4), {0, 1, 2}})->Unit(benchmark::kMillisecond);
+
+// One containsPoint call per query point on a wavy circle, linear scan (arg 1 = 0) or slab index (arg 1 = 1).
+// Build cost and memory of the index are reported as counters
+static void BM_PolygonContainsPointIndexed(benchmark::State& state) {
+    Polygon polygon(starVertices(static_cast<int>(state.range(0)), 0.95, 1.0));
+    polygon.setIndexMinEdges(state.range(1) ? 0 : SIZE_MAX);
+    const PolygonIndexStats stats = polygon.usesIndex() ? polygon.getIndex().getStats() : PolygonIndexStats{};
+    std::vector<float> xs, ys;
+    makeQueryPoints(1 << 16, xs, ys);
+    std::vector<uint8_t> inside(xs.size());
+
+    for (auto _ : state) {
+        for (size_t p = 0; p < xs.size(); p++) {
+            inside[p] = polygon.containsPoint({xs[p], ys[p]});
+        }
+        benchmark::DoNotOptimize(inside.data());
+    }
+    state.SetItemsProcessed(state.iterations() * xs.size());
+    state.counters["build_ms"] = stats.buildMilliseconds;
+    state.counters["index_KB"] = stats.memoryBytes / 1024.0;
+}
+BENCHMARK(BM_PolygonContainsPointIndexed)->ArgsProduct({benchmark::CreateRange(16, 1 << 14, 4), {0, 1}})->Unit(benchmark::kMillisecond);
+
+// Index build cost and memory alone, from 10^2 to 10^6 edges
+static void BM_PolygonIndexBuild(benchmark::State& state) {
+    const std::vector<Point2D> vertices = starVertices(static_cast<int>(state.range(0)), 0.5, 1.0, 0.2);
+    size_t memory = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Polygon polygon(vertices);
+        state.ResumeTiming();
+        memory = polygon.getIndex().getStats().memoryBytes;
+    }
+    state.counters["index_KB"] = memory / 1024.0;
+    state.counters["bytes_per_edge"] = static_cast<double>(memory) / state.range(0);
+}
+BENCHMARK(BM_PolygonIndexBuild)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMillisecond);
+
+// Boundary queries on points near the outline, linear scan (arg 1 = 0) or grid index (arg 1 = 1)
+static void BM_PolygonIsOnBoundary(benchmark::State& state) {
+    const std::vector<Point2D> vertices = starVertices(static_cast<int>(state.range(0)), 0.5, 1.0, 0.2);
+    Polygon polygon(vertices);
+    polygon.setIndexMinEdges(state.range(1) ? 0 : SIZE_MAX);
+
+    std::vector<Point2D> queries;
+    for (size_t q = 0; q < 4096; q++) {
+        const Point2D& a = vertices[q % vertices.size()];
+        const Point2D& b = vertices[(q + 1) % vertices.size()];
+        queries.push_back(a + (b - a) * 0.37f);
+    }
+
+    for (auto _ : state) {
+        int hits = 0;
+        for (const Point2D& q : queries) {
+            hits += polygon.isOnBoundary(q, 1e-5f);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_PolygonIsOnBoundary)->ArgsProduct({benchmark::CreateRange(16, 1 << 14, 8), {0, 1}})->Unit(benchmark::kMillisecond);
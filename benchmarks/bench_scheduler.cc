@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include "Parallel.h"
+#include <cmath>
+
+namespace {
+    // Row work that grows along the range, like the scan lines of a polygon widening downwards
+    double rowWork(int row, int rows) {
+        const int length = 64 + 4096 * row / rows;
+        double sum = 0.0;
+        for (int k = 0; k < length; k++) sum += std::sqrt(static_cast<double>(k + row));
+        return sum;
+    }
+
+    constexpr int rows = 4096;
+}
+
+// Imbalanced rows on a work-stealing pool of range(0) workers, the caller taking part
+static void BM_ThreadPoolImbalanced(benchmark::State& state) {
+    ThreadPool pool({static_cast<unsigned>(state.range(0))});
+    const unsigned threads = pool.getWorkerCount() + 1;
+    std::vector<double> out(rows);
+    for (auto _ : state) {
+        pool.run(0, rows, 32, threads, [&](int first, int last) {
+            for (int j = first; j < last; j++) out[j] = rowWork(j, rows);
+        });
+        benchmark::DoNotOptimize(out.data());
+    }
+    const SchedulerStats stats = pool.getStats();
+    const double loops = static_cast<double>(state.iterations());
+    state.counters["steals_per_loop"] = static_cast<double>(stats.steals) / loops;
+    state.counters["idle_ms_per_loop"] = stats.idleMilliseconds / loops;
+}
+BENCHMARK(BM_ThreadPoolImbalanced)->Arg(1)->Arg(3)->Arg(7)->Unit(benchmark::kMillisecond);
+
+// The same rows split statically over freshly spawned threads, the scheme the pool replaced
+static void BM_SpawnPerLoopImbalanced(benchmark::State& state) {
+    const int threads = static_cast<int>(state.range(0)) + 1;
+    std::vector<double> out(rows);
+    for (auto _ : state) {
+        std::vector<std::thread> workers;
+        auto block = [&](int b) {
+            for (int j = rows * b / threads; j < rows * (b + 1) / threads; j++) out[j] = rowWork(j, rows);
+        };
+        for (int b = 1; b < threads; b++) workers.emplace_back(block, b);
+        block(0);
+        for (std::thread& worker : workers) worker.join();
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+BENCHMARK(BM_SpawnPerLoopImbalanced)->Arg(1)->Arg(3)->Arg(7)->Unit(benchmark::kMillisecond);
+
+// Cost of dispatching a loop of empty tiles, which bounds the smallest kernel worth parallelizing
+static void BM_ThreadPoolDispatch(benchmark::State& state) {
+    ThreadPool pool({static_cast<unsigned>(state.range(0))});
+    const unsigned threads = pool.getWorkerCount() + 1;
+    const int tiles = static_cast<int>(threads) * 4;
+    for (auto _ : state) {
+        pool.run(0, tiles, 1, threads, [](int first, int last) { benchmark::DoNotOptimize(first + last); });
+    }
+    state.counters["tasks_per_loop"] = static_cast<double>(pool.getStats().tasks) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_ThreadPoolDispatch)->Arg(1)->Arg(3)->Unit(benchmark::kMicrosecond);
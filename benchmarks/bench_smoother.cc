@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include "RedBlackSmoother.h"
+#include "PoissonOperator.h"
+#include "bench_common.h"
+
+namespace {
+    double source(const Point2D& p) {
+        return 1.0 + p.x * p.y;
+    }
+
+    // 10 flops per relaxed cell: 4 adds and 2 multiplies for the stencil, 1 multiply by the
+    // inverse diagonal, and a subtract, multiply and add for the over-relaxation
+    constexpr double flopsPerCell = 10.0;
+
+    // Modelled traffic per node and fused sweep: u is streamed in and out once, plus the source
+    // and the one-byte classification
+    constexpr double bytesPerNode = 2 * sizeof(double) + sizeof(double) + sizeof(GridType);
+
+    size_t countInterior(const FDMGrid& grid) {
+        std::span<const GridType> cells = grid.getCells();
+        return std::count(cells.begin(), cells.end(), INTERIOR);
+    }
+}
+
+// Matrix-free red-black SOR sweeps on an n x n grid at each SIMD level
+static void BM_RedBlackSweep(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    const SimdLevel level = static_cast<SimdLevel>(state.range(1));
+    FDMGrid grid(n, n, polygon);
+    RedBlackSmoother smoother(grid, RedBlackSmoother::optimalOmega(grid), level);
+
+    const GridField f = RedBlackSmoother::sample(grid, source);
+    GridField u(n, n);
+    for (auto _ : state) {
+        smoother.sweep(u, f);
+        benchmark::DoNotOptimize(u.getValues().data());
+        benchmark::ClobberMemory();
+    }
+
+    const double sweeps = static_cast<double>(state.iterations());
+    state.counters["GFLOP"] = benchmark::Counter(sweeps * flopsPerCell * countInterior(grid) * 1e-9, benchmark::Counter::kIsRate);
+    state.counters["GB"] = benchmark::Counter(sweeps * bytesPerNode * n * n * 1e-9, benchmark::Counter::kIsRate);
+    state.counters["level"] = static_cast<double>(smoother.getSimdLevel());
+    state.counters["peak_rss_MB"] = peakRssMB();
+}
+BENCHMARK(BM_RedBlackSweep)
+    ->ArgsProduct({{256, 1024, 4096},
+                   {static_cast<int>(SimdLevel::SCALAR), static_cast<int>(SimdLevel::AVX2), static_cast<int>(SimdLevel::AVX512)}})
+    ->Unit(benchmark::kMillisecond);
+
+// The same relaxation on the assembled operator (lexicographic Gauss-Seidel) for comparison
+static void BM_AssembledGaussSeidel(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    PoissonOperator op(grid);
+
+    const AlignedVector<double> b = op.assembleRhs(source, [](const Point2D&) { return 0.0; });
+    AlignedVector<double> x(b.size(), 0.0);
+    for (auto _ : state) {
+        op.gaussSeidel(b, x);
+        benchmark::DoNotOptimize(x.data());
+        benchmark::ClobberMemory();
+    }
+
+    const double sweeps = static_cast<double>(state.iterations());
+    state.counters["GFLOP"] = benchmark::Counter(sweeps * flopsPerCell * op.getUnknownCount() * 1e-9, benchmark::Counter::kIsRate);
+    state.counters["peak_rss_MB"] = peakRssMB();
+}
+BENCHMARK(BM_AssembledGaussSeidel)->Arg(256)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
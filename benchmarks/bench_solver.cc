@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+#include "MultigridSolver.h"
+#include "PcgSolver.h"
+#include "bench_common.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    double source(const Point2D& p) {
+        return 1.0 + p.x * p.y;
+    }
+
+    double zero(const Point2D&) {
+        return 0.0;
+    }
+}
+
+// Unpreconditioned conjugate gradients on an n x n grid; iterations grow like n
+static void BM_PoissonSolveCG(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    PoissonSolver solver(grid);
+
+    int iterations = 0;
+    for (auto _ : state) {
+        SolveResult result = solver.solve(source, zero, {1e-8, 100000});
+        iterations = result.iterations;
+        benchmark::DoNotOptimize(result.field.getValues().data());
+    }
+    state.SetItemsProcessed(state.iterations() * solver.getOperator().getUnknownCount());
+    state.counters["iterations"] = iterations;
+}
+BENCHMARK(BM_PoissonSolveCG)->Arg(65)->Arg(129)->Arg(257)->Arg(513)->Unit(benchmark::kMillisecond);
+
+// Multigrid solve on an n x n grid (hierarchy built once); the time per unknown should stay flat
+static void BM_MultigridSolve(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    MultigridOptions options;
+    options.cycle = static_cast<MultigridCycle>(state.range(1));
+    MultigridSolver solver(n, n, polygon, options);
+
+    int iterations = 0;
+    for (auto _ : state) {
+        SolveResult result = solver.solve(source, zero, {1e-8, 100});
+        iterations = result.iterations;
+        benchmark::DoNotOptimize(result.field.getValues().data());
+    }
+    state.SetItemsProcessed(state.iterations() * solver.getOperator().getUnknownCount());
+    state.counters["iterations"] = iterations;
+    state.counters["levels"] = solver.getLevelCount();
+    state.counters["peak_rss_MB"] = peakRssMB();
+}
+BENCHMARK(BM_MultigridSolve)
+    ->ArgsProduct({{65, 129, 257, 513, 1025, 2049},
+                   {static_cast<int>(MultigridCycle::V), static_cast<int>(MultigridCycle::W), static_cast<int>(MultigridCycle::F)}})
+    ->Unit(benchmark::kMillisecond);
+
+// Building the hierarchy: classification and operator assembly on every level
+static void BM_MultigridSetup(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+
+    for (auto _ : state) {
+        MultigridSolver solver(n, n, polygon);
+        benchmark::DoNotOptimize(solver.getLevelCount());
+    }
+    state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(BM_MultigridSetup)->Arg(65)->Arg(129)->Arg(257)->Arg(513)->Arg(1025)->Arg(2049)->Unit(benchmark::kMillisecond);
+
+// Preconditioned conjugate gradients on an n x n grid for each preconditioner; setup is reported separately
+static void BM_PcgSolve(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    PcgSolver solver(n, n, polygon, static_cast<PreconditionerType>(state.range(1)));
+
+    PcgResult result;
+    for (auto _ : state) {
+        result = solver.solve(source, zero, {1e-8, 100000});
+        benchmark::DoNotOptimize(result.field.getValues().data());
+    }
+    state.SetItemsProcessed(state.iterations() * solver.getOperator().getUnknownCount());
+    state.counters["iterations"] = result.iterations;
+    state.counters["ms_per_iteration"] = result.solveMilliseconds / std::max(1, result.iterations);
+    state.counters["setup_ms"] = solver.getSetupMilliseconds();
+    state.counters["peak_rss_MB"] = peakRssMB();
+}
+BENCHMARK(BM_PcgSolve)
+    ->ArgsProduct({{129, 257, 513, 1025},
+                   {static_cast<int>(PreconditionerType::NONE), static_cast<int>(PreconditionerType::JACOBI),
+                    static_cast<int>(PreconditionerType::IC0), static_cast<int>(PreconditionerType::MULTIGRID)}})
+    ->Unit(benchmark::kMillisecond);
+
+// Multigrid solve with snapped or Shortley-Weller boundaries on a triangle whose exact solution
+// u = L1 L2 L3 vanishes on its edges; compare max_error against time across resolutions
+static void BM_BoundaryStencilAccuracy(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    const std::vector<Point2D> vertices = { {.1f, .15f}, {1.1f, .3f}, {.35f, 1.05f} };
+    // Edge lines a x + b y + c with unit normals pointing inwards
+    struct Line { double a, b, c; };
+    Line lines[3];
+    for (int e = 0; e < 3; e++) {
+        const Point2D& p = vertices[e];
+        const Point2D& q = vertices[(e + 1) % 3];
+        const double ex = q.x - p.x, ey = q.y - p.y, length = std::hypot(ex, ey);
+        lines[e] = {-ey / length, ex / length, (ey * p.x - ex * p.y) / length};
+    }
+    auto line = [&](int e, const Point2D& p) { return lines[e].a * p.x + lines[e].b * p.y + lines[e].c; };
+    auto gradient = [&](int e, int f) { return lines[e].a * lines[f].a + lines[e].b * lines[f].b; };
+    auto exact = [&](const Point2D& p) { return line(0, p) * line(1, p) * line(2, p); };
+    auto triangleSource = [&](const Point2D& p) {
+        return -2.0 * (gradient(0, 1) * line(2, p) + gradient(0, 2) * line(1, p) + gradient(1, 2) * line(0, p));
+    };
+
+    Polygon polygon(vertices);
+    MultigridOptions options;
+    options.stencil = static_cast<BoundaryStencil>(state.range(1));
+    MultigridSolver solver(n, n, polygon, options);
+
+    SolveResult result;
+    for (auto _ : state) {
+        result = solver.solve(triangleSource, zero, {1e-10, 100});
+        benchmark::DoNotOptimize(result.field.getValues().data());
+    }
+
+    const FDMGrid& grid = solver.getGrid();
+    double error = 0.0;
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (grid.getCellType(i, j) == INTERIOR) {
+                error = std::max(error, std::abs(result.field(i, j) - exact(grid.indexToPoint(i, j))));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * solver.getOperator().getUnknownCount());
+    state.counters["iterations"] = result.iterations;
+    state.counters["max_error"] = error;
+}
+BENCHMARK(BM_BoundaryStencilAccuracy)
+    ->ArgsProduct({{65, 129, 257, 513, 1025},
+                   {static_cast<int>(BoundaryStencil::SNAPPED), static_cast<int>(BoundaryStencil::SHORTLEY_WELLER)}})
+    ->Unit(benchmark::kMillisecond);
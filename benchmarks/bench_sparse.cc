@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "SparseMatrix.h"
+#include "bench_common.h"
+
+namespace {
+    // Minimum traffic of y = A x: every stored entry (value and column) once, x read and y written once
+    double spmvBytes(int64_t stored, int64_t rowPointers, int32_t rows) {
+        return static_cast<double>(stored) * (sizeof(double) + sizeof(int32_t))
+            + static_cast<double>(rowPointers) * sizeof(int64_t) + 2.0 * rows * sizeof(double);
+    }
+
+    void reportSpmv(benchmark::State& state, int64_t nonzeros, double bytes) {
+        const double products = static_cast<double>(state.iterations());
+        state.counters["GFLOP"] = benchmark::Counter(products * 2.0 * nonzeros * 1e-9, benchmark::Counter::kIsRate);
+        state.counters["GB"] = benchmark::Counter(products * bytes * 1e-9, benchmark::Counter::kIsRate);
+        state.counters["peak_rss_MB"] = peakRssMB();
+    }
+}
+
+// Matrix-free SoA stencil product, the baseline both formats are measured against
+static void BM_StencilApply(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    PoissonOperator op(grid);
+
+    AlignedVector<double> x(op.getUnknownCount(), 1.0), y(op.getUnknownCount());
+    for (auto _ : state) {
+        op.apply(x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    const int64_t unknowns = op.getUnknownCount();
+    reportSpmv(state, 5 * unknowns, static_cast<double>(unknowns) * (5 * sizeof(double) + 4 * sizeof(int32_t) + 2 * sizeof(double)));
+}
+BENCHMARK(BM_StencilApply)->Arg(512)->Arg(2048)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// CSR product with a given thread count (0 = all cores)
+static void BM_CsrSpMV(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    CsrMatrix csr{PoissonOperator(grid)};
+    csr.setNumThreads(static_cast<unsigned>(state.range(1)));
+
+    AlignedVector<double> x(csr.getRowCount(), 1.0), y(csr.getRowCount());
+    for (auto _ : state) {
+        csr.multiply(x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    reportSpmv(state, csr.getNonzeroCount(), spmvBytes(csr.getNonzeroCount(), csr.getRowCount() + 1, csr.getRowCount()));
+}
+BENCHMARK(BM_CsrSpMV)->ArgsProduct({{512, 2048, 4096}, {1, 0}})->Unit(benchmark::kMillisecond);
+
+// SELL-C-σ product at each SIMD level, C = 8 and σ = 256
+static void BM_SellSpMV(benchmark::State& state) {
+    Polygon polygon = makeNotchedPolygon();
+    const int n = static_cast<int>(state.range(0));
+    FDMGrid grid(n, n, polygon);
+    CsrMatrix csr{PoissonOperator(grid)};
+    csr.setNumThreads(static_cast<unsigned>(state.range(2)));
+    SellMatrix sell(csr, 8, 256, static_cast<SimdLevel>(state.range(1)));
+
+    AlignedVector<double> x(sell.getRowCount(), 1.0), y(sell.getRowCount());
+    for (auto _ : state) {
+        sell.multiply(x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    reportSpmv(state, sell.getNonzeroCount(), spmvBytes(sell.getStoredCount(), sell.getChunkCount() + 1, sell.getRowCount()));
+    state.counters["padding"] = sell.getPaddingRatio();
+    state.counters["level"] = static_cast<double>(sell.getSimdLevel());
+}
+BENCHMARK(BM_SellSpMV)
+    ->ArgsProduct({{512, 2048, 4096},
+                   {static_cast<int>(SimdLevel::SCALAR), static_cast<int>(SimdLevel::AVX2), static_cast<int>(SimdLevel::AVX512)},
+                   {1, 0}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Minimal standard-conforming allocator returning storage aligned to a fixed boundary.
+ *
+ * Used for the contiguous grid and field buffers so that every row-major buffer starts
+ * on a cache line (and SIMD register) boundary.
+ *
+ * @tparam T The element type.
+ * @tparam Alignment The requested alignment in bytes (default = 64, one cache line).
+ */
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    static_assert(Alignment >= alignof(T), "Alignment must not be smaller than alignof(T)");
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/// @brief A std::vector whose data() is aligned to a cache line.
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
@@ -0,0 +1,140 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <span>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief Message passing between the ranks of a distributed solve.
+ *
+ * The interface is the subset of MPI the halo exchange and the distributed Krylov solvers
+ * need: a paired send/receive, which cannot deadlock when every rank sends before it
+ * receives, and a sum reduction. Rank -1 stands for "no partner" (MPI_PROC_NULL).
+ */
+class Communicator {
+public:
+    virtual ~Communicator() = default;
+
+    /**
+     * @brief Gets the rank of the calling process or thread.
+     * @return The rank in [0, getSize()).
+     */
+    virtual int getRank() const = 0;
+
+    /**
+     * @brief Gets the number of ranks.
+     * @return The number of ranks.
+     */
+    virtual int getSize() const = 0;
+
+    /**
+     * @brief Sends one buffer and receives another, like MPI_Sendrecv.
+     * @param dest Rank to send to, or -1 to send nothing.
+     * @param sendData The values to send.
+     * @param source Rank to receive from, or -1 to receive nothing.
+     * @param receiveData Output for the received values; its size must match the message.
+     * @param tag Message tag; a receive only matches a send with the same tag.
+     * @throws std::runtime_error If the received message has a different size.
+     */
+    virtual void sendReceive(int dest, std::span<const double> sendData, int source, std::span<double> receiveData, int tag) = 0;
+
+    /**
+     * @brief Sums a value over all ranks.
+     * @param value This rank's contribution.
+     * @return The sum, the same on every rank.
+     */
+    virtual double allreduceSum(double value) = 0;
+
+    /**
+     * @brief Waits until every rank has reached the barrier.
+     */
+    virtual void barrier() = 0;
+};
+
+class SharedMemoryCommunicator;
+
+/**
+ * @brief In-process backend: a fixed number of ranks run as threads and exchange messages
+ * through shared mailboxes.
+ *
+ * Sends copy their data into the mailbox of (source, destination, tag) and return at once;
+ * receives block until a message is there. Reductions add the contributions in rank order, so
+ * their results are reproducible. If one rank throws, every blocked rank is released with an
+ * exception and run() rethrows the first one.
+ */
+class SharedMemoryWorld {
+private:
+/*====================================  Attributes  =========================================*/
+
+    friend class SharedMemoryCommunicator;
+    using MailboxKey = std::tuple<int, int, int>;
+
+    int size;                                                       /// @brief Number of ranks
+    std::mutex mutex;                                               /// @brief Guards every member below
+    std::condition_variable ready;                                  /// @brief Signals new messages, completed reductions and aborts
+    std::map<MailboxKey, std::deque<std::vector<double>>> mailboxes; /// @brief Pending messages per (source, destination, tag)
+    std::vector<double> contributions;                              /// @brief Values of the reduction in progress, by rank
+    int arrived = 0;                                                /// @brief Ranks that reached the reduction in progress
+    uint64_t generation = 0;                                        /// @brief Number of completed reductions
+    double reduced = 0;                                             /// @brief Result of the last completed reduction
+    bool aborted = false;                                           /// @brief Set when a rank threw
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Creates a world of ranks.
+     * @param size_ Number of ranks.
+     * @throws std::invalid_argument If size_ < 1.
+     */
+    explicit SharedMemoryWorld(int size_);
+
+/*==================================== Getters =========================================*/
+
+    int getSize() const { return size; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Runs body on every rank, one thread each, and waits for all of them.
+     * @param body Callable invoked with the communicator of its rank.
+     * @throws Rethrows the first exception thrown by a rank.
+     */
+    void run(const std::function<void(Communicator&)>& body);
+
+private:
+    /**
+     * @brief Releases every blocked rank after a failure.
+     */
+    void abort();
+};
+
+/**
+ * @brief Communicator of one rank of a SharedMemoryWorld.
+ */
+class SharedMemoryCommunicator : public Communicator {
+private:
+/*====================================  Attributes  =========================================*/
+
+    SharedMemoryWorld& world;  /// @brief The shared mailboxes and reduction state
+    int rank;                  /// @brief This rank
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    SharedMemoryCommunicator(SharedMemoryWorld& world_, int rank_) : world(world_), rank(rank_) {}
+
+/*====================================  Methods  =========================================*/
+
+    int getRank() const override { return rank; }
+    int getSize() const override { return world.size; }
+    void sendReceive(int dest, std::span<const double> sendData, int source, std::span<double> receiveData, int tag) override;
+    double allreduceSum(double value) override;
+    void barrier() override;
+};
@@ -0,0 +1,100 @@
+#pragma once
+#include "Communicator.h"
+#include "DomainDecomposition.h"
+#include "FDMGrid.h"
+#include "PoissonOperator.h"
+#include "PoissonSolver.h"
+#include <vector>
+
+/**
+ * @brief Conjugate gradients for -∇²u = f with u = g on the boundary, distributed over the
+ * subdomains of a DomainDecomposition.
+ *
+ * Every rank keeps vectors only over its own block plus a one-node ghost layer. A product with
+ * the 5-point operator first exchanges the ghost layer of the input, then applies the stencil
+ * to the rank's INTERIOR nodes; dot products are summed locally and reduced over all ranks. The
+ * discretization is that of PoissonOperator with the same BoundaryStencil, so the solution
+ * matches PoissonSolver up to the rounding of the reductions.
+ *
+ * No rank holds anything of the global size. Each classifies only a window of the grid: its
+ * block, the ghost layer and the FDMGrid::armReach nodes beyond, over which the arms of its
+ * cut cells are measured, so every rank sees the types and arms of the full grid. solve()
+ * leaves the solution distributed; gather() assembles it on one rank when asked to.
+ *
+ * @note The solver keeps a reference to the communicator, which must outlive it.
+ */
+class DistributedPoissonSolver {
+private:
+/*====================================  Attributes  =========================================*/
+
+    DomainDecomposition decomposition;       /// @brief Blocks of every rank, used to gather
+    Communicator& comm;                      /// @brief Transport of the halo exchanges and reductions
+    HaloExchange halo;                       /// @brief Ghost-layer exchange of this rank's block
+    FDMGrid grid;                            /// @brief Window of the classified grid around this rank's block
+    int iBlock, jBlock;                      /// @brief Indices in grid of the block's first node
+    double cx, cy;                           /// @brief Weights 1 / dx² and 1 / dy² between unknowns
+    AlignedVector<size_t> cells;             /// @brief Local offsets of the rank's INTERIOR nodes
+    AlignedVector<double> diag;              /// @brief Diagonal weight of each local unknown
+    std::vector<BoundaryCoupling> couplings; /// @brief Dirichlet terms, unknown numbered by cells
+    int64_t globalUnknowns = 0;              /// @brief Unknowns over all ranks
+    AlignedVector<double> solution;          /// @brief Local field of the last solve
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Classifies this rank's window of the grid and assembles its part of the operator.
+     * Collective: every rank of the communicator must construct its solver.
+     * @param polygon The polygon of the domain; the grid spans its bounding box as in FDMGrid.
+     * @param decomposition_ Split of the grid, whose size it gives; one subdomain per rank of comm_.
+     * @param comm_ The communicator.
+     * @param stencil Treatment of the boundary (default = SNAPPED).
+     * @param numThreads Threads used to classify the window (default = 0, all cores).
+     * @throws std::invalid_argument If the decomposition does not match the communicator.
+     */
+    DistributedPoissonSolver(Polygon& polygon, const DomainDecomposition& decomposition_, Communicator& comm_,
+        BoundaryStencil stencil = BoundaryStencil::SNAPPED, unsigned numThreads = 0);
+
+/*==================================== Getters =========================================*/
+
+    const Subdomain& getSubdomain() const { return halo.getSubdomain(); }
+    const FDMGrid& getGrid() const { return grid; }
+    const HaloStats& getHaloStats() const { return halo.getStats(); }
+    size_t getLocalUnknownCount() const { return cells.size(); }
+    int64_t getGlobalUnknownCount() const { return globalUnknowns; }
+
+    /**
+     * @brief Gets the local field of the last solve.
+     * @return Values over the block and its ghost layer, laid out as described by HaloExchange.
+     */
+    std::span<const double> getLocalSolution() const { return solution; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Computes y = A x on this rank's unknowns. Collective.
+     * @param x Local field with zeros at every node that is not an unknown; its ghost layer is overwritten.
+     * @param y Local output field; only the unknowns are written.
+     * @return The global dot product x·Ax.
+     */
+    double applyDot(std::span<double> x, std::span<double> y);
+
+    /**
+     * @brief Solves -∇²u = f with u = g on the boundary from a zero initial guess. Collective.
+     * The solution stays distributed: each rank's part is getLocalSolution(), and gather()
+     * assembles the global field where one is needed.
+     * @param source The source term f.
+     * @param boundaryValue The Dirichlet data g.
+     * @param options Stopping criteria.
+     * @return Convergence information on every rank, with an empty field.
+     */
+    SolveResult solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& options = {});
+
+    /**
+     * @brief Assembles the owned blocks of a distributed local field into a global field. Collective.
+     * @param local This rank's local field.
+     * @param root Rank that receives the field.
+     * @return The global field on root, an empty field on every other rank.
+     */
+    GridField gather(std::span<const double> local, int root = 0);
+};
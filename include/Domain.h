@@ -0,0 +1,91 @@
+#pragma once
+#include "Polygon.h"
+#include <span>
+#include <vector>
+
+/**
+ * @brief Region bounded by an outer polygon with any number of polygonal holes cut out of it.
+ *
+ * All rings are validated together: one sweep over every edge checks that each ring is simple
+ * and that no two rings cross or touch. Each hole must lie inside the outer polygon, and no hole
+ * may lie inside another. A point is in the domain when it is inside an odd number of rings
+ * (even-odd rule); for rings validated this way that is the same as the nonzero winding rule
+ * with holes wound opposite to the outer ring, so the orientation of each ring does not matter.
+ */
+class Domain {
+private:
+/*====================================  Attributes  =========================================*/
+
+    Polygon outer;              /// @brief The outer boundary
+    std::vector<Polygon> holes; /// @brief The holes, each inside outer and outside every other hole
+
+public:
+/*====================================  Constructors  =========================================*/
+
+    /**
+     * @brief Constructs a domain from the vertices of its rings.
+     * @param outer_ The vertices of the outer boundary (in order).
+     * @param holes_ The vertices of each hole (in order).
+     * @param method The intersection check run over all rings together (default = SWEEP_LINE).
+     * @throws std::invalid_argument if a ring has fewer than 3 vertices, two edges intersect,
+     *         a hole is not inside the outer boundary, or a hole is inside another hole.
+     */
+    Domain(const std::vector<Point2D>& outer_, const std::vector<std::vector<Point2D>>& holes_ = {},
+        ValidationMethod method = ValidationMethod::SWEEP_LINE);
+
+    /**
+     * @brief Constructs a domain without holes from an already validated polygon.
+     * @param outer_ The outer boundary.
+     */
+    explicit Domain(const Polygon& outer_);
+
+/*==================================  Getters  =========================================*/
+
+    const Polygon& getOuter() const { return outer; }
+    const std::vector<Polygon>& getHoles() const { return holes; }
+    float getMinX() const { return outer.getMinX(); }
+    float getMinY() const { return outer.getMinY(); }
+    float getMaxX() const { return outer.getMaxX(); }
+    float getMaxY() const { return outer.getMaxY(); }
+
+    /**
+     * @brief Gets the vertices of every ring, the outer boundary first.
+     * @return One span per ring, valid while the domain lives.
+     */
+    std::vector<std::span<const Point2D>> getRings() const;
+
+    /**
+     * @brief Gets the number of edges over all rings.
+     * @return The total edge count.
+     */
+    size_t getEdgeCount() const;
+
+/*================================== Other Methods  =========================================*/
+
+    /**
+     * @brief Checks if a point is inside the domain: inside the outer polygon and outside every hole.
+     * Holes whose bounding box does not contain the point are skipped.
+     * @param point The point to check.
+     * @return True if the point is inside the domain, false otherwise.
+     */
+    bool containsPoint(const Point2D& point) const;
+
+    /**
+     * @brief Checks if a point is on the boundary of any ring.
+     * @param point The point to check.
+     * @param epsilon The tolerance for floating-point comparison (default = 1e-10).
+     * @return True if the point is on the outer boundary or on the boundary of a hole.
+     */
+    bool isOnBoundary(const Point2D& point, float epsilon = 1e-10f) const;
+
+private:
+/*==================================  Helper Methods  =========================================*/
+
+    /**
+     * @brief Runs the intersection check over all rings before any polygon is built.
+     * @return outer_, so the check can run in the member initializer list.
+     * @throws std::invalid_argument if a ring is too short or two edges intersect.
+     */
+    static const std::vector<Point2D>& validate(const std::vector<Point2D>& outer_,
+        const std::vector<std::vector<Point2D>>& holes_, ValidationMethod method);
+};
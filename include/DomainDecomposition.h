@@ -0,0 +1,140 @@
+#pragma once
+#include "AlignedAllocator.h"
+#include "Communicator.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Rectangular block of grid nodes owned by one rank.
+ * Nodes iBegin <= i < iEnd, jBegin <= j < jEnd belong to the rank; the neighbours are the
+ * ranks owning the adjacent blocks, or -1 at the edge of the grid.
+ */
+struct Subdomain {
+    int rank = 0;                                    /// @brief Owning rank
+    int iBegin = 0, iEnd = 0;                        /// @brief Owned node columns [iBegin, iEnd)
+    int jBegin = 0, jEnd = 0;                        /// @brief Owned node rows [jBegin, jEnd)
+    int west = -1, east = -1, south = -1, north = -1; /// @brief Ranks of the adjacent blocks
+
+    int getWidth() const { return iEnd - iBegin; }
+    int getHeight() const { return jEnd - jBegin; }
+};
+
+/**
+ * @brief Split of an nx x ny node grid into px x py rectangular subdomains, one per rank.
+ * Rank r owns block (r % px, r / px); block sizes differ by at most one node in each direction.
+ */
+class DomainDecomposition {
+private:
+/*====================================  Attributes  =========================================*/
+
+    int nx, ny;                        /// @brief Size of the global grid
+    int px, py;                        /// @brief Number of blocks in each direction
+    std::vector<Subdomain> subdomains; /// @brief Block of every rank
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Splits a grid into a given arrangement of blocks.
+     * @param nx_ Number of grid nodes in x-direction.
+     * @param ny_ Number of grid nodes in y-direction.
+     * @param px_ Number of blocks in x-direction.
+     * @param py_ Number of blocks in y-direction.
+     * @throws std::invalid_argument If a block count is below 1 or exceeds the node count.
+     */
+    DomainDecomposition(int nx_, int ny_, int px_, int py_);
+
+    /**
+     * @brief Splits a grid into ranks blocks, choosing the arrangement with the shortest total cut.
+     * @param nx_ Number of grid nodes in x-direction.
+     * @param ny_ Number of grid nodes in y-direction.
+     * @param ranks Number of ranks.
+     * @throws std::invalid_argument If no arrangement fits the grid.
+     */
+    DomainDecomposition(int nx_, int ny_, int ranks);
+
+/*==================================== Getters =========================================*/
+
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    int getPx() const { return px; }
+    int getPy() const { return py; }
+    int getRankCount() const { return px * py; }
+    const Subdomain& getSubdomain(int rank) const { return subdomains[rank]; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Finds the rank owning a node.
+     * @param i The x index of the node.
+     * @param j The y index of the node.
+     * @return The owning rank.
+     */
+    int ownerOf(int i, int j) const;
+};
+
+/**
+ * @brief Cumulative cost of a rank's halo exchanges.
+ */
+struct HaloStats {
+    int64_t exchanges = 0;       /// @brief Calls to exchange
+    int64_t messages = 0;        /// @brief Messages sent
+    int64_t valuesSent = 0;      /// @brief Values sent over all messages
+    double milliseconds = 0;     /// @brief Wall time spent packing, communicating and unpacking
+};
+
+/**
+ * @brief Fills the ghost layer of a rank's local field from its neighbours.
+ *
+ * A local field stores the owned block with a one-node ghost layer around it, row-major with
+ * (width + 2) values per row: local node (li, lj), -1 <= li <= width, -1 <= lj <= height,
+ * lives at (lj + 1) * (width + 2) + li + 1. The ghost layer holds the neighbours' edge nodes,
+ * which is what a 5-point stencil reads; corners are not exchanged. Columns are packed into
+ * a buffer, rows are sent in place. Ghost nodes on the edge of the global grid are never written.
+ */
+class HaloExchange {
+private:
+/*====================================  Attributes  =========================================*/
+
+    Subdomain subdomain;              /// @brief The rank's block and neighbours
+    Communicator& comm;               /// @brief Transport of the messages
+    AlignedVector<double> sendColumn; /// @brief Packed outgoing column
+    AlignedVector<double> recvColumn; /// @brief Incoming column before unpacking
+    HaloStats stats;                  /// @brief Cumulative cost
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Prepares the exchange of one rank.
+     * @param subdomain_ The rank's block.
+     * @param comm_ The communicator; its rank must be subdomain_.rank.
+     * @throws std::invalid_argument If the ranks differ.
+     */
+    HaloExchange(const Subdomain& subdomain_, Communicator& comm_);
+
+/*==================================== Getters =========================================*/
+
+    const Subdomain& getSubdomain() const { return subdomain; }
+    const HaloStats& getStats() const { return stats; }
+    size_t getLocalSize() const { return static_cast<size_t>(subdomain.getWidth() + 2) * (subdomain.getHeight() + 2); }
+    int getStride() const { return subdomain.getWidth() + 2; }
+
+    /**
+     * @brief Gets the offset of a local node in the local field.
+     * @param li Local x index, -1 to width.
+     * @param lj Local y index, -1 to height.
+     * @return The offset.
+     */
+    size_t localIndex(int li, int lj) const { return static_cast<size_t>(lj + 1) * getStride() + li + 1; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Exchanges the edge nodes of the owned block with the neighbours.
+     * Every rank of the decomposition must call this collectively.
+     * @param local The local field, getLocalSize() values.
+     */
+    void exchange(std::span<double> local);
+};
@@ -1,8 +1,17 @@
 #pragma once
 #include "Polygon.h"
+#include "Domain.h"
+#include "AlignedAllocator.h"
 #include <vector>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+
+class GridFile;
 
 /**
  * @brief enum class representing the type of grid cell.
@@ -18,9 +27,154 @@ enum GridType: int8_t {
     EXTERIOR = 2
 };
 
+/**
+ * @brief Distances from an INTERIOR node to the polygon along the four grid directions.
+ * Each arm is measured in units of the grid spacing in its direction. An arm is below 1 when
+ * the polygon crosses the grid line before the neighbouring node, and exceeds 1 when the
+ * neighbour is a BOUNDARY node that still lies inside the polygon (next to steep edges the
+ * crossing can be several nodes away). Arms that do not reach the polygon (the neighbour is
+ * INTERIOR) are 1.
+ */
+struct BoundaryArms {
+    float west = 1.0f;   /// @brief Arm towards -x, in units of dx
+    float east = 1.0f;   /// @brief Arm towards +x, in units of dx
+    float south = 1.0f;  /// @brief Arm towards -y, in units of dy
+    float north = 1.0f;  /// @brief Arm towards +y, in units of dy
+
+    bool operator==(const BoundaryArms& other) const = default;
+};
+
+/**
+ * @brief Grid indices of one cell.
+ */
+struct CellIndex {
+    int i;  /// @brief The x index
+    int j;  /// @brief The y index
+};
+
+/**
+ * @brief Half-open rectangle of cells [iBegin, iEnd) x [jBegin, jEnd).
+ */
+struct CellBox {
+    int iBegin = 0, iEnd = 0;  /// @brief Range of x indices
+    int jBegin = 0, jEnd = 0;  /// @brief Range of y indices
+};
+
+/**
+ * @brief A cell whose type changed in FDMGrid::moveVertices.
+ */
+struct CellChange {
+    size_t cell;        /// @brief Row-major offset of the cell
+    GridType previous;  /// @brief Type before the move
+    GridType current;   /// @brief Type after the move
+};
+
+/**
+ * @brief What FDMGrid::moveVertices changed, so solver state can be patched instead of rebuilt.
+ */
+struct GridUpdate {
+    std::vector<CellBox> classified;       /// @brief Disjoint tiles of re-classified cells
+    std::vector<CellBox> measured;         /// @brief Disjoint boxes of cells whose boundary arms were re-measured
+    std::vector<CellChange> changedCells;  /// @brief Cells whose type changed, in row-major order
+    std::vector<size_t> changedArms;       /// @brief Sorted offsets of the cut cells whose arms appeared, vanished or changed
+};
+
+/**
+ * @brief Forward iterator over the cells of one type in a row-major classification buffer.
+ * Cells of other types are skipped on increment; (i, j) are tracked incrementally, so no
+ * division is needed to yield an index.
+ */
+class CellTypeIterator {
+private:
+    const GridType* cells = nullptr;  /// @brief The classification buffer
+    size_t offset = 0;                /// @brief Offset of the current cell
+    size_t size = 0;                  /// @brief Number of cells in the buffer
+    int nx = 1;                       /// @brief Row length
+    int i = 0, j = 0;                 /// @brief Indices of the current cell
+    GridType type = INTERIOR;         /// @brief The type to visit
+
+    /// @brief Moves forward to the first cell of the type at or after the current one
+    void settle() {
+        // Runs of other cells are skipped with memchr, one row segment at a time
+        while (offset < size && cells[offset] != type) {
+            const size_t rowEnd = offset - i + nx;
+            const void* hit = std::memchr(cells + offset, static_cast<uint8_t>(type), rowEnd - offset);
+            if (hit != nullptr) {
+                const size_t found = static_cast<size_t>(static_cast<const GridType*>(hit) - cells);
+                i += static_cast<int>(found - offset);
+                offset = found;
+                return;
+            }
+            offset = rowEnd;
+            i = 0;
+            j++;
+        }
+    }
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = CellIndex;
+    using difference_type = std::ptrdiff_t;
+
+    CellTypeIterator() = default;
+    CellTypeIterator(std::span<const GridType> cells_, int nx_, GridType type_)
+        : cells(cells_.data()), size(cells_.size()), nx(nx_), type(type_) { settle(); }
+
+    CellIndex operator*() const { return {i, j}; }
+
+    CellTypeIterator& operator++() {
+        offset++;
+        if (++i == nx) {
+            i = 0;
+            j++;
+        }
+        settle();
+        return *this;
+    }
+
+    CellTypeIterator operator++(int) {
+        CellTypeIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    bool operator==(const CellTypeIterator& other) const { return offset == other.offset; }
+    bool operator==(std::default_sentinel_t) const { return offset == size; }
+};
+
+/**
+ * @brief Lazy view of the indices of all cells of one type, in row-major order.
+ */
+class CellTypeView : public std::ranges::view_interface<CellTypeView> {
+private:
+    std::span<const GridType> cells;  /// @brief The classification buffer
+    int nx = 1;                       /// @brief Row length
+    GridType type = INTERIOR;         /// @brief The type to visit
+
+public:
+    CellTypeView() = default;
+    CellTypeView(std::span<const GridType> cells_, int nx_, GridType type_) : cells(cells_), nx(nx_), type(type_) {}
+
+    CellTypeIterator begin() const { return CellTypeIterator(cells, nx, type); }
+    std::default_sentinel_t end() const { return {}; }
+};
+
 /**
  * @brief Class representing a 2D grid for Finite Difference Method (FDM) discretization.
- * The grid is used to classify cells as interior, exterior, or boundary based on a polygon.
+ * The grid is used to classify cells as interior, exterior, or boundary based on a polygon,
+ * or on a Domain whose holes are classified like the outside of the polygon.
+ *
+ * Cell classifications are stored in a single contiguous, cache-line aligned buffer in
+ * row-major order: cell (i, j) lives at offset j * nx + i, so each scan line j is a
+ * contiguous run of nx cells and i is the fastest-varying index.
+ *
+ * Next to the classification the grid keeps the exact distances from the polygon to the
+ * INTERIOR nodes whose stencil reaches a non-interior neighbour, as a sorted list of cell
+ * offsets and their BoundaryArms. Only these cut cells are stored, O(perimeter / h) entries.
+ *
+ * The number of cells of each type and the offsets of the INTERIOR cells are cached after
+ * classification. Cells of a type can be visited lazily through cellsOfType() (indices) or
+ * pointsOfType() (world coordinates) without allocating.
  */
 class FDMGrid {
 private:
@@ -30,9 +184,18 @@ private:
     float originX, originY;  /// @brief Bottom-left corner of the grid
     float dx, dy;            /// @brief Grid spacing
     int nx, ny;              /// @brief Number of grid points in each direction
-    std::vector<std::vector<GridType>> gridMatrix; /// @brief Matrix storing cell classifications
+    int iOffset = 0, jOffset = 0; /// @brief Indices of node (0, 0) in the full grid, nonzero for a window
+    unsigned numThreads;     /// @brief Threads used for classification (0 = hardware concurrency)
+    AlignedVector<GridType> cells; /// @brief Row-major cell classifications, cell (i, j) at j * nx + i
+    std::vector<size_t> armCells; /// @brief Sorted offsets of the interior cells with a cut arm
+    std::vector<BoundaryArms> arms; /// @brief Arms of each cell in armCells
+    std::array<size_t, 4> typeCounts{}; /// @brief Number of cells of each type, indexed by type + 1
+    AlignedVector<size_t> interiorCells; /// @brief Row-major offsets of the INTERIOR cells
     
 public:
+    /// @brief Longest boundary arm searched for, in grid spacings; an edge of slope s leaves arms up to about s long
+    static constexpr int armReach = 8;
+
 /*====================================  Constructor  =========================================*/
 
     /**
@@ -40,8 +203,45 @@ public:
      * @param nx_ Number of grid points in x-direction.
      * @param ny_ Number of grid points in y-direction.
      * @param polygon The polygon defining the interior/exterior regions.
+     * @param numThreads_ Number of threads used to classify scan lines (default = 0, all cores).
+     *        The classification is identical for every thread count.
      */
-    FDMGrid(int nx_, int ny_, Polygon& polygon);
+    FDMGrid(int nx_, int ny_, Polygon& polygon, unsigned numThreads_ = 0);
+
+    /**
+     * @brief Constructs a window of the grid over a polygon, storing only the cells inside it.
+     * Cell (i, j) of the window is cell (window.iBegin + i, window.jBegin + j) of the full
+     * nx_ x ny_ grid, with the same type. The arms of a window cell match the full grid's
+     * when the window extends at least armReach cells beyond it in every direction the full
+     * grid does.
+     * @param nx_ Number of grid points of the full grid in x-direction.
+     * @param ny_ Number of grid points of the full grid in y-direction.
+     * @param polygon The polygon defining the interior/exterior regions.
+     * @param window The cells of the full grid to keep.
+     * @param numThreads_ Number of threads used to classify scan lines (default = 0, all cores).
+     * @throws std::invalid_argument if the window is empty or not inside the full grid.
+     */
+    FDMGrid(int nx_, int ny_, Polygon& polygon, const CellBox& window, unsigned numThreads_ = 0);
+
+    /**
+     * @brief Constructs a grid over a domain with holes.
+     * The grid spans the bounding box of the outer polygon. The edges of all rings go into one
+     * edge table and every row is classified in a single pass (even-odd rule), so the cost grows
+     * with the total edge count, not with the number of holes.
+     * @param nx_ Number of grid points in x-direction.
+     * @param ny_ Number of grid points in y-direction.
+     * @param domain The outer polygon and its holes.
+     * @param numThreads_ Number of threads used to classify scan lines (default = 0, all cores).
+     */
+    FDMGrid(int nx_, int ny_, const Domain& domain, unsigned numThreads_ = 0);
+
+    /**
+     * @brief Constructs a grid from a checkpoint, copying each mapped array once.
+     * Use the GridFile itself for read-only access without any copy.
+     * @param file The opened grid file.
+     * @param numThreads_ Number of threads used by later updates (default = 0, all cores).
+     */
+    explicit FDMGrid(const GridFile& file, unsigned numThreads_ = 0);
 
 
 /*==================================== Getters =============== ==========================*/
@@ -51,7 +251,71 @@ public:
     float getDy() const { return dy; }
     int getNx() const { return nx; }
     int getNy() const { return ny; }
-    const std::vector<std::vector<GridType>>& getGridMatrix() const { return gridMatrix; }
+    unsigned getNumThreads() const { return numThreads; }
+    float getOriginX() const { return originX + iOffset * dx; }
+    float getOriginY() const { return originY + jOffset * dy; }
+
+    /// @brief Bottom-left corner of the full grid; differs from getOriginX/Y() only for a window
+    float getFullOriginX() const { return originX; }
+    float getFullOriginY() const { return originY; }
+
+    /// @brief Indices of node (0, 0) in the full grid; zero unless the grid is a window
+    int getIOffset() const { return iOffset; }
+    int getJOffset() const { return jOffset; }
+
+    /**
+     * @brief Gets a zero-copy view of all cell classifications.
+     * @return A span of nx * ny cells in row-major order (cell (i, j) at j * nx + i).
+     */
+    std::span<const GridType> getCells() const { return cells; }
+
+    /**
+     * @brief Gets a zero-copy view of a single scan line.
+     * @param j The y index of the row.
+     * @return A span of the nx cells of row j.
+     */
+    std::span<const GridType> getRow(int j) const { return getCells().subspan(static_cast<size_t>(j) * nx, nx); }
+
+    /**
+     * @brief Gets the offsets of the interior cells whose stencil reaches the polygon.
+     * @return Sorted row-major offsets, parallel to getArms().
+     */
+    std::span<const size_t> getArmCells() const { return armCells; }
+
+    /**
+     * @brief Gets the boundary distances of the cells in getArmCells().
+     * @return One BoundaryArms per cut cell.
+     */
+    std::span<const BoundaryArms> getArms() const { return arms; }
+
+    /**
+     * @brief Gets the number of cells of a type, counted once after classification.
+     * @param type The type to count.
+     * @return The number of cells with the type.
+     */
+    size_t getCellCount(GridType type) const { return typeCounts[type + 1]; }
+
+    /**
+     * @brief Gets the offsets of all INTERIOR cells.
+     * @return Sorted row-major offsets, getCellCount(INTERIOR) of them.
+     */
+    std::span<const size_t> getInteriorCells() const { return interiorCells; }
+
+    /**
+     * @brief Gets a lazy view of the indices of the cells of a type.
+     * @param type The type of cell to visit.
+     * @return A forward range of CellIndex in row-major order; valid while the grid lives.
+     */
+    CellTypeView cellsOfType(GridType type) const { return CellTypeView(cells, nx, type); }
+
+    /**
+     * @brief Gets a lazy view of the world coordinates of the cells of a type.
+     * @param type The type of cell to visit.
+     * @return A forward range of Point2D in row-major order; valid while the grid lives.
+     */
+    auto pointsOfType(GridType type) const {
+        return cellsOfType(type) | std::views::transform([this](CellIndex c) { return indexToPoint(c.i, c.j); });
+    }
 
         
 /*====================================  Methods  =========================================*/
@@ -71,6 +335,14 @@ public:
       */
     std::pair<int, int> pointToIndex(const Point2D& point) const;
 
+    /**
+     * @brief Converts grid indices to the offset of the cell in the row-major buffer.
+     * @param i The x index of the grid cell.
+     * @param j The y index of the grid cell.
+     * @return The linear offset j * nx + i.
+     */
+    size_t cellIndex(int i, int j) const { return static_cast<size_t>(j) * nx + i; }
+
     /**
      * @brief Gets the grid type of a specific cell.
      * @param i The x index of the grid cell.
@@ -89,11 +361,20 @@ public:
      */
     bool isValidIndex(int i, int j) const;
 
+    /**
+     * @brief Gets the distances from a cell to the polygon along the grid directions.
+     * @param i The x index of the grid cell.
+     * @param j The y index of the grid cell.
+     * @return The cell's arms, or all 1 if the cell is not a cut interior cell.
+     */
+    BoundaryArms getBoundaryArms(int i, int j) const;
+
 
     /**
      * @brief Gets the points of a specific type in the grid.
      * @param type The type of cell to get (INTERIOR, EXTERIOR, BOUNDARY).
-     * @return A vector of Point2D representing the points of the specified type.
+     * @return A vector of Point2D representing the points of the specified type,
+     *         in row-major (storage) order.
      */
     std::vector<Point2D> getPointsOfType(GridType type) const;
     
@@ -117,6 +398,25 @@ public:
      * @return A vector of Point2D representing the exterior points.
      */
     std::vector<Point2D> getExteriorPoints() const;
+
+    /**
+     * @brief Moves vertices of the polygon the grid was built from and updates the grid in place.
+     * The polygon is moved with Polygon::moveVertices, which validates only the edges near the
+     * change. Each run of adjacent moved vertices gets a tile of the cells under its edges,
+     * before or after the move, and only the tiles are re-classified: cells beside a tile keep
+     * their type, since the run's chain of edges keeps its end points and so the parity of the
+     * crossings left of them. Overlapping tiles are united; runs far apart are classified
+     * separately. The arms are re-measured in a box around each tile's edges and changed cells.
+     * Type counts, the interior offsets and the arms end up as a fresh grid over the same geometry
+     * would have them. The grid geometry (origin, spacing) stays fixed even if the polygon's
+     * bounding box changes.
+     * @param polygon The polygon this grid was constructed from.
+     * @param moves The vertices to move.
+     * @return The re-classified tiles, the re-measured boxes and the cells whose type or arms changed.
+     * @throws std::invalid_argument if the move is rejected by Polygon::moveVertices; the polygon
+     *         and the grid are left unchanged.
+     */
+    GridUpdate moveVertices(Polygon& polygon, std::span<const VertexMove> moves);
     
 
     
@@ -132,18 +432,75 @@ private:
     void setCellType(int i, int j, GridType type);
 
 
+    /// @brief Polygon edge prepared for scan conversion, ordered by its lower y (defined in FDMGrid.cpp).
+    struct ScanEdge;
+
     /**
-     * @brief Makes first pass to mark the boundaries of the polygon on the grid.
-     * @param polygon The polygon defining the interior/exterior regions.
-     * @note This method uses Bresenham's line algorithm to mark the boundary cells.
-     * */
-    void markBoundaries(const Polygon& polygon);
-    
+     * @brief Sets the grid geometry from a bounding box, then classifies the cells and measures the arms.
+     * @param minX, minY, maxX, maxY The bounding box spanned by the full grid.
+     * @param fullNx, fullNy Number of grid points of the full grid, nx and ny unless the grid is a window.
+     * @param rings The vertices of every ring of the region.
+     */
+    void build(float minX, float minY, float maxX, float maxY, int fullNx, int fullNy,
+        const std::vector<std::span<const Point2D>>& rings);
+
     /**
-     * @brief Fills the grid with interior and exterior classifications based on the polygon.
-     * @param polygon The polygon defining the interior/exterior regions.
-     * @note This method uses a scan-line fill algorithm to classify the cells.
+     * @brief Builds the edge table of the rings sorted by lower y.
+     * @param rings The vertices of every ring of the region.
+     * @param yMin, yMax Only edges overlapping [yMin, yMax] are kept (default = all edges).
+     * @return One ScanEdge per kept edge, sorted by yLo.
+     */
+    static std::vector<ScanEdge> buildEdgeTable(const std::vector<std::span<const Point2D>>& rings,
+        double yMin = -HUGE_VAL, double yMax = HUGE_VAL);
+
+    /**
+     * @brief Classifies every cell of the grid from the exact edge crossings of the rings.
+     * @param rings The vertices of every ring of the region.
+     * @note Active-edge-table scan conversion in O(edges + cells). Rows are independent,
+     *       so they are partitioned across threads.
      * */
-    void fillInteriorExterior(const Polygon& polygon);
+    void classify(const std::vector<std::span<const Point2D>>& rings);
+
+    /**
+     * @brief Scan-converts the cells [iBegin, iEnd) of the rows [jBegin, jEnd).
+     * Interior/exterior spans come from the exact x-crossings of each edge with the row's
+     * scan line; boundary cells are the nearest nodes to the part of each edge lying in the
+     * row's band [y - dy/2, y + dy/2). Crossings left of the columns only count towards parity.
+     * @param edges The edge table from buildEdgeTable().
+     * @param jBegin First row to classify.
+     * @param jEnd One past the last row to classify.
+     * @param iBegin First column to classify.
+     * @param iEnd One past the last column to classify.
+     */
+    void classifyRows(const std::vector<ScanEdge>& edges, int jBegin, int jEnd, int iBegin, int iEnd);
+
+    /**
+     * @brief Scan-converts a box of cells, its rows partitioned across threads.
+     * @param edges An edge table holding at least every edge overlapping the rows' bands.
+     * @param tile The cells to classify.
+     */
+    void classifyTile(const std::vector<ScanEdge>& edges, const CellBox& tile);
+
+    /**
+     * @brief Measures the arms of every interior cell next to a non-interior cell.
+     * Every crossing of a polygon edge with a grid line is a candidate end of the arms of the
+     * nearest interior nodes on either side of it, reached across non-interior nodes only; each
+     * arm keeps its nearest crossing.
+     * Only cells inside a box are measured, from the crossings of the edges that come within
+     * the longest searched arm of it.
+     * @param rings The vertices of every ring of the region.
+     * @param box The cells to measure.
+     * @param boxCells Output, the sorted offsets of the cut cells in the box.
+     * @param boxArms Output, the arms of each cell in boxCells.
+     * @note O(crossings) work, run after classify().
+     */
+    void measureBoundaryArms(const std::vector<std::span<const Point2D>>& rings, const CellBox& box,
+        std::vector<size_t>& boxCells, std::vector<BoundaryArms>& boxArms) const;
+
+    /**
+     * @brief Counts the cells of each type and collects the INTERIOR offsets.
+     * @note One pass over the cells, run after classify().
+     */
+    void indexCells();
     
 };
@@ -0,0 +1,40 @@
+#pragma once
+#include "AlignedAllocator.h"
+#include <span>
+
+/**
+ * @brief Scalar field sampled at the nodes of an FDMGrid.
+ * Values use the same contiguous, cache-line aligned row-major layout as the grid's cell
+ * classification: node (i, j) is stored at j * nx + i.
+ */
+class GridField {
+private:
+/*====================================  Attributes  =========================================*/
+
+    int nx, ny;                    /// @brief Number of nodes in each direction
+    AlignedVector<double> values;  /// @brief Row-major node values
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Constructs a field with every node set to the same value.
+     * @param nx_ Number of nodes in x-direction.
+     * @param ny_ Number of nodes in y-direction.
+     * @param value The initial value (default = 0).
+     */
+    GridField(int nx_ = 0, int ny_ = 0, double value = 0.0)
+        : nx(nx_), ny(ny_), values(static_cast<size_t>(nx_) * ny_, value) {}
+
+/*==================================== Getters =========================================*/
+
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    std::span<double> getValues() { return values; }
+    std::span<const double> getValues() const { return values; }
+
+/*====================================  Operators  =========================================*/
+
+    double& operator()(int i, int j) { return values[static_cast<size_t>(j) * nx + i]; }
+    double operator()(int i, int j) const { return values[static_cast<size_t>(j) * nx + i]; }
+};
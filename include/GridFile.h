@@ -0,0 +1,173 @@
+#pragma once
+#include "FDMGrid.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief enum class naming the element type of a section of a grid file.
+ * CELL_TYPES: One GridType (int8) per cell.
+ * OFFSETS: Row-major cell offsets (uint64).
+ * ARMS: One BoundaryArms (4 x float32) per cut cell.
+ * FIELD: One float64 per node, in row-major order.
+ */
+enum class GridSectionType : uint32_t {
+    CELL_TYPES,
+    OFFSETS,
+    ARMS,
+    FIELD
+};
+
+/**
+ * @brief Fixed 128-byte header at the start of a grid file.
+ * All values are stored in the byte order of the machine that wrote the file; byteOrder tells
+ * a reader whether that matches its own.
+ */
+struct GridFileHeader {
+    char magic[8];             /// @brief "PDEGRID" and a terminating zero
+    uint32_t version;          /// @brief Format version, GridFile::version when written
+    uint32_t byteOrder;        /// @brief 0x01020304 as written by the producer
+    uint32_t layout;           /// @brief Cell order, 0 = row-major (cell (i, j) at j * nx + i)
+    uint32_t sectionCount;     /// @brief Number of entries in the section table
+    float originX, originY;    /// @brief Bottom-left corner of the grid
+    float dx, dy;              /// @brief Grid spacing
+    int32_t nx, ny;            /// @brief Number of grid points in each direction
+    uint64_t typeCounts[4];    /// @brief Number of cells of each type, indexed by type + 1
+    uint64_t sectionTable;     /// @brief File offset of the section table
+    uint8_t reserved[40];      /// @brief Zero, room for later versions
+};
+
+/**
+ * @brief Entry of the section table: where one array of the file lives.
+ * Section data starts at a multiple of 64 bytes, so a mapped section is cache-line aligned.
+ */
+struct GridFileSection {
+    char name[32];             /// @brief Zero-terminated section name
+    GridSectionType type;      /// @brief Element type
+    uint32_t elementSize;      /// @brief Bytes per element
+    uint64_t offset;           /// @brief File offset of the first element
+    uint64_t count;            /// @brief Number of elements
+    uint64_t reserved;         /// @brief Zero, room for later versions
+};
+
+/**
+ * @brief A named solution field to store next to the grid.
+ */
+struct GridFileField {
+    std::string_view name;         /// @brief Field name, 1 to 31 characters
+    std::span<const double> values; /// @brief One value per node in row-major order
+};
+
+/**
+ * @brief Versioned binary checkpoint of an FDMGrid and its solution fields, read through mmap.
+ *
+ * A file holds a header with the grid geometry, a section table, and 64-byte aligned sections
+ * with the cell types, the cut cells and their arms, the INTERIOR offsets and any number of
+ * float64 fields. Each section is written with one sequential write to a temporary file that
+ * then replaces the target, so readers never see a partial file.
+ *
+ * Opening a file maps it read-only and checks the header and the section table; every getter
+ * is a zero-copy view into the mapping. Pages load on first touch and are shared between all
+ * processes that open the same file. An owning, modifiable FDMGrid can be built from a
+ * GridFile with one copy per array.
+ */
+class GridFile {
+private:
+/*====================================  Attributes  =========================================*/
+
+    MappedFile file;                               /// @brief The mapped file
+    const GridFileHeader* header = nullptr;        /// @brief Header at the start of the mapping
+    std::span<const GridType> cells;               /// @brief Row-major cell classifications
+    std::span<const size_t> armCells;              /// @brief Sorted offsets of the cut cells
+    std::span<const BoundaryArms> arms;            /// @brief Arms of each cell in armCells
+    std::span<const size_t> interiorCells;         /// @brief Sorted offsets of the INTERIOR cells
+    std::vector<std::pair<std::string, std::span<const double>>> fields; /// @brief Fields in file order
+
+public:
+    static constexpr uint32_t version = 1;        /// @brief Version written by this build
+    static constexpr uint32_t byteOrderMark = 0x01020304; /// @brief byteOrder of a file in native order
+
+/*====================================  Constructors  =========================================*/
+
+    /**
+     * @brief Maps a grid file and checks its header, section table and grid sections.
+     * The cell types and offsets are read once to check them; field values are not touched.
+     * @param path The file to open.
+     * @throws std::runtime_error if the file cannot be mapped, is not a grid file, has another
+     *         version or byte order, a section is out of bounds, misaligned or mis-sized, an
+     *         offset list is unsorted or leaves the grid, or the type counts differ from the cells.
+     */
+    explicit GridFile(const std::string& path);
+
+/*==================================== Getters =========================================*/
+
+    uint32_t getVersion() const { return header->version; }
+    float getOriginX() const { return header->originX; }
+    float getOriginY() const { return header->originY; }
+    float getDx() const { return header->dx; }
+    float getDy() const { return header->dy; }
+    int getNx() const { return header->nx; }
+    int getNy() const { return header->ny; }
+
+    /**
+     * @brief Gets the cell classifications, mapped in place.
+     * @return A span of nx * ny cells in row-major order.
+     */
+    std::span<const GridType> getCells() const { return cells; }
+
+    /**
+     * @brief Gets one scan line of the classification.
+     * @param j The y index of the row.
+     * @return A span of the nx cells of row j.
+     */
+    std::span<const GridType> getRow(int j) const { return cells.subspan(static_cast<size_t>(j) * getNx(), getNx()); }
+
+    /**
+     * @brief Gets a lazy view of the indices of the cells of a type.
+     * @param type The type of cell to visit.
+     * @return A forward range of CellIndex in row-major order; valid while the file is open.
+     */
+    CellTypeView cellsOfType(GridType type) const { return CellTypeView(cells, getNx(), type); }
+
+    size_t getCellCount(GridType type) const { return header->typeCounts[type + 1]; }
+    std::span<const size_t> getArmCells() const { return armCells; }
+    std::span<const BoundaryArms> getArms() const { return arms; }
+    std::span<const size_t> getInteriorCells() const { return interiorCells; }
+
+    /**
+     * @brief Gets the names of the stored fields.
+     * @return The names, in the order they were written.
+     */
+    std::vector<std::string> getFieldNames() const;
+
+    /**
+     * @brief Checks whether a field is stored.
+     * @param name The field name.
+     * @return True if the file has a field with this name.
+     */
+    bool hasField(std::string_view name) const;
+
+    /**
+     * @brief Gets a stored field, mapped in place.
+     * @param name The field name.
+     * @return nx * ny values in row-major order.
+     * @throws std::invalid_argument if the file has no field with this name.
+     */
+    std::span<const double> getField(std::string_view name) const;
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Writes a grid and its fields to a file, replacing it atomically.
+     * @param path The file to write; a temporary path + ".tmp" is used while writing.
+     * @param grid The grid to store.
+     * @param fields The fields to store next to it (default = none).
+     * @throws std::invalid_argument if a field has the wrong size or an empty, too long or repeated name.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    static void write(const std::string& path, const FDMGrid& grid, std::span<const GridFileField> fields = {});
+};
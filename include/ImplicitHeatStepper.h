@@ -0,0 +1,96 @@
+#pragma once
+#include "FDMGrid.h"
+#include "GridField.h"
+#include "PcgSolver.h"
+#include <vector>
+
+/**
+ * @brief enum class selecting the implicit time discretization.
+ * BACKWARD_EULER: First order, L-stable; damps every mode.
+ * CRANK_NICOLSON: Second order, A-stable; stiff modes oscillate slowly instead of decaying.
+ */
+enum class TimeScheme : int8_t {
+    BACKWARD_EULER,
+    CRANK_NICOLSON
+};
+
+/**
+ * @brief Cost of one implicit time step.
+ */
+struct TimeStepStats {
+    int iterations = 0;       /// @brief Conjugate gradient iterations of the step's solve
+    double residualNorm = 0;  /// @brief Final relative residual of the solve
+    double milliseconds = 0;  /// @brief Wall time of the whole step (right-hand side, solve and copy)
+};
+
+/**
+ * @brief Implicit time stepping of the heat equation u_t = α∇²u on an FDMGrid.
+ *
+ * With τ = α dt and θ = 1 (backward Euler) or 1/2 (Crank-Nicolson), each step solves
+ *
+ *     (I + θτA) u' = (I - (1 - θ)τA) u + τc
+ *
+ * for the INTERIOR unknowns, where A is the 5-point -∇² and c holds the Dirichlet couplings of
+ * the BOUNDARY cells, which keep their values as in HeatStepper. Dividing by θτ gives the SPD
+ * system (σI + A) u' = ..., σ = 1 / (θτ), which is a shifted PoissonOperator. The operator and
+ * its preconditioner are built once, every solve starts from the previous step's solution,
+ * and the field is only gathered and scattered at the start and end of step(), so a long run
+ * costs little more than its solves. There is no stability limit on dt.
+ *
+ * @note The stepper keeps a reference to the grid, which must outlive it.
+ */
+class ImplicitHeatStepper {
+private:
+/*====================================  Attributes  =========================================*/
+
+    const FDMGrid& grid;                /// @brief The grid whose classification masks the update
+    double alpha;                       /// @brief Diffusivity
+    double dt;                          /// @brief Time step
+    TimeScheme scheme;                  /// @brief Time discretization
+    SolverOptions solverOptions;        /// @brief Stopping criteria of each step's solve
+    PcgSolver solver;                   /// @brief Shifted operator and its preconditioner, built once
+    AlignedVector<double> u, rhs, work; /// @brief Interior unknowns, right-hand side and scratch
+    AlignedVector<double> coupling;     /// @brief Dirichlet couplings of the divided system, per unknown
+    std::vector<TimeStepStats> history; /// @brief Cost of every step since the last clearHistory()
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Assembles the shifted operator and builds its preconditioner.
+     * @param grid_ The classified grid.
+     * @param alpha_ Diffusivity, > 0.
+     * @param dt_ Time step, > 0.
+     * @param scheme_ Time discretization (default = CRANK_NICOLSON).
+     * @param preconditioner NONE, JACOBI or IC0 (default = IC0).
+     * @param solverOptions_ Stopping criteria of each solve (default: relative residual 1e-10).
+     * @throws std::invalid_argument If alpha or dt is not positive, or the preconditioner is MULTIGRID.
+     */
+    ImplicitHeatStepper(const FDMGrid& grid_, double alpha_, double dt_, TimeScheme scheme_ = TimeScheme::CRANK_NICOLSON,
+        PreconditionerType preconditioner = PreconditionerType::IC0, const SolverOptions& solverOptions_ = {1e-10, 1000});
+
+/*==================================== Getters =========================================*/
+
+    const FDMGrid& getGrid() const { return grid; }
+    double getAlpha() const { return alpha; }
+    double getTimeStep() const { return dt; }
+    TimeScheme getScheme() const { return scheme; }
+    double getSetupMilliseconds() const { return solver.getSetupMilliseconds(); }
+    const std::vector<TimeStepStats>& getHistory() const { return history; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Advances the field.
+     * @param field The field, updated in place. BOUNDARY cells hold the Dirichlet data and,
+     *        like EXTERIOR cells, are not modified.
+     * @param steps Number of time steps.
+     * @throws std::runtime_error If a solve does not reach the tolerance.
+     */
+    void step(GridField& field, int steps);
+
+    /**
+     * @brief Forgets the recorded step statistics.
+     */
+    void clearHistory() { history.clear(); }
+};
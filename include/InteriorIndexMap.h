@@ -0,0 +1,81 @@
+#pragma once
+#include "FDMGrid.h"
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A maximal run of consecutive INTERIOR cells within one grid row.
+ * Cells [iBegin, iEnd) of the row are unknowns firstUnknown, firstUnknown + 1, ...
+ */
+struct InteriorRun {
+    int iBegin;            /// @brief First x index of the run
+    int iEnd;              /// @brief One past the last x index of the run
+    int32_t firstUnknown;  /// @brief Unknown number of cell iBegin
+};
+
+/**
+ * @brief Compact numbering of the INTERIOR cells of an FDMGrid.
+ *
+ * Unknowns are numbered in the grid's row-major order, so unknowns of one row are contiguous
+ * and horizontal neighbours differ by one. Only the runs of interior cells of each row are
+ * stored; the cell offset of each unknown is the grid's own list of INTERIOR offsets, which is
+ * in the same order, and no per-cell table exists.
+ *
+ * @note The map views the grid's interior offsets, so the grid must outlive it and a change of
+ * the grid's classification (FDMGrid::moveVertices) invalidates it.
+ */
+class InteriorIndexMap {
+private:
+/*====================================  Attributes  =========================================*/
+
+    int nx, ny;                        /// @brief Dimensions of the grid
+    std::vector<int32_t> rowOffsets;   /// @brief Start of each row's runs in runs (ny + 1 entries)
+    std::vector<InteriorRun> runs;     /// @brief Interior runs, row by row
+    std::span<const size_t> cells;     /// @brief Row-major cell offset of each unknown, viewed in the grid
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Numbers the interior cells of a grid.
+     * @param grid The classified grid, which must outlive the map.
+     */
+    explicit InteriorIndexMap(const FDMGrid& grid);
+
+/*==================================== Getters =========================================*/
+
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    int32_t getUnknownCount() const { return static_cast<int32_t>(cells.size()); }
+    std::span<const size_t> getCells() const { return cells; }
+
+    /**
+     * @brief Gets the interior runs of one row.
+     * @param j The y index of the row.
+     * @return The runs of row j, ordered by x.
+     */
+    std::span<const InteriorRun> getRowRuns(int j) const {
+        return std::span<const InteriorRun>(runs).subspan(rowOffsets[j], rowOffsets[j + 1] - rowOffsets[j]);
+    }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Gets the unknown number of a cell.
+     * @param i The x index of the cell.
+     * @param j The y index of the cell.
+     * @return The unknown number, or -1 if the cell is not interior (or out of range).
+     */
+    int32_t unknownAt(int i, int j) const;
+
+    /**
+     * @brief Gets the grid indices of an unknown.
+     * @param k The unknown number.
+     * @return The pair (i, j).
+     */
+    std::pair<int, int> indexOf(int32_t k) const {
+        return {static_cast<int>(cells[k] % nx), static_cast<int>(cells[k] / nx)};
+    }
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ * The pages are shared with every other process mapping the same file and are loaded on first
+ * touch, so opening a file costs the same for any size. The mapping lives as long as the object;
+ * spans obtained from it must not outlive it.
+ */
+class MappedFile {
+private:
+/*====================================  Attributes  =========================================*/
+
+    const std::byte* data = nullptr;  /// @brief First byte of the mapping, null for an empty file
+    size_t size = 0;                  /// @brief Length of the file in bytes
+#if defined(_WIN32)
+    void* mapping = nullptr;          /// @brief Handle of the file mapping object
+#endif
+
+public:
+/*====================================  Constructors  =========================================*/
+
+    /**
+     * @brief Maps a file for reading.
+     * @param path The file to map.
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+/*==================================== Getters =========================================*/
+
+    /**
+     * @brief Gets a view of the file contents.
+     * @return All bytes of the file; the first one is page aligned.
+     */
+    std::span<const std::byte> getBytes() const { return {data, size}; }
+
+    size_t getSize() const { return size; }
+
+private:
+/*==================================  Helper Methods  =========================================*/
+
+    /** @brief Unmaps the file and resets the object to empty. */
+    void release();
+};
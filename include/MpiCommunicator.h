@@ -0,0 +1,36 @@
+#pragma once
+#include "Communicator.h"
+#include <mpi.h>
+
+/**
+ * @brief MPI backend of the Communicator interface over an MPI communicator.
+ * Built only when CMake finds MPI, into PDE_SOLVER_MPI_TESTS, which ctest runs under mpiexec.
+ *
+ * @note MPI must be initialized before the communicator is constructed and finalized after
+ * it is destroyed; the communicator does neither.
+ */
+class MpiCommunicator : public Communicator {
+private:
+/*====================================  Attributes  =========================================*/
+
+    MPI_Comm comm;  /// @brief The underlying communicator
+    int rank;       /// @brief This process's rank in comm
+    int size;       /// @brief Number of processes in comm
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Wraps an MPI communicator.
+     * @param comm_ The communicator (default = MPI_COMM_WORLD).
+     */
+    explicit MpiCommunicator(MPI_Comm comm_ = MPI_COMM_WORLD);
+
+/*====================================  Methods  =========================================*/
+
+    int getRank() const override { return rank; }
+    int getSize() const override { return size; }
+    void sendReceive(int dest, std::span<const double> sendData, int source, std::span<double> receiveData, int tag) override;
+    double allreduceSum(double value) override;
+    void barrier() override;
+};
@@ -0,0 +1,163 @@
+#pragma once
+#include "FDMGrid.h"
+#include "PoissonOperator.h"
+#include "PoissonSolver.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Recursion pattern of a multigrid cycle.
+ * V: one coarse-grid correction per level.
+ * W: two coarse-grid corrections per level.
+ * F: an F-cycle on the next level followed by a V-cycle.
+ */
+enum class MultigridCycle : int8_t {
+    V,
+    W,
+    F
+};
+
+/**
+ * @brief Configuration of the multigrid hierarchy and cycle.
+ */
+struct MultigridOptions {
+    MultigridCycle cycle = MultigridCycle::V;            /// @brief Cycle type
+    int preSmoothing = 2;                                /// @brief Gauss-Seidel sweeps before the coarse correction
+    int postSmoothing = 2;                               /// @brief Gauss-Seidel sweeps after the coarse correction
+    int maxLevels = 32;                                  /// @brief Upper bound on the number of levels
+    int coarsestUnknowns = 256;                          /// @brief Stop coarsening once a level has at most this many unknowns
+    bool krylovAcceleration = true;                      /// @brief Use each cycle as a conjugate gradient preconditioner instead of a stationary iteration
+    BoundaryStencil stencil = BoundaryStencil::SNAPPED;  /// @brief Boundary treatment of the operator on every level
+};
+
+/**
+ * @brief Intergrid transfer between the unknowns of a fine level and the next coarser one.
+ *
+ * Each fine unknown stores the four coarse nodes surrounding it and their bilinear weights.
+ * Coarse nodes that are not coarse unknowns (boundary or exterior) carry a zero correction,
+ * so their weight is stored as 0; prolongation is the bilinear interpolation of the coarse
+ * correction and restriction is its transpose, scaled by the ratio of cell areas.
+ */
+struct GridTransfer {
+    AlignedVector<int32_t> coarse;  /// @brief 4 coarse unknowns per fine unknown
+    AlignedVector<double> weight;   /// @brief 4 bilinear weights per fine unknown
+    double restrictionScale = 1.0;  /// @brief (dx dy)_fine / (dx dy)_coarse
+};
+
+/**
+ * @brief Geometric multigrid solver for -∇²u = f on a polygonal domain.
+ *
+ * The hierarchy re-classifies the same polygon on successively halved grids: a level with
+ * nx nodes is followed by one with (nx - 1) / 2 + 1, which shares every other node when nx is
+ * odd (and is simply a coarser grid over the same bounding box otherwise). Every level owns
+ * its FDMGrid and its rediscretized 5-point PoissonOperator. The coarsest level is solved
+ * exactly with a banded Cholesky factorization.
+ *
+ * Cycles smooth with Gauss-Seidel (forward sweeps before, reverse sweeps after the coarse
+ * correction), so a V- or W-cycle is a symmetric operator and every cycle costs O(N) work.
+ * Rediscretizing the staircase boundary on each level makes the coarse problems slightly
+ * smaller than the fine one, which slowly erodes the convergence of plain cycling as the grid
+ * is refined; by default solve() therefore uses the cycle as the preconditioner of a flexible
+ * conjugate gradient iteration, which keeps the iteration count essentially flat.
+ */
+class MultigridSolver {
+public:
+    /**
+     * @brief One level of the hierarchy.
+     */
+    struct Level {
+        std::unique_ptr<FDMGrid> grid;      /// @brief Classification of this level
+        std::unique_ptr<PoissonOperator> op;/// @brief 5-point operator on the level's unknowns
+        GridTransfer toCoarse;              /// @brief Transfer to the next level (empty on the coarsest)
+        AlignedVector<double> x, b, r;      /// @brief Correction, right-hand side and residual (x and b unused on the finest level)
+    };
+
+private:
+/*====================================  Attributes  =========================================*/
+
+    MultigridOptions options;           /// @brief Hierarchy and cycle configuration
+    std::vector<Level> levels;          /// @brief Levels from finest to coarsest
+    std::vector<double> coarseFactor;   /// @brief Banded Cholesky factor of the coarsest operator
+    int coarseBandwidth = 0;            /// @brief Lower bandwidth of the coarsest operator
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Builds the multigrid hierarchy.
+     * @param nx Number of grid points in x-direction on the finest level.
+     * @param ny Number of grid points in y-direction on the finest level.
+     * @param polygon The polygon defining the domain.
+     * @param options_ Hierarchy and cycle configuration.
+     * @param numThreads Threads used to classify each level (default = 0, all cores).
+     * @throws std::invalid_argument If the finest grid has no interior cells.
+     */
+    MultigridSolver(int nx, int ny, Polygon& polygon, const MultigridOptions& options_ = {}, unsigned numThreads = 0);
+
+/*==================================== Getters =========================================*/
+
+    const MultigridOptions& getOptions() const { return options; }
+    int getLevelCount() const { return static_cast<int>(levels.size()); }
+    const Level& getLevel(int l) const { return levels[l]; }
+    const FDMGrid& getGrid() const { return *levels.front().grid; }
+    const PoissonOperator& getOperator() const { return *levels.front().op; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Solves -∇²u = f with u = g on the boundary by repeated multigrid cycles.
+     * @param source The source term f (0 for the Laplace equation).
+     * @param boundaryValue The Dirichlet data g.
+     * @param solverOptions Stopping criteria; iterations count cycles (one per Krylov iteration when accelerated).
+     * @return The solution field on the finest grid and convergence information.
+     */
+    SolveResult solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& solverOptions = {});
+
+    /**
+     * @brief Applies one cycle to A x = b on the finest level.
+     * @param b Right-hand side with one entry per finest unknown.
+     * @param x Current iterate, updated in place.
+     */
+    void cycle(std::span<const double> b, std::span<double> x);
+
+private:
+    /**
+     * @brief Builds the transfer from level l to level l + 1.
+     * @param l The fine level.
+     */
+    void buildTransfer(int l);
+
+    /**
+     * @brief Factors the coarsest operator.
+     */
+    void factorCoarsest();
+
+    /**
+     * @brief Solves the coarsest level exactly.
+     * @param b Right-hand side.
+     * @param x Output solution.
+     */
+    void solveCoarsest(std::span<const double> b, std::span<double> x) const;
+
+    /**
+     * @brief Runs a cycle on level l.
+     * @param l The level.
+     * @param type The cycle type to run on this level.
+     * @param b Right-hand side of the level.
+     * @param x Current iterate of the level, updated in place.
+     */
+    void cycleLevel(int l, MultigridCycle type, std::span<const double> b, std::span<double> x);
+
+    /**
+     * @brief Restricts level l's residual into level l + 1's right-hand side.
+     * @param l The fine level.
+     */
+    void restrictResidual(int l);
+
+    /**
+     * @brief Adds the interpolated correction of level l + 1 to an iterate of level l.
+     * @param l The fine level.
+     * @param x The iterate of level l.
+     */
+    void prolongateCorrection(int l, std::span<double> x) const;
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include "FDMGrid.h"
+#include "AlignedAllocator.h"
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Compact copy of an FDMGrid classification at 2 bits per cell.
+ *
+ * The 2-bit code of each cell (BOUNDARY = 0, INTERIOR = 1, EXTERIOR = 2, UNDEFINED = 3) is
+ * split over two bit planes, so one 64-bit word of each plane covers 64 consecutive cells of
+ * a row. A word-level compare turns a pair of words into a 64-cell mask of one type, which is
+ * counted with popcount and enumerated with count-trailing-zeros: runs of other cells are
+ * skipped a word at a time. Each row starts on a new word; the bits past nx in its last word
+ * never match any type.
+ *
+ * The grid's geometry, window offsets included, is copied, so points come out exactly as
+ * from FDMGrid.
+ */
+class PackedCells {
+private:
+/*====================================  Attributes  =========================================*/
+
+    float originX, originY;        /// @brief Bottom-left corner of the full grid
+    float dx, dy;                  /// @brief Grid spacing
+    int nx, ny;                    /// @brief Number of grid points in each direction
+    int iOffset, jOffset;          /// @brief Indices of node (0, 0) in the full grid, nonzero for a window
+    int wordsPerRow;               /// @brief 64-cell words per row, ceil(nx / 64)
+    uint64_t tailMask;             /// @brief Valid cells of the last word of a row
+    AlignedVector<uint64_t> low;   /// @brief Bit 0 of every cell's code, row by row
+    AlignedVector<uint64_t> high;  /// @brief Bit 1 of every cell's code, row by row
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Packs the classification of a grid.
+     * @param grid The classified grid; rows are packed with its thread count.
+     */
+    explicit PackedCells(const FDMGrid& grid);
+
+/*==================================== Getters =========================================*/
+
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    int getWordsPerRow() const { return wordsPerRow; }
+
+    /**
+     * @brief Gets the memory held by the two bit planes.
+     * @return The size in bytes, about nx * ny / 4.
+     */
+    size_t getMemoryBytes() const { return (low.size() + high.size()) * sizeof(uint64_t); }
+
+    /**
+     * @brief Gets the grid type of a specific cell.
+     * @param i The x index of the grid cell.
+     * @param j The y index of the grid cell.
+     * @return The type of the cell; EXTERIOR outside the grid, like FDMGrid::getCellType.
+     */
+    GridType getCellType(int i, int j) const;
+
+    /**
+     * @brief Gets the cells of one type within a word of a row.
+     * @param j The y index of the row.
+     * @param word The word of the row, covering cells 64 * word to 64 * word + 63.
+     * @param type The type to match.
+     * @return Bit b is set if cell (64 * word + b, j) has the type.
+     */
+    uint64_t typeMask(int j, int word, GridType type) const {
+        const size_t k = static_cast<size_t>(j) * wordsPerRow + word;
+        const uint64_t bit0 = (type & 1) ? low[k] : ~low[k];
+        const uint64_t bit1 = (type & 2) ? high[k] : ~high[k];
+        return bit0 & bit1 & (word == wordsPerRow - 1 ? tailMask : ~uint64_t{0});
+    }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Counts the cells of a type.
+     * @param type The type to count.
+     * @return The number of cells with the type.
+     */
+    size_t count(GridType type) const;
+
+    /**
+     * @brief Calls body(i, j) for every cell of a type, in row-major order.
+     * @param type The type to enumerate.
+     * @param body Callable invoked as body(int i, int j).
+     */
+    template <typename Body>
+    void forEachOfType(GridType type, Body&& body) const {
+        for (int j = 0; j < ny; j++) {
+            for (int word = 0; word < wordsPerRow; word++) {
+                for (uint64_t mask = typeMask(j, word, type); mask != 0; mask &= mask - 1) {
+                    body(word * 64 + std::countr_zero(mask), j);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the points of a specific type in the grid.
+     * @param type The type of cell to get (INTERIOR, EXTERIOR, BOUNDARY).
+     * @return The points in row-major order, equal to FDMGrid::getPointsOfType.
+     */
+    std::vector<Point2D> getPointsOfType(GridType type) const;
+
+    /**
+     * @brief Expands the classification back to one GridType per cell.
+     * @return nx * ny cells in row-major order, equal to FDMGrid::getCells.
+     */
+    AlignedVector<GridType> unpack() const;
+};
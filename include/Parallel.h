@@ -0,0 +1,87 @@
+#pragma once
+#include "ThreadPool.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Resolves a requested thread count.
+ * @param numThreads The requested number of threads; 0 selects the hardware concurrency.
+ * @return The number of threads to use (at least 1).
+ */
+inline unsigned resolveThreadCount(unsigned numThreads) {
+    if (numThreads == 0) numThreads = std::thread::hardware_concurrency();
+    return std::max(1u, numThreads);
+}
+
+/**
+ * @brief Runs body(first, last) over contiguous blocks of the range [begin, end) in parallel.
+ *
+ * The range is cut into tiles of at least minGrain iterations, a few per thread, which run on
+ * the shared ThreadPool; idle threads steal tiles from busy ones, so uneven rows balance out.
+ * At most numThreads threads (the calling thread included) run tiles of one call. Tiles never
+ * overlap, so bodies that only write to their own iterations give results identical to a
+ * serial run; a body may itself call parallelFor.
+ *
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param minGrain Minimum number of iterations per block.
+ * @param numThreads Maximum number of threads; 0 selects the hardware concurrency.
+ * @param body Callable invoked as body(int first, int last) for each block, on any thread.
+ */
+template <typename Body>
+void parallelFor(int begin, int end, int minGrain, unsigned numThreads, Body&& body) {
+    const int count = end - begin;
+    if (count <= 0) return;
+
+    const int threads = static_cast<int>(resolveThreadCount(numThreads));
+    if (threads == 1 || count <= minGrain) {
+        body(begin, end);
+        return;
+    }
+    const int tilesPerThread = 4;
+    const int tileSize = std::max({1, minGrain, (count + threads * tilesPerThread - 1) / (threads * tilesPerThread)});
+    ThreadPool::global().run(begin, end, tileSize, numThreads, body);
+}
+
+/**
+ * @brief Reduces map(first, last) over blocks of [begin, end) in parallel.
+ *
+ * The blocks are exactly [begin + k * grain, begin + (k + 1) * grain), and their partial results
+ * are combined in block order, so the result depends on grain but not on the thread count or
+ * on which thread ran which block.
+ *
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param grain Number of iterations per block.
+ * @param numThreads Maximum number of threads; 0 selects the hardware concurrency.
+ * @param identity The value of an empty reduction.
+ * @param map Callable invoked as map(int first, int last) -> T for each block.
+ * @param combine Callable invoked as combine(T accumulated, T partial) -> T.
+ * @return identity combined with every block's partial result, in order.
+ */
+template <typename T, typename Map, typename Combine>
+T parallelReduce(int begin, int end, int grain, unsigned numThreads, T identity, Map&& map, Combine&& combine) {
+    const int count = end - begin;
+    if (count <= 0) return identity;
+    grain = std::max(1, grain);
+
+    // One cache line per block: threads writing neighbouring partials neither share a line nor,
+    // as std::vector<bool> would, a byte
+    struct alignas(64) Partial {
+        T value;
+    };
+    const int blocks = (count + grain - 1) / grain;
+    std::vector<Partial> partials(blocks, Partial{identity});
+    auto body = [&](int first, int last) { partials[(first - begin) / grain].value = map(first, last); };
+    if (blocks == 1 || resolveThreadCount(numThreads) == 1) {
+        for (int first = begin; first < end; first += grain) body(first, std::min(end, first + grain));
+    }
+    else {
+        ThreadPool::global().run(begin, end, grain, numThreads, body);
+    }
+
+    T result = identity;
+    for (const Partial& partial : partials) result = combine(result, partial.value);
+    return result;
+}
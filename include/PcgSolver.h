@@ -0,0 +1,116 @@
+#pragma once
+#include "FDMGrid.h"
+#include "MultigridSolver.h"
+#include "PoissonOperator.h"
+#include "PoissonSolver.h"
+#include "Preconditioner.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief State of a conjugate gradient solve after one iteration.
+ */
+struct PcgIteration {
+    double residualNorm = 0;  /// @brief Residual norm relative to the right-hand side norm
+    double milliseconds = 0;  /// @brief Wall time since the solve started
+};
+
+/**
+ * @brief Outcome of a preconditioned conjugate gradient solve with its instrumentation.
+ * history[0] is the initial residual, history[k] the state after iteration k.
+ */
+struct PcgResult : SolveResult {
+    std::vector<PcgIteration> history;  /// @brief Residual and elapsed time per iteration
+    double setupMilliseconds = 0;       /// @brief Wall time spent building the preconditioner
+    double solveMilliseconds = 0;       /// @brief Wall time of the iteration, excluding setup
+};
+
+/**
+ * @brief Preconditioned conjugate gradients for -∇²u = f on the interior of an FDMGrid with u = g on its boundary.
+ *
+ * The 5-point operator and the preconditioner are built once; every solve reuses them. Each
+ * iteration makes four passes over the vectors: the operator product fused with p·Ap, the
+ * update of x and r fused with r·r, the preconditioner fused with r·z, and the update of p.
+ * Preconditioners that are not symmetric (F-cycles) switch to the flexible Polak-Ribiere
+ * update, which costs one more dot product.
+ *
+ * @note A solver built on an FDMGrid keeps a reference to it, which must outlive the solver.
+ */
+class PcgSolver {
+private:
+/*====================================  Attributes  =========================================*/
+
+    std::unique_ptr<FDMGrid> ownedGrid;              /// @brief Grid classified by the polygon constructor without multigrid
+    std::unique_ptr<MultigridSolver> multigrid;      /// @brief Hierarchy of the multigrid preconditioner (owns the grid and operator)
+    std::unique_ptr<PoissonOperator> ownedOperator;  /// @brief Operator built for a caller's grid
+    const PoissonOperator* op;                       /// @brief The operator being solved
+    std::unique_ptr<Preconditioner> preconditioner;  /// @brief Approximate inverse applied every iteration
+    PreconditionerType type;                         /// @brief Kind of the preconditioner
+    double setupMilliseconds = 0;                    /// @brief Time spent building the preconditioner
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Assembles the operator of a grid and builds a preconditioner for it.
+     * @param grid The classified grid.
+     * @param type_ NONE, JACOBI or IC0 (default = JACOBI).
+     * @param shift Diagonal shift σ of the operator σI - ∇² (default = 0).
+     * @throws std::invalid_argument If type_ is MULTIGRID, whose hierarchy needs the polygon.
+     */
+    explicit PcgSolver(const FDMGrid& grid, PreconditionerType type_ = PreconditionerType::JACOBI, double shift = 0.0);
+
+    /**
+     * @brief Classifies the polygon on an nx x ny grid and builds any preconditioner.
+     * With MULTIGRID the finest level of the hierarchy is the grid that is solved on.
+     * @param nx Number of grid points in x-direction.
+     * @param ny Number of grid points in y-direction.
+     * @param polygon The polygon defining the domain.
+     * @param type_ The preconditioner.
+     * @param multigridOptions Hierarchy and cycle of the MULTIGRID preconditioner.
+     * @param numThreads Threads used to classify the grid (default = 0, all cores).
+     */
+    PcgSolver(int nx, int ny, Polygon& polygon, PreconditionerType type_,
+        const MultigridOptions& multigridOptions = {}, unsigned numThreads = 0);
+
+/*==================================== Getters =========================================*/
+
+    const PoissonOperator& getOperator() const { return *op; }
+    const FDMGrid& getGrid() const { return op->getGrid(); }
+    PreconditionerType getPreconditionerType() const { return type; }
+    double getSetupMilliseconds() const { return setupMilliseconds; }
+
+/*==================================== Setters =========================================*/
+
+    /**
+     * @brief Replaces the preconditioner with a custom one.
+     * @param preconditioner_ The preconditioner, applied to vectors over the operator's unknowns.
+     */
+    void setPreconditioner(std::unique_ptr<Preconditioner> preconditioner_);
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Solves -∇²u = f with u = g on the boundary from a zero initial guess.
+     * @param source The source term f (0 for the Laplace equation).
+     * @param boundaryValue The Dirichlet data g.
+     * @param options Stopping criteria.
+     * @return The solution field, convergence information, per-iteration history and timings.
+     */
+    PcgResult solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& options = {});
+
+    /**
+     * @brief Solves A x = b on the interior unknowns.
+     * @param b Right-hand side with one entry per unknown.
+     * @param x Initial guess, overwritten with the solution.
+     * @param options Stopping criteria.
+     * @return Convergence information, history and timings; the field is left empty.
+     */
+    PcgResult solve(std::span<const double> b, std::span<double> x, const SolverOptions& options = {});
+
+private:
+    /**
+     * @brief Builds the preconditioner of the given type on the operator and times it.
+     */
+    void buildPreconditioner();
+};
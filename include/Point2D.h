@@ -34,12 +34,6 @@ public:
      */
     Point2D(float x_ = 0, float y_ = 0);
 
-   /**
-    * @brief Constructs a Point from another Point.
-    * @param point The point to copy.
-	*/
-    Point2D(const Point2D& point);
-
    /**
     * @brief Constructs a Point from a pair of coordinates.
     * @param coords The coordinates to copy.
@@ -0,0 +1,170 @@
+#pragma once
+#include "FDMGrid.h"
+#include "GridField.h"
+#include "InteriorIndexMap.h"
+#include <functional>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Coupling of an interior unknown to a Dirichlet boundary value.
+ * The term weight * g(location) moves to the right-hand side of the unknown's equation.
+ */
+struct BoundaryCoupling {
+    int32_t unknown;   /// @brief The interior unknown whose stencil reaches the boundary
+    Point2D location;  /// @brief Where the boundary value is sampled
+    double weight;     /// @brief Stencil weight of the boundary value
+};
+
+/// @brief Scalar function of position used for sources and boundary values.
+using ScalarFunction = std::function<double(const Point2D&)>;
+
+/**
+ * @brief enum class selecting how the stencil treats nodes next to the boundary.
+ * SNAPPED: The polygon is replaced by the nearest BOUNDARY nodes, which hold the Dirichlet
+ *          values; first-order accurate in the position of the boundary.
+ * SHORTLEY_WELLER: Arms that reach the polygon end at the exact crossing of the grid line
+ *          (FDMGrid::getBoundaryArms), where the Dirichlet value is sampled; second-order accurate.
+ */
+enum class BoundaryStencil : int8_t {
+    SNAPPED,
+    SHORTLEY_WELLER
+};
+
+/**
+ * @brief Discrete operator -∇² on the INTERIOR cells of an FDMGrid with Dirichlet boundary values.
+ *
+ * The standard 5-point stencil is stored per unknown in structure-of-arrays form: a diagonal
+ * weight and, for each of the four directions, a neighbour unknown and a weight. Row k reads
+ *
+ *     diag[k] u[k] - west[k] u[westIdx[k]] - east[k] u[eastIdx[k]] - south[k] u[southIdx[k]] - north[k] u[northIdx[k]]
+ *
+ * With the SHORTLEY_WELLER stencil an arm of length θh that ends on the polygon replaces
+ * the difference to the neighbour by (u - g) / (θh) inside the standard second difference,
+ * so the node's direction gets weight c / θ (c = 1 / h²) both on the diagonal and on the
+ * boundary value g at the crossing. Weights between two unknowns stay c, which keeps the
+ * matrix symmetric positive definite; the local truncation error at those nodes is O(1), but
+ * the solution converges at second order.
+ *
+ * An optional shift σ adds σ to every diagonal weight, giving σI - ∇², the operator of an
+ * implicit time step of the heat equation after dividing by the step's weight.
+ *
+ * A neighbour that is not an unknown gets weight 0 and points at k itself, so applying the
+ * operator needs no branches. Its value is recorded as a BoundaryCoupling and enters the
+ * right-hand side instead. The matrix is symmetric positive definite.
+ *
+ * @note The operator keeps a reference to the grid, which must outlive it.
+ */
+class PoissonOperator {
+private:
+/*====================================  Attributes  =========================================*/
+
+    const FDMGrid& grid;                       /// @brief The grid the operator is built on
+    InteriorIndexMap indexMap;                 /// @brief Numbering of the interior cells
+    double shift;                              /// @brief Multiple of the identity added to -∇²
+    BoundaryStencil stencil;                   /// @brief Treatment of the boundary
+    AlignedVector<double> diag;                /// @brief Diagonal weight per unknown
+    AlignedVector<double> west, east;          /// @brief Weights of the x-neighbours
+    AlignedVector<double> south, north;        /// @brief Weights of the y-neighbours
+    AlignedVector<int32_t> westIdx, eastIdx;   /// @brief Unknown of the x-neighbours (self if Dirichlet)
+    AlignedVector<int32_t> southIdx, northIdx; /// @brief Unknown of the y-neighbours (self if Dirichlet)
+    std::vector<BoundaryCoupling> couplings;   /// @brief Dirichlet terms of the right-hand side
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Assembles the 5-point stencil over the interior cells of a grid.
+     * @param grid_ The classified grid. Cells next to an interior cell that are not interior
+     *        (normally BOUNDARY) supply Dirichlet values.
+     * @param shift_ Added to the diagonal, σ >= 0 keeps the operator SPD (default = 0, -∇²).
+     * @param stencil_ Treatment of the boundary (default = SNAPPED).
+     */
+    explicit PoissonOperator(const FDMGrid& grid_, double shift_ = 0.0, BoundaryStencil stencil_ = BoundaryStencil::SNAPPED);
+
+/*==================================== Getters =========================================*/
+
+    const FDMGrid& getGrid() const { return grid; }
+    const InteriorIndexMap& getIndexMap() const { return indexMap; }
+    int32_t getUnknownCount() const { return indexMap.getUnknownCount(); }
+    double getShift() const { return shift; }
+    BoundaryStencil getStencil() const { return stencil; }
+    std::span<const double> getDiagonal() const { return diag; }
+    std::span<const double> getWestWeights() const { return west; }
+    std::span<const double> getEastWeights() const { return east; }
+    std::span<const double> getSouthWeights() const { return south; }
+    std::span<const double> getNorthWeights() const { return north; }
+    std::span<const int32_t> getWestIndices() const { return westIdx; }
+    std::span<const int32_t> getEastIndices() const { return eastIdx; }
+    std::span<const int32_t> getSouthIndices() const { return southIdx; }
+    std::span<const int32_t> getNorthIndices() const { return northIdx; }
+    const std::vector<BoundaryCoupling>& getBoundaryCouplings() const { return couplings; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Couples an unknown to the Dirichlet value beyond one of its neighbours.
+     * With SNAPPED the value is sampled at the neighbouring node with the stencil's weight; with
+     * SHORTLEY_WELLER it is sampled at the end of the node's arm with weight c / θ.
+     * @param grid The classified grid.
+     * @param stencil Treatment of the boundary.
+     * @param k The unknown.
+     * @param i The x index of the unknown's node.
+     * @param j The y index of the unknown's node.
+     * @param di, dj Direction of the neighbour that is not an unknown.
+     * @param weight Weight c of the direction in the 5-point stencil.
+     * @param arm Length θ of the node's arm in the direction, in grid spacings.
+     * @return The coupling; its weight replaces c in the unknown's diagonal weight.
+     */
+    static BoundaryCoupling dirichletCoupling(const FDMGrid& grid, BoundaryStencil stencil, int32_t k, int i, int j,
+        int di, int dj, double weight, float arm);
+
+    /**
+     * @brief Computes y = A x.
+     * @param x Input vector with one entry per unknown.
+     * @param y Output vector with one entry per unknown.
+     */
+    void apply(std::span<const double> x, std::span<double> y) const;
+
+    /**
+     * @brief Computes y = A x and returns x·y in the same pass.
+     * The unknowns are summed in fixed tiles added in order, so the result does not depend on the thread count.
+     * @param x Input vector with one entry per unknown.
+     * @param y Output vector with one entry per unknown.
+     * @return The dot product of x and A x.
+     */
+    double applyDot(std::span<const double> x, std::span<double> y) const;
+
+    /**
+     * @brief Computes the residual r = b - A x.
+     * @param b Right-hand side with one entry per unknown.
+     * @param x Current iterate with one entry per unknown.
+     * @param r Output residual with one entry per unknown.
+     */
+    void residual(std::span<const double> b, std::span<const double> x, std::span<double> r) const;
+
+    /**
+     * @brief Performs one in-place Gauss-Seidel sweep on A x = b in unknown order.
+     * @param b Right-hand side with one entry per unknown.
+     * @param x Current iterate, updated in place.
+     * @param reverse If true the sweep runs from the last unknown to the first, so a forward
+     *        sweep followed by a reverse one is a symmetric smoother.
+     */
+    void gaussSeidel(std::span<const double> b, std::span<double> x, bool reverse = false) const;
+
+    /**
+     * @brief Builds the right-hand side of -∇²u = f with u = g on the boundary.
+     * @param source The source term f.
+     * @param boundaryValue The Dirichlet data g.
+     * @return One entry per unknown: f at the node plus the boundary couplings.
+     */
+    AlignedVector<double> assembleRhs(const ScalarFunction& source, const ScalarFunction& boundaryValue) const;
+
+    /**
+     * @brief Expands a solution over the unknowns into a field over the whole grid.
+     * @param u One value per unknown.
+     * @param boundaryValue The Dirichlet data, written to BOUNDARY cells.
+     * @return The field: u on INTERIOR cells, g on BOUNDARY cells and 0 on EXTERIOR cells.
+     */
+    GridField toField(std::span<const double> u, const ScalarFunction& boundaryValue) const;
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include "FDMGrid.h"
+#include "GridField.h"
+#include "PoissonOperator.h"
+
+/**
+ * @brief Stopping criteria of an iterative solve.
+ */
+struct SolverOptions {
+    double tolerance = 1e-8;    /// @brief Target residual norm relative to the right-hand side norm
+    int maxIterations = 10000;  /// @brief Iteration limit
+};
+
+/**
+ * @brief Outcome of a solve.
+ */
+struct SolveResult {
+    GridField field;            /// @brief Solution over the whole grid
+    int iterations = 0;         /// @brief Iterations performed
+    double residualNorm = 0;    /// @brief Final residual norm relative to the right-hand side norm
+    bool converged = false;     /// @brief True if the tolerance was reached
+};
+
+/**
+ * @brief Solves the Poisson equation -∇²u = f on the interior of an FDMGrid with u = g on its boundary.
+ * The 5-point operator is assembled once; each solve builds the right-hand side and runs
+ * conjugate gradients on the interior unknowns.
+ *
+ * @note The solver keeps a reference to the grid, which must outlive it.
+ */
+class PoissonSolver {
+private:
+/*====================================  Attributes  =========================================*/
+
+    PoissonOperator op;  /// @brief The assembled operator
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Assembles the operator for a grid.
+     * @param grid The classified grid.
+     * @param stencil Treatment of the boundary (default = SNAPPED).
+     */
+    explicit PoissonSolver(const FDMGrid& grid, BoundaryStencil stencil = BoundaryStencil::SNAPPED);
+
+/*==================================== Getters =========================================*/
+
+    const PoissonOperator& getOperator() const { return op; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Solves -∇²u = f with u = g on the boundary.
+     * @param source The source term f (0 for the Laplace equation).
+     * @param boundaryValue The Dirichlet data g.
+     * @param options Stopping criteria.
+     * @return The solution field and convergence information.
+     */
+    SolveResult solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& options = {}) const;
+};
@@ -1,8 +1,31 @@
 #pragma once
+#include <cstdint>
 #include <vector>
+#include <span>
 #include <stdexcept>
 #include <ostream>
 #include "Point2D.h"
+#include "PolygonEdges.h"
+#include "PolygonIndex.h"
+#include "SimdDispatch.h"
+
+/**
+ * @brief Algorithm used to check a polygon for self-intersections.
+ * SWEEP_LINE: Shamos–Hoey sweep, O(n log n).
+ * BRUTE_FORCE: Tests every pair of edges, O(n^2). Kept as a reference for testing.
+ */
+enum class ValidationMethod : int8_t {
+    SWEEP_LINE,
+    BRUTE_FORCE
+};
+
+/**
+ * @brief New position of one polygon vertex, for Polygon::moveVertices.
+ */
+struct VertexMove {
+    size_t index;      /// @brief Index of the vertex in the polygon
+    Point2D position;  /// @brief Where the vertex moves to
+};
 
 /**
  * @brief Represents a simple polygon with arbitrary vertices.
@@ -10,6 +33,7 @@
  * This class stores a sequence of vertices and checks for self-intersection.
  */
 class Polygon {
+    friend class Domain;
 
 private:
 /*====================================  Attributes  =========================================*/
@@ -19,16 +43,21 @@ private:
 	float minY; /// @brief Minimum y-coordinate of the polygon.
 	float maxX; /// @brief Maximum x-coordinate of the polygon.
 	float maxY; /// @brief Maximum y-coordinate of the polygon.
+    PolygonEdges edges; /// @brief Per-edge data precomputed for point queries.
+    size_t indexMinEdges = 64; /// @brief Edge count from which point queries go through the spatial index.
+    LazyPolygonIndex index; /// @brief Spatial index for point queries, built on first use.
     
 public:
 /*====================================  Constructors  =========================================*/
 
     /**
      * @brief Constructs a polygon from a list of vertices.
-     * @param vertices_ A vector of points representing the vertices (in order).
+     * @param vertices_ A vector of points representing the vertices (in order); an rvalue is
+     *        moved in without copying the vertex array.
+     * @param method The self-intersection check to run (default = SWEEP_LINE).
      * @throws std::invalid_argument if the polygon is self-intersecting.
      */
-    Polygon(const std::vector<Point2D>& vertices_);
+    Polygon(std::vector<Point2D> vertices_, ValidationMethod method = ValidationMethod::SWEEP_LINE);
 
 
 
@@ -41,6 +70,31 @@ public:
      */
     const std::vector<Point2D>& getVertices() const;
 
+    /**
+     * @brief Gets the precomputed structure-of-arrays edge data.
+     * @return A const reference to the edge arrays.
+     */
+    const PolygonEdges& getEdges() const;
+
+    /**
+     * @brief Sets the edge count from which point queries use the spatial index.
+     * @param minEdges The threshold; 0 always uses the index, SIZE_MAX never does.
+     */
+    void setIndexMinEdges(size_t minEdges);
+
+    /**
+     * @brief Checks whether point queries on this polygon go through the spatial index.
+     * @return True if the polygon has at least the threshold number of edges.
+     */
+    bool usesIndex() const;
+
+    /**
+     * @brief Gets the spatial index, building it now if no query has done so yet.
+     * Can be called up front to prebuild the index or to read its build cost and memory.
+     * @return A const reference to the index.
+     */
+    const PolygonIndex& getIndex() const;
+
     /**
      * @brief Gets the minimum x-coordinate of the polygon.
      * @return The minimum x-coordinate.
@@ -82,15 +136,31 @@ public:
 
     /**
      * @brief Checks if a point is in the interior of the polygon using the ray-casting algorithm O(n).
+     * With the spatial index only the edges of the point's y-slab are visited.
      * 
      * @param point The point to check.
      * @return True if the point is inside the polygon, false otherwise.
      */
     bool containsPoint(const Point2D& point) const;
 
+    /**
+     * @brief Checks a batch of points for containment, equivalent to calling containsPoint on each.
+     * Points are given as separate x and y arrays; the widest SIMD kernel supported at runtime is used,
+     * unless the polygon uses its spatial index, in which case each point visits only its slab.
+     *
+     * @param xs The x-coordinates of the query points.
+     * @param ys The y-coordinates of the query points.
+     * @param inside Output, set to 1 for points inside the polygon and 0 otherwise.
+     * @param level The widest SIMD level to use (default = AVX512, clamped to what the CPU supports).
+     * @throws std::invalid_argument if the three spans differ in size.
+     */
+    void containsPoints(std::span<const float> xs, std::span<const float> ys, std::span<uint8_t> inside,
+        SimdLevel level = SimdLevel::AVX512) const;
+
 
     /**
      * @brief Checks if a point is on the boundary of the polygon O(n).
+     * With the spatial index only the edges in nearby grid cells are visited.
      * 
      * @param point The point to check.
      * @param epsilon The tolerance for floating-point comparison (default = 1e-10).
@@ -98,20 +168,64 @@ public:
      */
     bool isOnBoundary(const Point2D& point, float epsilon = 1e-10f) const;
 
+    /**
+     * @brief Moves some vertices, keeping the polygon simple.
+     * Only the edges next to a moved vertex are validated: each is tested against the edges whose
+     * bounding box overlaps the moved edges, O(n + k m) for k moved edges and m edges near them.
+     * The edge arrays are patched in place and the spatial index is rebuilt on its next use.
+     *
+     * @param moves The vertices to move; a vertex may appear once.
+     * @throws std::invalid_argument if an index is out of range or repeated, or if the moved
+     *         polygon is self-intersecting. The polygon is left unchanged.
+     */
+    void moveVertices(std::span<const VertexMove> moves);
+
 
 
 
 private:
 /*==================================  Helper Methods  =========================================*/
 
-	/** @brief Checks if the polygon is self-intersecting.
-     *  Temporarily implemented using brute force O(n^2) method.
-     *  Improving this to O(n log n) using a sweep line algorithm is possible.
-     *  
-     *  @note Future improvements: Shamos–Hoey algorithm, Bentley–Ottmann algorithm
+	/** @brief Checks if the polygon is self-intersecting with the given method.
+     *  Non-adjacent edges may neither cross nor touch. Orientation tests are exact
+     *  (adaptive floating-point filter with an expansion-arithmetic fallback).
+     *
+     *  @param method The algorithm to use.
      *  @throws std::invalid_argument if the polygon is self-intersecting.
      */
-    void validatePolygon() const;
+    void validatePolygon(ValidationMethod method) const;
+
+	/** @brief Checks if the polygon is self-intersecting using brute force O(n^2) over edge pairs.
+     *  @throws std::invalid_argument if the polygon is self-intersecting.
+     */
+    void validatePolygonBruteForce() const;
+
+	/** @brief Checks if the polygon is self-intersecting using the Shamos–Hoey sweep O(n log n).
+     *  Edges enter and leave a balanced tree ordered along the sweep line; only edges that become
+     *  neighbours in the tree are tested, which finds an intersection if any exists.
+     *  @throws std::invalid_argument if the polygon is self-intersecting.
+     */
+    void validatePolygonSweepLine() const;
+
+    /** @brief Checks that several rings are simple and that no two of them cross or touch.
+     *  All edges go through one check: a single Shamos–Hoey sweep, or brute force over all pairs.
+     *  @param rings The vertices of each ring, at least 3 per ring.
+     *  @param method The algorithm to use.
+     *  @throws std::invalid_argument if a ring has fewer than 3 vertices or any two edges intersect.
+     */
+    static void validateRings(const std::vector<std::span<const Point2D>>& rings, ValidationMethod method);
+
+    /// @brief Tag of the constructor that skips validation, for rings already checked by validateRings
+    struct Prevalidated {};
+
+    /**
+     * @brief Constructs a polygon from vertices that have already been validated.
+     * @param vertices_ A vector of points representing the vertices (in order).
+     */
+    Polygon(std::vector<Point2D> vertices_, Prevalidated);
+
+    /** @brief Computes the bounding box and the edge arrays of the vertices. */
+    void prepare();
     
 
 };
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+#include "AlignedAllocator.h"
+
+/**
+ * @brief Structure-of-arrays copy of the polygon edges used by the ray-casting point queries.
+ * Edge k runs from vertex k to vertex k - 1 (cyclically), matching the ray-casting loop,
+ * and carries its inverse slope so queries never divide.
+ */
+struct PolygonEdges {
+    AlignedVector<float> x;     /// @brief x-coordinate of vertex k
+    AlignedVector<float> y;     /// @brief y-coordinate of vertex k
+    AlignedVector<float> yPrev; /// @brief y-coordinate of vertex k - 1
+    AlignedVector<float> slope; /// @brief dx/dy from vertex k to vertex k - 1 (0 for horizontal edges)
+};
+
+/**
+ * @brief Axis-aligned bounding box of a polygon.
+ */
+struct PolygonBounds {
+    float minX, minY, maxX, maxY;
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include "Polygon.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief enum class naming the layout of a polygon vertex file.
+ * CSV: One "x,y" pair per line (comma, semicolon or blanks between), with an optional header
+ *      line without numeric fields and '#' comment lines.
+ * WKT: A single-ring well-known text POLYGON ((x y, x y, ...)).
+ * BINARY: Raw float32 x, y pairs in native byte order, no header.
+ */
+enum class PolygonFormat : int8_t {
+    CSV,
+    WKT,
+    BINARY
+};
+
+/**
+ * @brief Loaders of polygon outlines from vertex files.
+ *
+ * Files are memory-mapped and parsed in place: text formats with std::from_chars, without
+ * locale or stream overhead, the binary format with one memcpy into the vertex array. The
+ * vertex array is then moved into the Polygon, so a loaded outline is never copied. A last
+ * vertex repeating the first, as WKT and most GIS exports close their rings, is dropped.
+ */
+class PolygonFile {
+public:
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Picks the format from the file extension: .csv, .wkt, or .bin / .f32.
+     * @param path The file name.
+     * @return The format.
+     * @throws std::invalid_argument if the extension is none of these.
+     */
+    static PolygonFormat formatOf(const std::string& path);
+
+    /**
+     * @brief Parses the vertices of a file already in memory.
+     * @param bytes The file contents.
+     * @param format The layout of the contents.
+     * @return The vertices, in file order.
+     * @throws std::runtime_error if the contents do not match the format.
+     */
+    static std::vector<Point2D> parse(std::span<const std::byte> bytes, PolygonFormat format);
+
+    /**
+     * @brief Maps a vertex file and parses its vertices.
+     * @param path The file to read.
+     * @param format The layout of the file.
+     * @return The vertices, in file order.
+     * @throws std::runtime_error if the file cannot be mapped or does not match the format.
+     */
+    static std::vector<Point2D> readVertices(const std::string& path, PolygonFormat format);
+
+    /**
+     * @brief Loads a polygon from a vertex file.
+     * @param path The file to read.
+     * @param format The layout of the file.
+     * @param method The self-intersection check to run (default = SWEEP_LINE).
+     * @return The polygon, owning the parsed vertex array.
+     * @throws std::runtime_error if the file cannot be mapped or does not match the format.
+     * @throws std::invalid_argument if the outline is not a simple polygon.
+     */
+    static Polygon read(const std::string& path, PolygonFormat format, ValidationMethod method = ValidationMethod::SWEEP_LINE);
+
+    /**
+     * @brief Writes vertices as raw float32 pairs, the BINARY format.
+     * @param path The file to write.
+     * @param vertices The vertices.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    static void writeBinary(const std::string& path, std::span<const Point2D> vertices);
+};
@@ -0,0 +1,130 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Point2D.h"
+#include "PolygonEdges.h"
+
+/**
+ * @brief Build cost and footprint of a PolygonIndex.
+ */
+struct PolygonIndexStats {
+    double buildMilliseconds = 0; /// @brief Wall time spent building the index
+    size_t memoryBytes = 0;       /// @brief Heap memory held by the index
+    int slabCount = 0;            /// @brief Number of horizontal slabs of the containment index
+    size_t slabEntries = 0;       /// @brief Total edge references over all slabs
+    int gridCols = 0;             /// @brief Columns of the boundary grid
+    int gridRows = 0;             /// @brief Rows of the boundary grid
+    size_t gridEntries = 0;       /// @brief Total edge references over all grid cells
+};
+
+/**
+ * @brief Spatial acceleration structure for point queries against a polygon.
+ *
+ * Containment uses equal-height y-slabs, each listing the edges whose y-range overlaps it,
+ * so a ray-casting query only visits the edges of one slab. Boundary queries use a uniform
+ * grid over the bounding box where each cell lists the edges passing through it. Both are
+ * stored in compressed (offsets + edge ids) form. Queries return exactly what the linear
+ * scans in Polygon return.
+ */
+class PolygonIndex {
+private:
+/*====================================  Attributes  =========================================*/
+
+    PolygonBounds bounds;             /// @brief Bounding box of the polygon
+    int slabCount;                    /// @brief Number of y-slabs
+    double slabScale;                 /// @brief Slabs per unit of y
+    std::vector<size_t> slabOffsets;  /// @brief Start of each slab in slabEdges (slabCount + 1 entries)
+    std::vector<uint32_t> slabEdges;  /// @brief Edge ids (PolygonEdges numbering) per slab
+    int gridCols, gridRows;           /// @brief Dimensions of the boundary grid
+    double cellScaleX, cellScaleY;    /// @brief Grid cells per unit of x and y
+    std::vector<size_t> cellOffsets;  /// @brief Start of each cell in cellEdges (row-major, cols * rows + 1 entries)
+    std::vector<uint32_t> cellEdges;  /// @brief Edge ids (vertex i to i + 1) per cell
+    PolygonIndexStats stats;          /// @brief Build cost and memory
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Builds the slab and grid indices.
+     * @param vertices The polygon vertices.
+     * @param edges The precomputed edge arrays of the polygon.
+     * @param bounds_ The bounding box of the polygon.
+     */
+    PolygonIndex(const std::vector<Point2D>& vertices, const PolygonEdges& edges, const PolygonBounds& bounds_);
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Ray-casting containment test visiting only the edges of the point's slab.
+     * @param edges The edge arrays the index was built from.
+     * @param px The x-coordinate of the point.
+     * @param py The y-coordinate of the point.
+     * @return True if the point is inside the polygon.
+     */
+    bool containsPoint(const PolygonEdges& edges, float px, float py) const;
+
+    /**
+     * @brief Boundary test visiting only the edges in grid cells within epsilon of the point.
+     * @param vertices The vertices the index was built from.
+     * @param point The point to check.
+     * @param epsilon The distance tolerance.
+     * @return True if the point is within epsilon of an edge.
+     */
+    bool isOnBoundary(const std::vector<Point2D>& vertices, const Point2D& point, float epsilon) const;
+
+    /**
+     * @brief Gets the build cost and memory of the index.
+     * @return A const reference to the statistics.
+     */
+    const PolygonIndexStats& getStats() const { return stats; }
+
+private:
+/*====================================  Helper Methods  =========================================*/
+
+    int slabOf(double y) const;
+    int cellCol(double x) const;
+    int cellRow(double y) const;
+    void buildSlabs(const PolygonEdges& edges);
+    void buildGrid(const std::vector<Point2D>& vertices);
+};
+
+/**
+ * @brief Holder that builds a PolygonIndex on first use, safely from concurrent readers.
+ * Copies share an already built index; unbuilt copies build their own on demand.
+ */
+class LazyPolygonIndex {
+private:
+    mutable std::atomic<const PolygonIndex*> ready{nullptr}; /// @brief Published index, null until built
+    mutable std::shared_ptr<const PolygonIndex> owned;       /// @brief Ownership of the published index
+    mutable std::mutex buildMutex;                           /// @brief Serializes the one-time build
+
+public:
+    LazyPolygonIndex() = default;
+    LazyPolygonIndex(const LazyPolygonIndex& other);
+    LazyPolygonIndex& operator=(const LazyPolygonIndex& other);
+
+    /**
+     * @brief Gets the index, building it on the first call.
+     * @param vertices The polygon vertices.
+     * @param edges The precomputed edge arrays of the polygon.
+     * @param bounds The bounding box of the polygon.
+     * @return A const reference to the index.
+     */
+    const PolygonIndex& get(const std::vector<Point2D>& vertices, const PolygonEdges& edges, const PolygonBounds& bounds) const;
+
+    /**
+     * @brief Checks whether the index has been built.
+     * @return True once get() has completed at least once.
+     */
+    bool isBuilt() const { return ready.load(std::memory_order_acquire) != nullptr; }
+
+    /**
+     * @brief Drops the index so the next get() rebuilds it, after the polygon has changed.
+     * Must not run concurrently with get().
+     */
+    void reset();
+};
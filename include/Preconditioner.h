@@ -0,0 +1,150 @@
+#pragma once
+#include "MultigridSolver.h"
+#include "PoissonOperator.h"
+#include "SparseMatrix.h"
+#include <span>
+
+/**
+ * @brief enum class selecting the preconditioner of a PcgSolver.
+ * NONE: Plain conjugate gradients.
+ * JACOBI: Inverse of the diagonal.
+ * IC0: Incomplete Cholesky factorization without fill-in.
+ * MULTIGRID: One multigrid cycle from a zero initial guess.
+ */
+enum class PreconditionerType : int8_t {
+    NONE,
+    JACOBI,
+    IC0,
+    MULTIGRID
+};
+
+/**
+ * @brief Approximate inverse M⁻¹ of an SPD matrix, applied once per conjugate gradient iteration.
+ */
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+
+    /**
+     * @brief Computes z = M⁻¹ r.
+     * @param r The residual.
+     * @param z Output vector of the same size.
+     */
+    virtual void apply(std::span<const double> r, std::span<double> z) = 0;
+
+    /**
+     * @brief Computes z = M⁻¹ r and returns r·z.
+     * Preconditioners that can accumulate the dot product while writing z override this to
+     * save the extra pass over both vectors.
+     * @param r The residual.
+     * @param z Output vector of the same size.
+     * @return The dot product of r and z.
+     */
+    virtual double applyDot(std::span<const double> r, std::span<double> z);
+
+    /**
+     * @brief Tells whether M⁻¹ is a fixed symmetric operator.
+     * If not, conjugate gradients switch to the flexible (Polak-Ribiere) update.
+     * @return True if M⁻¹ is symmetric.
+     */
+    virtual bool isSymmetric() const { return true; }
+};
+
+/**
+ * @brief The identity: z = r.
+ */
+class IdentityPreconditioner : public Preconditioner {
+public:
+    void apply(std::span<const double> r, std::span<double> z) override;
+    double applyDot(std::span<const double> r, std::span<double> z) override;
+};
+
+/**
+ * @brief Diagonal scaling z = r / diag(A).
+ */
+class JacobiPreconditioner : public Preconditioner {
+private:
+/*====================================  Attributes  =========================================*/
+
+    AlignedVector<double> invDiag;  /// @brief Inverse diagonal of the operator
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Stores the inverse diagonal of an operator.
+     * @param op The operator.
+     */
+    explicit JacobiPreconditioner(const PoissonOperator& op);
+
+/*====================================  Methods  =========================================*/
+
+    void apply(std::span<const double> r, std::span<double> z) override;
+    double applyDot(std::span<const double> r, std::span<double> z) override;
+};
+
+/**
+ * @brief Incomplete Cholesky factorization A ≈ L Lᵀ with the sparsity of the lower triangle of A.
+ *
+ * L is stored row by row in CSR form with the diagonal last in each row. Applying the
+ * preconditioner is a forward substitution with L followed by a backward substitution with
+ * Lᵀ, which runs over the rows of L in reverse and scatters into earlier entries.
+ */
+class IncompleteCholesky : public Preconditioner {
+private:
+/*====================================  Attributes  =========================================*/
+
+    AlignedVector<int64_t> rowPtr;  /// @brief Start of each row of L
+    AlignedVector<int32_t> colIdx;  /// @brief Column of each entry of L, the diagonal last in each row
+    AlignedVector<double> values;   /// @brief Entries of L
+    AlignedVector<double> invDiag;  /// @brief Inverse diagonal of L
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Factors a symmetric matrix.
+     * @param matrix The matrix; only its lower triangle is read.
+     * @throws std::invalid_argument If a pivot is not positive (the matrix is not an M-matrix
+     *         and the incomplete factorization breaks down).
+     */
+    explicit IncompleteCholesky(const CsrMatrix& matrix);
+
+/*====================================  Methods  =========================================*/
+
+    void apply(std::span<const double> r, std::span<double> z) override;
+    double applyDot(std::span<const double> r, std::span<double> z) override;
+
+private:
+    /**
+     * @brief Solves L Lᵀ z = r, accumulating r·z during the backward substitution.
+     */
+    double solve(std::span<const double> r, std::span<double> z) const;
+};
+
+/**
+ * @brief One multigrid cycle on A z = r from z = 0.
+ * V- and W-cycles smooth symmetrically and are symmetric operators; F-cycles are not.
+ *
+ * @note The preconditioner keeps a reference to the solver, which must outlive it.
+ */
+class MultigridPreconditioner : public Preconditioner {
+private:
+/*====================================  Attributes  =========================================*/
+
+    MultigridSolver& multigrid;  /// @brief The hierarchy whose finest operator is preconditioned
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Wraps a multigrid hierarchy.
+     * @param multigrid_ The hierarchy.
+     */
+    explicit MultigridPreconditioner(MultigridSolver& multigrid_) : multigrid(multigrid_) {}
+
+/*====================================  Methods  =========================================*/
+
+    void apply(std::span<const double> r, std::span<double> z) override;
+    bool isSymmetric() const override { return multigrid.getOptions().cycle != MultigridCycle::F; }
+};
@@ -0,0 +1,158 @@
+#pragma once
+#include "FDMGrid.h"
+#include "Polygon.h"
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+/// @brief Extra refinement criterion: returns true if the square leaf with the given centre and side should be split.
+using RefinementIndicator = std::function<bool(const Point2D& center, float size)>;
+
+/**
+ * @brief enum class naming the four edge neighbours of a quadtree leaf.
+ */
+enum class QuadDirection : int8_t {
+    WEST,
+    EAST,
+    SOUTH,
+    NORTH
+};
+
+/**
+ * @brief Refinement limits of a QuadtreeGrid.
+ */
+struct QuadtreeOptions {
+    int maxDepth = 10;              /// @brief Depth of the finest leaves, 2^maxDepth cells per side (at most 31)
+    int minDepth = 2;               /// @brief Depth every leaf reaches regardless of the polygon
+    bool balance = true;            /// @brief Enforce the 2:1 rule: edge neighbours differ by at most one level
+    RefinementIndicator indicator;  /// @brief Optional criterion for refining leaves away from the boundary
+};
+
+/**
+ * @brief A leaf of a QuadtreeGrid: a square of 4^(maxDepth - depth) finest cells.
+ */
+struct QuadtreeLeaf {
+    uint64_t code;  /// @brief Morton code of the leaf's lower-left finest cell
+    uint8_t depth;  /// @brief Depth of the leaf (0 = the root square)
+    GridType type;  /// @brief Classification of the leaf
+};
+
+/**
+ * @brief Adaptive alternative to FDMGrid that refines only where the polygon passes.
+ *
+ * The domain is the square over the polygon's bounding box, recursively split into quadrants.
+ * A square is split while it is shallower than minDepth, or shallower than maxDepth and either
+ * the polygon passes within its circumcircle (Polygon::isOnBoundary with the half diagonal as
+ * tolerance) or the refinement indicator asks for it. Leaves that the polygon still reaches at
+ * maxDepth are BOUNDARY; the others are INTERIOR or EXTERIOR by Polygon::containsPoint at
+ * their centre.
+ *
+ * The leaves are stored in one array sorted by the Morton (Z-order) code of their lower-left
+ * finest cell, which is the depth-first order of the tree: spatially close leaves are close in
+ * memory, and the leaf covering any finest cell is found by binary search over the codes.
+ */
+class QuadtreeGrid {
+private:
+/*====================================  Attributes  =========================================*/
+
+    float originX, originY;            /// @brief Bottom-left corner of the root square
+    float size;                        /// @brief Side length of the root square
+    int maxDepth;                      /// @brief Depth of the finest leaves
+    std::vector<QuadtreeLeaf> leaves;  /// @brief Leaves sorted by Morton code
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Builds and classifies the tree of a polygon.
+     * @param polygon The polygon defining the interior/exterior regions.
+     * @param options Refinement limits and the optional indicator.
+     * @throws std::invalid_argument If maxDepth is outside [0, 31] or minDepth outside [0, maxDepth].
+     */
+    explicit QuadtreeGrid(const Polygon& polygon, const QuadtreeOptions& options = {});
+
+/*==================================== Getters =========================================*/
+
+    float getOriginX() const { return originX; }
+    float getOriginY() const { return originY; }
+    float getSize() const { return size; }
+    int getMaxDepth() const { return maxDepth; }
+    size_t getLeafCount() const { return leaves.size(); }
+    std::span<const QuadtreeLeaf> getLeaves() const { return leaves; }
+
+    /**
+     * @brief Gets the number of cells of the uniform grid at the finest level.
+     * @return 4^maxDepth.
+     */
+    uint64_t getFinestCellCount() const { return uint64_t{1} << (2 * maxDepth); }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Interleaves the bits of two cell indices, x in the even bits.
+     * @param ix The x index of a finest cell.
+     * @param iy The y index of a finest cell.
+     * @return The Morton code.
+     */
+    static uint64_t encodeMorton(uint32_t ix, uint32_t iy);
+
+    /**
+     * @brief Splits a Morton code into its cell indices.
+     * @param code The Morton code.
+     * @return The pair (ix, iy).
+     */
+    static std::pair<uint32_t, uint32_t> decodeMorton(uint64_t code);
+
+    /**
+     * @brief Gets the side length of a leaf.
+     * @param k The leaf index.
+     * @return The side length in world units.
+     */
+    float leafSize(size_t k) const;
+
+    /**
+     * @brief Gets the centre of a leaf.
+     * @param k The leaf index.
+     * @return The centre in world coordinates.
+     */
+    Point2D leafCenter(size_t k) const;
+
+    /**
+     * @brief Finds the leaf covering a finest cell.
+     * @param ix The x index of the cell, in [0, 2^maxDepth).
+     * @param iy The y index of the cell, in [0, 2^maxDepth).
+     * @return The leaf index, or -1 if the cell is outside the root square.
+     */
+    int64_t findLeaf(int64_t ix, int64_t iy) const;
+
+    /**
+     * @brief Finds the leaf containing a point.
+     * @param point The point in world coordinates.
+     * @return The leaf index, or -1 if the point is outside the root square.
+     */
+    int64_t findLeaf(const Point2D& point) const;
+
+    /**
+     * @brief Finds the edge neighbour of a leaf.
+     * A coarser or equal neighbour is unique; among finer neighbours the one touching the
+     * leaf's lower (WEST, EAST) or left (SOUTH, NORTH) corner is returned.
+     * @param k The leaf index.
+     * @param direction The side of the leaf.
+     * @return The neighbour's index, or -1 at the edge of the root square.
+     */
+    int64_t findNeighbour(size_t k, QuadDirection direction) const;
+
+    /**
+     * @brief Counts the leaves of a type.
+     * @param type The classification.
+     * @return The number of leaves with that classification.
+     */
+    size_t countLeaves(GridType type) const;
+
+private:
+    /**
+     * @brief Splits every leaf whose edge neighbour is more than one level deeper, until none is.
+     */
+    void balance();
+};
@@ -0,0 +1,125 @@
+#pragma once
+#include "FDMGrid.h"
+#include "GridField.h"
+#include "PoissonSolver.h"
+#include "SimdDispatch.h"
+
+/**
+ * @brief Matrix-free red-black Gauss-Seidel / SOR relaxation of -∇²u = f on an FDMGrid.
+ *
+ * The smoother works in place on a GridField over the whole grid and reads the grid's cell
+ * buffer as a mask: INTERIOR cells are relaxed, every other cell keeps its value, so BOUNDARY
+ * cells supply the Dirichlet data. No matrix or index map is built; the memory footprint is
+ * the field, the source and the one-byte classification per node.
+ *
+ * Nodes are colored by the parity of i + j. Each pass updates one color, whose 5-point
+ * neighbours all have the other color, so rows are relaxed in parallel and each row is
+ * processed in full SIMD registers with a masked store of the cells of that color.
+ *
+ * @note The smoother keeps a reference to the grid, which must outlive it. Cells on the
+ * outermost grid lines lie on the polygon's bounding box and are never interior.
+ */
+class RedBlackSmoother {
+private:
+/*====================================  Attributes  =========================================*/
+
+    using RowKernel = void (*)(const struct RelaxRow&, const struct RelaxCoefficients&);
+
+    const FDMGrid& grid;  /// @brief The grid whose classification masks the update
+    double omega;         /// @brief Relaxation factor (1 = Gauss-Seidel, 1 < omega < 2 = over-relaxation)
+    SimdLevel simdLevel;  /// @brief Widest instruction set the row kernel may use
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Constructs a smoother for a grid.
+     * @param grid_ The classified grid.
+     * @param omega_ Relaxation factor (default = 1, Gauss-Seidel).
+     * @param level Widest SIMD instruction set to use; clamped to what the CPU supports.
+     * @throws std::invalid_argument If omega is not in (0, 2).
+     */
+    explicit RedBlackSmoother(const FDMGrid& grid_, double omega_ = 1.0, SimdLevel level = SimdLevel::AVX512);
+
+/*==================================== Getters =========================================*/
+
+    const FDMGrid& getGrid() const { return grid; }
+    double getOmega() const { return omega; }
+    SimdLevel getSimdLevel() const { return simdLevel; }
+
+/*==================================== Setters =========================================*/
+
+    void setOmega(double omega_);
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Estimates the optimal SOR factor 2 / (1 + sin(pi h)) of the grid's bounding box.
+     * @param grid The grid.
+     * @return The relaxation factor.
+     */
+    static double optimalOmega(const FDMGrid& grid);
+
+    /**
+     * @brief Samples a function at every node of the grid.
+     * @param grid The grid.
+     * @param function The function.
+     * @param type If not UNDEFINED, only cells of this type are sampled and the rest are 0.
+     * @return The sampled field.
+     */
+    static GridField sample(const FDMGrid& grid, const ScalarFunction& function, GridType type = UNDEFINED);
+
+    /**
+     * @brief Relaxes all interior cells of one color.
+     * @param u The field, updated in place. BOUNDARY cells must hold the Dirichlet data.
+     * @param f The source term.
+     * @param color 0 for cells with i + j even (red), 1 for odd (black).
+     */
+    void relaxColor(GridField& u, const GridField& f, int color) const;
+
+    /**
+     * @brief Performs red-then-black sweeps.
+     * Each sweep makes a single pass over memory: the black cells of a row are relaxed as soon
+     * as the red cells of the row above are done. The result is identical to a red pass
+     * followed by a black pass.
+     * @param u The field, updated in place.
+     * @param f The source term.
+     * @param count Number of sweeps (default = 1).
+     */
+    void sweep(GridField& u, const GridField& f, int count = 1) const;
+
+    /**
+     * @brief Computes the 2-norm of f + ∇²u over the interior cells.
+     * @param u The field.
+     * @param f The source term.
+     * @return The residual norm.
+     */
+    double residualNorm(const GridField& u, const GridField& f) const;
+
+    /**
+     * @brief Solves -∇²u = f with u = g on the boundary by red-black SOR sweeps.
+     * The residual is checked every 10 sweeps, so iterations is a multiple of 10 unless the
+     * limit is reached first.
+     * @param source The source term f.
+     * @param boundaryValue The Dirichlet data g.
+     * @param options Stopping criteria; iterations count sweeps.
+     * @return The solution field and convergence information.
+     */
+    SolveResult solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& options = {}) const;
+
+private:
+    /**
+     * @brief Selects the row kernel of the SIMD level.
+     */
+    RowKernel rowKernel() const;
+
+    /**
+     * @brief Relaxes the cells of one color in one row.
+     * @param u The field, updated in place.
+     * @param f The source term.
+     * @param j The y index of the row, 1 <= j < ny - 1.
+     * @param color 0 for red, 1 for black.
+     * @param kernel The row kernel.
+     */
+    void relaxRow(GridField& u, const GridField& f, int j, int color, RowKernel kernel) const;
+};
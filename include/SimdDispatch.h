@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief enum class representing the widest SIMD instruction set a kernel may use.
+ * SCALAR: Portable C++ only.
+ * AVX2: 256-bit AVX2 kernels (x86-64).
+ * AVX512: 512-bit AVX-512F/BW/VL kernels (x86-64).
+ */
+enum class SimdLevel : int8_t {
+    SCALAR = 0,
+    AVX2 = 1,
+    AVX512 = 2
+};
+
+/**
+ * @brief Detects the widest SIMD level supported by both the CPU and this build.
+ * The result is computed once and cached.
+ * @return The detected SIMD level.
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief Clamps a requested SIMD level to what is actually available.
+ * @param requested The preferred level.
+ * @return The lower of the requested and the detected level.
+ */
+SimdLevel resolveSimdLevel(SimdLevel requested);
@@ -0,0 +1,179 @@
+#pragma once
+#include "AlignedAllocator.h"
+#include "FDMGrid.h"
+#include "GridField.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Counters of a SnapshotWriter; the stall figures show how far I/O falls behind the solver.
+ */
+struct SnapshotStats {
+    uint64_t submitted = 0;         /// @brief Snapshots handed to submit()
+    uint64_t written = 0;           /// @brief Snapshots on disk
+    uint64_t stalls = 0;            /// @brief Submits that found every buffer busy and waited
+    uint64_t maxPending = 0;        /// @brief Most snapshots queued or being written at once
+    uint64_t bytesWritten = 0;      /// @brief Bytes of snapshot files written
+    uint64_t seriesWrites = 0;      /// @brief Entries added to the collection file
+    uint64_t seriesBytesWritten = 0; /// @brief Bytes written to the collection file
+    double stallMilliseconds = 0;   /// @brief Solver time spent waiting for a free buffer
+    double copyMilliseconds = 0;    /// @brief Solver time spent copying fields into buffers
+    double writeMilliseconds = 0;   /// @brief Background time spent writing snapshot files
+    double seriesMilliseconds = 0;  /// @brief Background time spent adding to the collection file
+};
+
+/**
+ * @brief Asynchronous writer of field snapshots as a ParaView time series.
+ *
+ * Every snapshot is cropped to the bounding box of the INTERIOR and BOUNDARY cells of the grid,
+ * with EXTERIOR nodes inside the box set to NaN, and written as a VTK XML image file
+ * (name_NNNNNN.vti, raw appended float64 data) in the output directory. Each file is added to
+ * the collection name.pvd once it is complete: the new entry and the closing tags overwrite the
+ * old closing tags at the end of the file, so an entry costs O(1) bytes however long the run,
+ * and the collection opens in ParaView while the run is still going. A reader that catches the
+ * few bytes of the tail mid-write sees an unterminated file and can simply reopen it. The time
+ * and bytes of the collection are counted apart from the snapshot files.
+ *
+ * submit() copies the field into one of a fixed set of buffers and returns; a background
+ * thread writes the buffers in order. With two buffers the solver fills one while the other is
+ * written; when both are busy, submit() waits and the wait is counted as a stall.
+ *
+ * @note The writer keeps a reference to the grid, which must outlive it. The cropped box is
+ *       fixed at construction; the EXTERIOR mask is read from the grid at every submit().
+ */
+class SnapshotWriter {
+private:
+/*====================================  Attributes  =========================================*/
+
+    /// @brief A buffer and the snapshot it holds
+    struct Snapshot {
+        AlignedVector<double> values;  /// @brief Cropped node values, row-major over the box
+        double time = 0;               /// @brief Simulation time
+        uint64_t index = 0;            /// @brief Sequence number, used in the file name
+    };
+
+    const FDMGrid& grid;                   /// @brief The grid whose classification crops the fields
+    std::string directory;                 /// @brief Output directory
+    std::string name;                      /// @brief Field name and file name prefix
+    CellBox box;                           /// @brief Bounding box of the INTERIOR and BOUNDARY cells
+    std::vector<Snapshot> buffers;         /// @brief Snapshot buffers
+    std::vector<Snapshot*> available;      /// @brief Buffers free to fill
+    std::deque<Snapshot*> pending;         /// @brief Buffers queued or being written, oldest first
+    std::ofstream series;                  /// @brief The collection file, opened at the first entry; background thread only
+    std::streamoff seriesTail = 0;         /// @brief Offset of the closing tags in series, overwritten by the next entry
+    SnapshotStats stats;                   /// @brief Counters, guarded by mutex
+    std::exception_ptr error;              /// @brief First error of the background thread
+    bool listing = false;                  /// @brief Set while a written snapshot is added to the collection
+    bool closing = false;                  /// @brief Set by close()
+    mutable std::mutex mutex;              /// @brief Guards the buffer lists, stats, error, listing and closing
+    std::condition_variable bufferFreed;   /// @brief Signals a buffer returned to available or a snapshot listed
+    std::condition_variable snapshotQueued; /// @brief Signals a new snapshot or closing
+    std::thread thread;                    /// @brief The background writer
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Starts a writer.
+     * @param grid_ The classified grid the fields live on.
+     * @param directory_ Existing output directory.
+     * @param name_ Field name in the files, also their name prefix (default = "u").
+     * @param bufferCount Number of snapshot buffers, at least 1 (default = 2).
+     * @throws std::invalid_argument If the name is empty, bufferCount is below 1, or the grid has
+     *         no INTERIOR or BOUNDARY cell.
+     * @throws std::runtime_error If the directory does not exist.
+     */
+    SnapshotWriter(const FDMGrid& grid_, const std::string& directory_, const std::string& name_ = "u", int bufferCount = 2);
+
+    /**
+     * @brief Writes the queued snapshots and stops the background thread; errors are dropped.
+     */
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+/*==================================== Getters =========================================*/
+
+    const CellBox& getBox() const { return box; }
+    int getBufferCount() const { return static_cast<int>(buffers.size()); }
+
+    /**
+     * @brief Gets the path of the collection file ParaView opens.
+     * @return directory/name.pvd.
+     */
+    std::string getSeriesPath() const;
+
+    /**
+     * @brief Gets the counters.
+     * @return A consistent copy of the counters so far.
+     */
+    SnapshotStats getStats() const;
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Queues a snapshot, waiting for a free buffer if the background thread is behind.
+     * @param u The field, on the grid's nodes.
+     * @param time The simulation time of the snapshot.
+     * @throws std::invalid_argument If the field does not match the grid.
+     * @throws std::logic_error If the writer is closed.
+     * @throws Rethrows the first error of the background thread.
+     */
+    void submit(const GridField& u, double time);
+
+    /**
+     * @brief Waits until every queued snapshot is on disk and listed in the collection file.
+     * @throws Rethrows the first error of the background thread.
+     */
+    void flush();
+
+    /**
+     * @brief Writes the queued snapshots, then stops the background thread and closes the
+     * collection file; later calls do nothing.
+     * @throws Rethrows the first error of the background thread.
+     */
+    void close();
+
+private:
+/*====================================  Helper Methods  =========================================*/
+
+    /**
+     * @brief Background loop: writes and lists pending snapshots until closing and nothing is left.
+     */
+    void writerLoop();
+
+    /**
+     * @brief Gets the file name of a snapshot.
+     * @param index The snapshot's sequence number.
+     * @return name_NNNNNN.vti, relative to the output directory.
+     */
+    std::string snapshotFile(uint64_t index) const;
+
+    /**
+     * @brief Writes one snapshot file.
+     * @param snapshot The snapshot.
+     * @return Bytes written.
+     */
+    uint64_t writeSnapshot(const Snapshot& snapshot);
+
+    /**
+     * @brief Adds a written snapshot to the collection file, creating the file at the first entry.
+     * @param time The simulation time of the snapshot.
+     * @param file The snapshot's file name.
+     * @return Bytes written.
+     */
+    uint64_t appendSeries(double time, const std::string& file);
+
+    /**
+     * @brief Stops the background thread after the queued snapshots are written.
+     */
+    void stop();
+};
@@ -0,0 +1,171 @@
+#pragma once
+#include "AlignedAllocator.h"
+#include "PoissonOperator.h"
+#include "SimdDispatch.h"
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Square sparse matrix in compressed sparse row (CSR) format.
+ *
+ * Row k stores its nonzeros in columns colIdx[rowPtr[k]], ..., colIdx[rowPtr[k + 1] - 1],
+ * sorted by column. Rows are the unknowns of an InteriorIndexMap when the matrix is assembled
+ * from a PoissonOperator, so only INTERIOR cells have a row and Dirichlet neighbours do not
+ * appear as entries.
+ */
+class CsrMatrix {
+private:
+/*====================================  Attributes  =========================================*/
+
+    int32_t rows;                     /// @brief Number of rows (and columns)
+    AlignedVector<int64_t> rowPtr;    /// @brief Start of each row in colIdx and values (rows + 1 entries)
+    AlignedVector<int32_t> colIdx;    /// @brief Column of each nonzero
+    AlignedVector<double> values;     /// @brief Value of each nonzero
+    unsigned numThreads;              /// @brief Threads used by multiply (0 = hardware concurrency)
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Assembles the matrix of a 5-point operator.
+     * Entries with zero weight (Dirichlet neighbours) are dropped.
+     * @param op The operator. Its grid's thread count is used for multiply.
+     */
+    explicit CsrMatrix(const PoissonOperator& op);
+
+    /**
+     * @brief Constructs a matrix from raw CSR arrays.
+     * @param rows_ Number of rows.
+     * @param rowPtr_ Start of each row, rows_ + 1 non-decreasing entries from 0 to the nonzero count.
+     * @param colIdx_ Column of each nonzero, sorted within each row.
+     * @param values_ Value of each nonzero.
+     * @param numThreads_ Threads used by multiply (default = 0, all cores).
+     * @throws std::invalid_argument If the arrays are inconsistent or a column is out of range.
+     */
+    CsrMatrix(int32_t rows_, AlignedVector<int64_t> rowPtr_, AlignedVector<int32_t> colIdx_,
+        AlignedVector<double> values_, unsigned numThreads_ = 0);
+
+/*==================================== Getters =========================================*/
+
+    int32_t getRowCount() const { return rows; }
+    int64_t getNonzeroCount() const { return rowPtr[rows]; }
+    std::span<const int64_t> getRowPointers() const { return rowPtr; }
+    std::span<const int32_t> getColumnIndices() const { return colIdx; }
+    std::span<const double> getValues() const { return values; }
+    unsigned getNumThreads() const { return numThreads; }
+
+    /**
+     * @brief Gets the columns of one row.
+     * @param k The row.
+     * @return The sorted column indices of the row's nonzeros.
+     */
+    std::span<const int32_t> getRowColumns(int32_t k) const {
+        return std::span<const int32_t>(colIdx).subspan(rowPtr[k], rowPtr[k + 1] - rowPtr[k]);
+    }
+
+    /**
+     * @brief Gets the values of one row.
+     * @param k The row.
+     * @return The row's nonzeros, in the order of getRowColumns(k).
+     */
+    std::span<const double> getRowValues(int32_t k) const {
+        return std::span<const double>(values).subspan(rowPtr[k], rowPtr[k + 1] - rowPtr[k]);
+    }
+
+/*==================================== Setters =========================================*/
+
+    void setNumThreads(unsigned numThreads_) { numThreads = numThreads_; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Computes y = A x, rows split over threads.
+     * Each row is summed from 0 in column order, so the result does not depend on the thread count.
+     * @param x Input vector with one entry per column.
+     * @param y Output vector with one entry per row.
+     */
+    void multiply(std::span<const double> x, std::span<double> y) const;
+};
+
+/**
+ * @brief Square sparse matrix in SELL-C-σ format, built from a CsrMatrix.
+ *
+ * Rows are grouped into chunks of C consecutive slots. Each chunk is padded to the length of
+ * its longest row and stored column-major, so entry k of the C rows of a chunk is contiguous
+ * and a SIMD register processes C / width rows at once. Within windows of σ rows the rows are
+ * sorted by decreasing length before chunking, which keeps the padding small when row lengths
+ * vary (rows next to the boundary have fewer neighbours); the permutation is undone when y is
+ * written. Padding entries are zero and point at a column of their own row.
+ *
+ * Every row is summed in the same order as in the CsrMatrix, and the kernels are built without
+ * FMA contraction, so the product is bitwise identical to CsrMatrix::multiply at every SIMD level.
+ */
+class SellMatrix {
+private:
+/*====================================  Attributes  =========================================*/
+
+    using ChunkKernel = void (*)(const struct SellChunk&, const double*, double*);
+
+    int32_t rows;                      /// @brief Number of rows (and columns)
+    int chunkHeight;                   /// @brief Rows per chunk (C)
+    int sortWindow;                    /// @brief Rows per sorting window (σ)
+    AlignedVector<int64_t> chunkPtr;   /// @brief Start of each chunk in colIdx and values (chunks + 1 entries)
+    AlignedVector<int32_t> chunkWidth; /// @brief Padded row length of each chunk
+    AlignedVector<int32_t> rowOrder;   /// @brief Original row of each slot (chunks * C entries, -1 for padding slots)
+    AlignedVector<int32_t> colIdx;     /// @brief Column of each stored entry, column-major per chunk
+    AlignedVector<double> values;      /// @brief Value of each stored entry, column-major per chunk
+    int64_t nonzeros;                  /// @brief Nonzeros of the source matrix, without padding
+    unsigned numThreads;               /// @brief Threads used by multiply (0 = hardware concurrency)
+    SimdLevel simdLevel;               /// @brief Widest instruction set the chunk kernel may use
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Converts a CSR matrix.
+     * @param csr The source matrix. Its thread count is used for multiply.
+     * @param chunkHeight_ Rows per chunk C; a power of two, at most 64 (default = 8, one AVX-512 register).
+     * @param sortWindow_ Rows per sorting window σ; a multiple of C, or 1 to keep the row order (default = 256).
+     * @param level Widest SIMD instruction set to use; clamped to what the CPU supports.
+     * @throws std::invalid_argument If C or σ is invalid.
+     */
+    explicit SellMatrix(const CsrMatrix& csr, int chunkHeight_ = 8, int sortWindow_ = 256, SimdLevel level = SimdLevel::AVX512);
+
+/*==================================== Getters =========================================*/
+
+    int32_t getRowCount() const { return rows; }
+    int getChunkHeight() const { return chunkHeight; }
+    int getSortWindow() const { return sortWindow; }
+    int32_t getChunkCount() const { return static_cast<int32_t>(chunkWidth.size()); }
+    int64_t getNonzeroCount() const { return nonzeros; }
+    int64_t getStoredCount() const { return static_cast<int64_t>(values.size()); }
+    unsigned getNumThreads() const { return numThreads; }
+    SimdLevel getSimdLevel() const { return simdLevel; }
+
+    /**
+     * @brief Gets the fraction of stored entries that are padding.
+     * @return 1 - nonzeros / stored entries.
+     */
+    double getPaddingRatio() const {
+        return values.empty() ? 0.0 : 1.0 - static_cast<double>(nonzeros) / static_cast<double>(values.size());
+    }
+
+/*==================================== Setters =========================================*/
+
+    void setNumThreads(unsigned numThreads_) { numThreads = numThreads_; }
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Computes y = A x, chunks split over threads.
+     * @param x Input vector with one entry per column.
+     * @param y Output vector with one entry per row.
+     */
+    void multiply(std::span<const double> x, std::span<double> y) const;
+
+private:
+    /**
+     * @brief Selects the chunk kernel of the SIMD level and chunk height.
+     */
+    ChunkKernel chunkKernel() const;
+};
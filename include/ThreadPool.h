@@ -0,0 +1,216 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief enum class selecting how the workers of a ThreadPool are pinned to CPUs.
+ * NONE: The operating system places the workers.
+ * COMPACT: Workers fill the CPUs of one NUMA node before moving to the next.
+ * SCATTER: Workers alternate between NUMA nodes, spreading memory bandwidth.
+ */
+enum class ThreadPinning : int8_t {
+    NONE,
+    COMPACT,
+    SCATTER
+};
+
+/**
+ * @brief Size and placement of a ThreadPool.
+ */
+struct ThreadPoolOptions {
+    unsigned workers = 0;                      /// @brief Worker threads (0 = hardware concurrency - 1, the caller being the last)
+    ThreadPinning pinning = ThreadPinning::NONE; /// @brief CPU pinning of the workers
+};
+
+/**
+ * @brief Scheduler counters of a ThreadPool, summed over its threads.
+ */
+struct SchedulerStats {
+    uint64_t jobs = 0;            /// @brief Parallel loops run through the pool
+    uint64_t tasks = 0;           /// @brief Tiles executed
+    uint64_t steals = 0;          /// @brief Tiles taken from another thread's deque
+    double idleMilliseconds = 0;  /// @brief Time workers spent asleep waiting for tiles
+};
+
+/**
+ * @brief Work-stealing thread pool shared by the grid and solver kernels.
+ *
+ * Each worker owns a deque of tiles. A parallel loop cuts its range into tiles, deals them out
+ * in contiguous groups to the deques of the threads taking part (the calling thread included),
+ * and every thread runs its own tiles from the front, in order. A thread that runs out steals
+ * from the back of another deque, taking the tiles its owner would reach last. Threads that are
+ * not workers share one extra deque for their own tiles. The calling thread helps until every
+ * tile of its loop has run, so loops may nest.
+ *
+ * A loop never runs on more threads than it asks for, whichever threads pick up its tiles.
+ */
+class ThreadPool {
+private:
+/*====================================  Attributes  =========================================*/
+
+    /// @brief One parallel loop: a type-erased body over [begin, end) cut into tiles
+    struct Job {
+        void (*invoke)(const void* body, int first, int last);  /// @brief Calls the body on one range
+        const void* body;                                       /// @brief The caller's callable
+        int begin;                                              /// @brief First index of the range
+        int end;                                                /// @brief One past the last index of the range
+        int tileSize;                                           /// @brief Iterations per tile
+        int tiles;                                              /// @brief Number of tiles
+        int maxThreads;                                         /// @brief Threads allowed to run tiles at once
+        std::atomic<int> running{0};                            /// @brief Threads running a tile now
+        std::atomic<int> remaining{0};                          /// @brief Tiles not finished yet
+        std::mutex errorMutex;                                  /// @brief Guards error
+        std::exception_ptr error;                               /// @brief First exception thrown by a tile
+    };
+
+    /// @brief One tile of a job
+    struct Task {
+        Job* job;
+        int tile;
+    };
+
+    /// @brief Deque and counters of one thread slot, on its own cache lines
+    struct alignas(64) Slot {
+        std::mutex mutex;                      /// @brief Guards tasks
+        std::deque<Task> tasks;                /// @brief Own tiles at the front, stolen from the back
+        std::atomic<uint64_t> executed{0};     /// @brief Tiles run by this slot's thread(s)
+        std::atomic<uint64_t> stolen{0};       /// @brief Tiles this slot's thread(s) stole
+        std::atomic<uint64_t> idleNanoseconds{0}; /// @brief Time asleep
+    };
+
+    std::vector<std::unique_ptr<Slot>> slots;  /// @brief One slot per worker, then the shared slot of outside threads
+    std::vector<std::thread> threads;          /// @brief The workers
+    std::atomic<int64_t> queued{0};            /// @brief Tiles waiting in any deque
+    std::atomic<uint64_t> jobs{0};             /// @brief Loops run through the pool
+    std::atomic<uint64_t> epoch{0};            /// @brief Incremented whenever tiles are dealt out
+    std::mutex sleepMutex;                     /// @brief Guards sleeping and stopping
+    std::condition_variable wake;              /// @brief Signals new tiles and shutdown
+    bool stopping = false;                     /// @brief Set by the destructor
+    ThreadPinning pinning;                     /// @brief Placement of the workers
+
+public:
+/*====================================  Constructor  =========================================*/
+
+    /**
+     * @brief Starts the workers.
+     * @param options Worker count and pinning.
+     */
+    explicit ThreadPool(const ThreadPoolOptions& options = {});
+
+    /**
+     * @brief Stops and joins the workers; no loop may be running.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Gets the pool shared by all kernels, creating it on first use.
+     * @return The shared pool.
+     */
+    static ThreadPool& global();
+
+    /**
+     * @brief Sets the size and pinning of the shared pool.
+     * @param options Worker count and pinning.
+     * @throws std::logic_error If the shared pool has already been created.
+     */
+    static void configureGlobal(const ThreadPoolOptions& options);
+
+/*==================================== Getters =========================================*/
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(threads.size()); }
+    ThreadPinning getPinning() const { return pinning; }
+
+    /**
+     * @brief Gets the scheduler counters summed over all threads.
+     * @return The counters since construction or the last resetStats().
+     */
+    SchedulerStats getStats() const;
+
+    /**
+     * @brief Gets the scheduler counters of one worker.
+     * @param worker The worker index; getWorkerCount() selects the threads outside the pool.
+     * @return The worker's counters (jobs is left 0).
+     */
+    SchedulerStats getWorkerStats(unsigned worker) const;
+
+/*==================================== Setters =========================================*/
+
+    void resetStats();
+
+/*====================================  Methods  =========================================*/
+
+    /**
+     * @brief Runs body(first, last) over tiles of [begin, end) on the pool.
+     * @param begin First index of the range.
+     * @param end One past the last index of the range.
+     * @param tileSize Iterations per tile (the last tile may be shorter).
+     * @param numThreads Maximum number of threads; 0 selects the hardware concurrency.
+     * @param body Callable invoked as body(int first, int last) once per tile; tile t covers
+     *        [begin + t * tileSize, min(end, begin + (t + 1) * tileSize)).
+     * @throws Rethrows the first exception thrown by the body, after every tile has finished.
+     */
+    template <typename Body>
+    void run(int begin, int end, int tileSize, unsigned numThreads, const Body& body) {
+        Job job;
+        job.invoke = [](const void* b, int first, int last) { (*static_cast<const Body*>(b))(first, last); };
+        job.body = &body;
+        job.begin = begin;
+        job.end = end;
+        job.tileSize = tileSize;
+        job.tiles = end > begin ? (end - begin + tileSize - 1) / tileSize : 0;
+        submit(job, numThreads);
+    }
+
+    /**
+     * @brief Gets the index of the calling thread's worker.
+     * @return The worker index, or -1 on a thread outside every pool.
+     */
+    static int currentWorker();
+
+private:
+    /**
+     * @brief Deals out the tiles of a job and helps until all of them have run.
+     */
+    void submit(Job& job, unsigned numThreads);
+
+    /**
+     * @brief Runs one tile of a job and releases the job's thread count.
+     */
+    void execute(const Task& task);
+
+    /**
+     * @brief Runs one tile from the thread's own deque or stolen from another.
+     * @param own The slot of the calling thread.
+     * @return True if a tile was run.
+     */
+    bool runOne(size_t own);
+
+    /**
+     * @brief Takes a tile whose job still admits another thread.
+     * @param slot The deque to take from.
+     * @param front True to take from the front (own tiles), false from the back (stealing).
+     * @param task Output task.
+     * @return True if a task was taken; the job's running count then includes the caller.
+     */
+    bool take(Slot& slot, bool front, Task& task);
+
+    /**
+     * @brief Loop of one worker thread.
+     */
+    void workerLoop(unsigned index);
+
+    /**
+     * @brief Pins a worker according to the pinning mode; no-op where unsupported.
+     */
+    void pin(unsigned index);
+};
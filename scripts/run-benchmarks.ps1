@@ -0,0 +1,4 @@
+$Build="build"
+
+cmake -S . -B $Build -DCMAKE_BUILD_TYPE=Release
+cmake --build $Build --config Release --target PDE_SOLVER_BENCH_JSON
@@ -0,0 +1,95 @@
+#include "Communicator.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+SharedMemoryWorld::SharedMemoryWorld(int size_) : size(size_) {
+    if (size < 1) {
+        throw std::invalid_argument("A shared-memory world needs at least one rank");
+    }
+    contributions.assign(size, 0.0);
+}
+
+void SharedMemoryWorld::run(const std::function<void(Communicator&)>& body) {
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+
+    auto runRank = [&](int rank) {
+        SharedMemoryCommunicator communicator(*this, rank);
+        try {
+            body(communicator);
+        }
+        catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) failure = std::current_exception();
+            }
+            abort();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(size - 1);
+    for (int rank = 1; rank < size; rank++) workers.emplace_back(runRank, rank);
+    runRank(0);
+    for (std::thread& worker : workers) worker.join();
+
+    // Leave the world reusable for another run
+    mailboxes.clear();
+    arrived = 0;
+    aborted = false;
+    if (failure) std::rethrow_exception(failure);
+}
+
+void SharedMemoryWorld::abort() {
+    std::lock_guard<std::mutex> lock(mutex);
+    aborted = true;
+    ready.notify_all();
+}
+
+void SharedMemoryCommunicator::sendReceive(int dest, std::span<const double> sendData, int source,
+    std::span<double> receiveData, int tag) {
+    std::unique_lock<std::mutex> lock(world.mutex);
+    if (dest >= 0) {
+        world.mailboxes[{rank, dest, tag}].emplace_back(sendData.begin(), sendData.end());
+        world.ready.notify_all();
+    }
+    if (source < 0) return;
+
+    std::deque<std::vector<double>>& mailbox = world.mailboxes[{source, rank, tag}];
+    world.ready.wait(lock, [&] { return !mailbox.empty() || world.aborted; });
+    if (mailbox.empty()) {
+        throw std::runtime_error("Another rank failed while this one was waiting for a message");
+    }
+    const std::vector<double>& message = mailbox.front();
+    if (message.size() != receiveData.size()) {
+        throw std::runtime_error("Received message size does not match the receive buffer");
+    }
+    std::copy(message.begin(), message.end(), receiveData.begin());
+    mailbox.pop_front();
+}
+
+double SharedMemoryCommunicator::allreduceSum(double value) {
+    std::unique_lock<std::mutex> lock(world.mutex);
+    world.contributions[rank] = value;
+    const uint64_t generation = world.generation;
+    if (++world.arrived == world.size) {
+        // The last rank to arrive adds in rank order, so the sum does not depend on arrival order
+        double sum = 0.0;
+        for (double contribution : world.contributions) sum += contribution;
+        world.reduced = sum;
+        world.arrived = 0;
+        world.generation++;
+        world.ready.notify_all();
+        return sum;
+    }
+    world.ready.wait(lock, [&] { return world.generation != generation || world.aborted; });
+    if (world.generation == generation) {
+        throw std::runtime_error("Another rank failed while this one was waiting in a reduction");
+    }
+    return world.reduced;
+}
+
+void SharedMemoryCommunicator::barrier() {
+    allreduceSum(0.0);
+}
@@ -0,0 +1,161 @@
+#include "DistributedPoissonSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    constexpr int gatherTag = 4;
+
+    const Subdomain& checkedSubdomain(const DomainDecomposition& decomposition, const Communicator& comm) {
+        if (decomposition.getRankCount() != comm.getSize()) {
+            throw std::invalid_argument("The decomposition needs one subdomain per rank");
+        }
+        return decomposition.getSubdomain(comm.getRank());
+    }
+
+    // The block with its ghost layer and the reach of its arms, clipped to the grid
+    CellBox windowOf(const Subdomain& s, const DomainDecomposition& decomposition) {
+        constexpr int margin = 1 + FDMGrid::armReach;
+        return {std::max(0, s.iBegin - margin), std::min(decomposition.getNx(), s.iEnd + margin),
+            std::max(0, s.jBegin - margin), std::min(decomposition.getNy(), s.jEnd + margin)};
+    }
+}
+
+DistributedPoissonSolver::DistributedPoissonSolver(Polygon& polygon, const DomainDecomposition& decomposition_,
+    Communicator& comm_, BoundaryStencil stencil, unsigned numThreads)
+    : decomposition(decomposition_), comm(comm_), halo(checkedSubdomain(decomposition_, comm_), comm_),
+      grid(decomposition_.getNx(), decomposition_.getNy(), polygon, windowOf(halo.getSubdomain(), decomposition_), numThreads) {
+    const Subdomain& s = halo.getSubdomain();
+    const CellBox window = windowOf(s, decomposition);
+    iBlock = s.iBegin - window.iBegin;
+    jBlock = s.jBegin - window.jBegin;
+    cx = 1.0 / (static_cast<double>(grid.getDx()) * grid.getDx());
+    cy = 1.0 / (static_cast<double>(grid.getDy()) * grid.getDy());
+
+    for (int lj = 0; lj < s.getHeight(); lj++) {
+        for (int li = 0; li < s.getWidth(); li++) {
+            const int i = iBlock + li, j = jBlock + lj;
+            if (grid.getCellType(i, j) != INTERIOR) continue;
+            const int32_t k = static_cast<int32_t>(cells.size());
+            cells.push_back(halo.localIndex(li, lj));
+            diag.push_back(2.0 * cx + 2.0 * cy);
+
+            // Non-interior neighbours become Dirichlet terms, exactly as in PoissonOperator
+            const BoundaryArms arms = stencil == BoundaryStencil::SHORTLEY_WELLER ? grid.getBoundaryArms(i, j) : BoundaryArms{};
+            const struct { int di, dj; double weight; float arm; } directions[] = {
+                {-1, 0, cx, arms.west}, {1, 0, cx, arms.east}, {0, -1, cy, arms.south}, {0, 1, cy, arms.north}};
+            for (const auto& d : directions) {
+                if (grid.getCellType(i + d.di, j + d.dj) == INTERIOR) continue;
+                couplings.push_back(PoissonOperator::dirichletCoupling(grid, stencil, k, i, j, d.di, d.dj, d.weight, d.arm));
+                diag[k] += couplings.back().weight - d.weight;
+            }
+        }
+    }
+    globalUnknowns = static_cast<int64_t>(comm.allreduceSum(static_cast<double>(cells.size())));
+}
+
+double DistributedPoissonSolver::applyDot(std::span<double> x, std::span<double> y) {
+    halo.exchange(x);
+    const ptrdiff_t stride = halo.getStride();
+    double sum = 0.0;
+    for (size_t k = 0; k < cells.size(); k++) {
+        const size_t c = cells[k];
+        const double value = diag[k] * x[c] - cx * (x[c - 1] + x[c + 1]) - cy * (x[c - stride] + x[c + stride]);
+        y[c] = value;
+        sum += x[c] * value;
+    }
+    return comm.allreduceSum(sum);
+}
+
+SolveResult DistributedPoissonSolver::solve(const ScalarFunction& source, const ScalarFunction& boundaryValue,
+    const SolverOptions& options) {
+    const Subdomain& s = halo.getSubdomain();
+    const size_t n = cells.size();
+    const size_t localSize = halo.getLocalSize();
+
+    AlignedVector<double> b(n);
+    for (size_t k = 0; k < n; k++) {
+        const size_t c = cells[k];
+        const int li = static_cast<int>(c % halo.getStride()) - 1, lj = static_cast<int>(c / halo.getStride()) - 1;
+        b[k] = source(grid.indexToPoint(iBlock + li, jBlock + lj));
+    }
+    for (const BoundaryCoupling& coupling : couplings) {
+        b[coupling.unknown] += coupling.weight * boundaryValue(coupling.location);
+    }
+
+    // x and r live on the unknowns only; p and Ap are local fields so p's ghost layer can be exchanged
+    AlignedVector<double> x(n, 0.0), r(b), p(localSize, 0.0), ap(localSize, 0.0);
+    for (size_t k = 0; k < n; k++) p[cells[k]] = r[k];
+
+    double bb = 0.0;
+    for (size_t k = 0; k < n; k++) bb += b[k] * b[k];
+    const double bNorm = std::sqrt(comm.allreduceSum(bb));
+    const double scale = bNorm > 0.0 ? 1.0 / bNorm : 1.0;
+    double rr = bNorm * bNorm;
+
+    SolveResult result;
+    while (std::sqrt(rr) * scale > options.tolerance && result.iterations < options.maxIterations) {
+        const double alpha = rr / applyDot(p, ap);
+        double rrLocal = 0.0;
+        for (size_t k = 0; k < n; k++) {
+            x[k] += alpha * p[cells[k]];
+            r[k] -= alpha * ap[cells[k]];
+            rrLocal += r[k] * r[k];
+        }
+        const double rrNext = comm.allreduceSum(rrLocal);
+        const double beta = rrNext / rr;
+        for (size_t k = 0; k < n; k++) p[cells[k]] = r[k] + beta * p[cells[k]];
+        rr = rrNext;
+        result.iterations++;
+    }
+    result.residualNorm = std::sqrt(rr) * scale;
+    result.converged = result.residualNorm <= options.tolerance;
+
+    // Local field: unknowns, Dirichlet values on the owned BOUNDARY nodes, zero elsewhere
+    solution.assign(localSize, 0.0);
+    for (int lj = 0; lj < s.getHeight(); lj++) {
+        for (int li = 0; li < s.getWidth(); li++) {
+            if (grid.getCellType(iBlock + li, jBlock + lj) == BOUNDARY) {
+                solution[halo.localIndex(li, lj)] = boundaryValue(grid.indexToPoint(iBlock + li, jBlock + lj));
+            }
+        }
+    }
+    for (size_t k = 0; k < n; k++) solution[cells[k]] = x[k];
+    return result;
+}
+
+GridField DistributedPoissonSolver::gather(std::span<const double> local, int root) {
+    const Subdomain& own = halo.getSubdomain();
+    auto pack = [this](const Subdomain& s, std::span<const double> field, std::vector<double>& block) {
+        block.resize(static_cast<size_t>(s.getWidth()) * s.getHeight());
+        for (int lj = 0; lj < s.getHeight(); lj++) {
+            const size_t start = halo.localIndex(0, lj);
+            std::copy(field.begin() + start, field.begin() + start + s.getWidth(), block.begin() + static_cast<size_t>(lj) * s.getWidth());
+        }
+    };
+
+    std::vector<double> block;
+    if (comm.getRank() != root) {
+        pack(own, local, block);
+        comm.sendReceive(root, block, -1, {}, gatherTag);
+        return GridField();
+    }
+
+    GridField field(decomposition.getNx(), decomposition.getNy());
+    for (int rank = 0; rank < comm.getSize(); rank++) {
+        const Subdomain& s = decomposition.getSubdomain(rank);
+        if (rank == root) {
+            pack(s, local, block);
+        }
+        else {
+            block.resize(static_cast<size_t>(s.getWidth()) * s.getHeight());
+            comm.sendReceive(-1, {}, rank, block, gatherTag);
+        }
+        for (int lj = 0; lj < s.getHeight(); lj++) {
+            for (int li = 0; li < s.getWidth(); li++) {
+                field(s.iBegin + li, s.jBegin + lj) = block[static_cast<size_t>(lj) * s.getWidth() + li];
+            }
+        }
+    }
+    return field;
+}
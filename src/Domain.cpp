@@ -0,0 +1,93 @@
+#include "Domain.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    bool inBox(const Polygon& polygon, const Point2D& point) {
+        return point.x >= polygon.getMinX() && point.x <= polygon.getMaxX() &&
+            point.y >= polygon.getMinY() && point.y <= polygon.getMaxY();
+    }
+
+    std::vector<std::span<const Point2D>> ringsOf(const std::vector<Point2D>& outer, const std::vector<std::vector<Point2D>>& holes) {
+        std::vector<std::span<const Point2D>> rings;
+        rings.reserve(holes.size() + 1);
+        rings.emplace_back(outer);
+        for (const std::vector<Point2D>& hole : holes) rings.emplace_back(hole);
+        return rings;
+    }
+}
+
+const std::vector<Point2D>& Domain::validate(const std::vector<Point2D>& outer_, const std::vector<std::vector<Point2D>>& holes_,
+    ValidationMethod method) {
+    Polygon::validateRings(ringsOf(outer_, holes_), method);
+    return outer_;
+}
+
+Domain::Domain(const std::vector<Point2D>& outer_, const std::vector<std::vector<Point2D>>& holes_, ValidationMethod method)
+    : outer(validate(outer_, holes_, method), Polygon::Prevalidated{}) {
+    holes.reserve(holes_.size());
+    for (const std::vector<Point2D>& hole : holes_) {
+        holes.push_back(Polygon(hole, Polygon::Prevalidated{}));
+    }
+
+    // No two rings cross or touch, so one vertex of a hole tells on which side of every other ring it lies.
+    // Hole boxes are bucketed on a uniform grid over the outer box so each vertex meets only nearby holes
+    const int buckets = std::max(1, static_cast<int>(std::sqrt(static_cast<double>(holes.size()))));
+    const float width = std::max(outer.getMaxX() - outer.getMinX(), 1e-30f);
+    const float height = std::max(outer.getMaxY() - outer.getMinY(), 1e-30f);
+    auto bucketX = [&](float x) { return std::clamp(static_cast<int>((x - outer.getMinX()) / width * buckets), 0, buckets - 1); };
+    auto bucketY = [&](float y) { return std::clamp(static_cast<int>((y - outer.getMinY()) / height * buckets), 0, buckets - 1); };
+    std::vector<std::vector<size_t>> grid(static_cast<size_t>(buckets) * buckets);
+    for (size_t h = 0; h < holes.size(); h++) {
+        for (int by = bucketY(holes[h].getMinY()); by <= bucketY(holes[h].getMaxY()); by++) {
+            for (int bx = bucketX(holes[h].getMinX()); bx <= bucketX(holes[h].getMaxX()); bx++) {
+                grid[static_cast<size_t>(by) * buckets + bx].push_back(h);
+            }
+        }
+    }
+
+    for (size_t h = 0; h < holes.size(); h++) {
+        const Point2D& vertex = holes[h].getVertices().front();
+        if (!outer.containsPoint(vertex)) {
+            throw std::invalid_argument("Hole lies outside the outer polygon");
+        }
+        for (size_t other : grid[static_cast<size_t>(bucketY(vertex.y)) * buckets + bucketX(vertex.x)]) {
+            if (other != h && inBox(holes[other], vertex) && holes[other].containsPoint(vertex)) {
+                throw std::invalid_argument("Hole lies inside another hole");
+            }
+        }
+    }
+}
+
+Domain::Domain(const Polygon& outer_) : outer(outer_) {}
+
+std::vector<std::span<const Point2D>> Domain::getRings() const {
+    std::vector<std::span<const Point2D>> rings;
+    rings.reserve(holes.size() + 1);
+    rings.emplace_back(outer.getVertices());
+    for (const Polygon& hole : holes) rings.emplace_back(hole.getVertices());
+    return rings;
+}
+
+size_t Domain::getEdgeCount() const {
+    size_t count = outer.getVertices().size();
+    for (const Polygon& hole : holes) count += hole.getVertices().size();
+    return count;
+}
+
+bool Domain::containsPoint(const Point2D& point) const {
+    if (!outer.containsPoint(point)) return false;
+    for (const Polygon& hole : holes) {
+        if (inBox(hole, point) && hole.containsPoint(point)) return false;
+    }
+    return true;
+}
+
+bool Domain::isOnBoundary(const Point2D& point, float epsilon) const {
+    if (outer.isOnBoundary(point, epsilon)) return true;
+    for (const Polygon& hole : holes) {
+        if (hole.isOnBoundary(point, epsilon)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,108 @@
+#include "DomainDecomposition.h"
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    // Start of block b of count blocks over n nodes
+    int blockStart(int n, int count, int b) {
+        return static_cast<int>(static_cast<long long>(n) * b / count);
+    }
+
+    // Block of node k, the inverse of blockStart
+    int blockOf(int n, int count, int k) {
+        int b = static_cast<int>((static_cast<long long>(k) * count + count - 1) / n);
+        while (b > 0 && blockStart(n, count, b) > k) b--;
+        while (b + 1 < count && blockStart(n, count, b + 1) <= k) b++;
+        return b;
+    }
+
+    // Number of block columns px of the px x py = ranks arrangement with the shortest total cut
+    // ny (px - 1) + nx (py - 1), which is the number of values a halo exchange moves
+    int blockColumns(int nx, int ny, int ranks) {
+        int best = 0;
+        long long bestCut = std::numeric_limits<long long>::max();
+        for (int p = 1; p <= ranks; p++) {
+            if (ranks % p != 0 || p > nx || ranks / p > ny) continue;
+            const long long cut = static_cast<long long>(ny) * (p - 1) + static_cast<long long>(nx) * (ranks / p - 1);
+            if (cut < bestCut) {
+                bestCut = cut;
+                best = p;
+            }
+        }
+        if (best == 0) {
+            throw std::invalid_argument("No arrangement of the ranks gives every subdomain a node");
+        }
+        return best;
+    }
+}
+
+DomainDecomposition::DomainDecomposition(int nx_, int ny_, int px_, int py_) : nx(nx_), ny(ny_), px(px_), py(py_) {
+    if (px < 1 || py < 1 || px > nx || py > ny) {
+        throw std::invalid_argument("Each subdomain needs at least one node in each direction");
+    }
+    subdomains.resize(static_cast<size_t>(px) * py);
+    for (int bj = 0; bj < py; bj++) {
+        for (int bi = 0; bi < px; bi++) {
+            Subdomain& s = subdomains[static_cast<size_t>(bj) * px + bi];
+            s.rank = bj * px + bi;
+            s.iBegin = blockStart(nx, px, bi);
+            s.iEnd = blockStart(nx, px, bi + 1);
+            s.jBegin = blockStart(ny, py, bj);
+            s.jEnd = blockStart(ny, py, bj + 1);
+            s.west = bi > 0 ? s.rank - 1 : -1;
+            s.east = bi + 1 < px ? s.rank + 1 : -1;
+            s.south = bj > 0 ? s.rank - px : -1;
+            s.north = bj + 1 < py ? s.rank + px : -1;
+        }
+    }
+}
+
+DomainDecomposition::DomainDecomposition(int nx_, int ny_, int ranks)
+    : DomainDecomposition(nx_, ny_, blockColumns(nx_, ny_, ranks), ranks / blockColumns(nx_, ny_, ranks)) {}
+
+int DomainDecomposition::ownerOf(int i, int j) const {
+    return blockOf(ny, py, j) * px + blockOf(nx, px, i);
+}
+
+HaloExchange::HaloExchange(const Subdomain& subdomain_, Communicator& comm_) : subdomain(subdomain_), comm(comm_) {
+    if (comm.getRank() != subdomain.rank) {
+        throw std::invalid_argument("The communicator's rank does not own the subdomain");
+    }
+    sendColumn.resize(subdomain.getHeight());
+    recvColumn.resize(subdomain.getHeight());
+}
+
+void HaloExchange::exchange(std::span<double> local) {
+    const auto start = std::chrono::steady_clock::now();
+    const int width = subdomain.getWidth();
+    const int height = subdomain.getHeight();
+
+    // Columns: send the owned edge column, receive the opposite neighbour's into the ghost column
+    auto shiftColumns = [&](int dest, int sendColumnIndex, int source, int ghostColumnIndex, int tag) {
+        for (int lj = 0; lj < height; lj++) sendColumn[lj] = local[localIndex(sendColumnIndex, lj)];
+        comm.sendReceive(dest, dest >= 0 ? std::span<const double>(sendColumn) : std::span<const double>(),
+            source, source >= 0 ? std::span<double>(recvColumn) : std::span<double>(), tag);
+        if (source >= 0) {
+            for (int lj = 0; lj < height; lj++) local[localIndex(ghostColumnIndex, lj)] = recvColumn[lj];
+        }
+        stats.messages += dest >= 0;
+        stats.valuesSent += dest >= 0 ? height : 0;
+    };
+    // Rows are contiguous and go straight from and into the local field
+    auto shiftRows = [&](int dest, int sendRowIndex, int source, int ghostRowIndex, int tag) {
+        std::span<const double> row = local.subspan(localIndex(0, sendRowIndex), width);
+        std::span<double> ghost = local.subspan(localIndex(0, ghostRowIndex), width);
+        comm.sendReceive(dest, dest >= 0 ? row : std::span<const double>(), source, source >= 0 ? ghost : std::span<double>(), tag);
+        stats.messages += dest >= 0;
+        stats.valuesSent += dest >= 0 ? width : 0;
+    };
+
+    shiftColumns(subdomain.east, width - 1, subdomain.west, -1, 0);
+    shiftColumns(subdomain.west, 0, subdomain.east, width, 1);
+    shiftRows(subdomain.north, height - 1, subdomain.south, -1, 2);
+    shiftRows(subdomain.south, 0, subdomain.north, height, 3);
+
+    stats.exchanges++;
+    stats.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
@@ -1,43 +1,75 @@
 #include "FDMGrid.h"
+#include "GridFile.h"
 #include "Polygon.h"
+#include "Parallel.h"
+#include <stdexcept>
 
 
-FDMGrid::FDMGrid(int nx_, int ny_, Polygon& polygon) : nx(nx_), ny(ny_) {
-    originX = polygon.getMinX();
-    originY = polygon.getMinY();
+FDMGrid::FDMGrid(int nx_, int ny_, Polygon& polygon, unsigned numThreads_) : nx(nx_), ny(ny_), numThreads(numThreads_) {
+    build(polygon.getMinX(), polygon.getMinY(), polygon.getMaxX(), polygon.getMaxY(), nx, ny, {std::span<const Point2D>(polygon.getVertices())});
+}
+
+FDMGrid::FDMGrid(int nx_, int ny_, Polygon& polygon, const CellBox& window, unsigned numThreads_)
+    : nx(window.iEnd - window.iBegin), ny(window.jEnd - window.jBegin), iOffset(window.iBegin), jOffset(window.jBegin),
+      numThreads(numThreads_) {
+    if (window.iBegin < 0 || window.jBegin < 0 || window.iEnd > nx_ || window.jEnd > ny_ || nx <= 0 || ny <= 0) {
+        throw std::invalid_argument("The window must be a non-empty box of cells inside the grid");
+    }
+    build(polygon.getMinX(), polygon.getMinY(), polygon.getMaxX(), polygon.getMaxY(), nx_, ny_, {std::span<const Point2D>(polygon.getVertices())});
+}
+
+FDMGrid::FDMGrid(int nx_, int ny_, const Domain& domain, unsigned numThreads_) : nx(nx_), ny(ny_), numThreads(numThreads_) {
+    build(domain.getMinX(), domain.getMinY(), domain.getMaxX(), domain.getMaxY(), nx, ny, domain.getRings());
+}
+
+FDMGrid::FDMGrid(const GridFile& file, unsigned numThreads_)
+    : originX(file.getOriginX()), originY(file.getOriginY()), dx(file.getDx()), dy(file.getDy()),
+      nx(file.getNx()), ny(file.getNy()), numThreads(numThreads_),
+      cells(file.getCells().begin(), file.getCells().end()),
+      armCells(file.getArmCells().begin(), file.getArmCells().end()),
+      arms(file.getArms().begin(), file.getArms().end()),
+      interiorCells(file.getInteriorCells().begin(), file.getInteriorCells().end()) {
+    for (GridType type : {UNDEFINED, BOUNDARY, INTERIOR, EXTERIOR}) {
+        typeCounts[type + 1] = file.getCellCount(type);
+    }
+}
+
+void FDMGrid::build(float minX, float minY, float maxX, float maxY, int fullNx, int fullNy,
+    const std::vector<std::span<const Point2D>>& rings) {
+    originX = minX;
+    originY = minY;
 
-    dx = (polygon.getMaxX() - originX) / (nx - 1);
-    dy = (polygon.getMaxY() - originY) / (ny - 1);
+    dx = (maxX - originX) / (fullNx - 1);
+    dy = (maxY - originY) / (fullNy - 1);
     
     // Initialize all cells to UNDEFINED
-    gridMatrix.resize(nx, std::vector<GridType>(ny, UNDEFINED));
+    cells.assign(static_cast<size_t>(nx) * ny, UNDEFINED);
     
-    // Mark the boundaries of the polygon
-    markBoundaries(polygon);
-    
-    // Fill the interior and exterior cells
-    fillInteriorExterior(polygon);
+    // Scan-convert the rings into boundary, interior and exterior cells
+    classify(rings);
+    measureBoundaryArms(rings, CellBox{0, nx, 0, ny}, armCells, arms);
+    indexCells();
 }
 
 
 Point2D FDMGrid::indexToPoint(int i, int j) const {
-    return {originX + i * dx, originY + j * dy};
+    return {originX + (i + iOffset) * dx, originY + (j + jOffset) * dy};
 }
 
 std::pair<int, int> FDMGrid::pointToIndex(const Point2D& point) const {
-    int i = std::round((point.x - originX) / dx);
-    int j = std::round((point.y - originY) / dy);
+    int i = std::round((point.x - originX) / dx) - iOffset;
+    int j = std::round((point.y - originY) / dy) - jOffset;
     return {i, j};
 }
 
 GridType FDMGrid::getCellType(int i, int j) const {
     if (!isValidIndex(i, j)) return EXTERIOR;
-    return gridMatrix[i][j];
+    return cells[cellIndex(i, j)];
 }
 
 void FDMGrid::setCellType(int i, int j, GridType type)  {
     if (isValidIndex(i, j)) {
-        gridMatrix[i][j] = type;
+        cells[cellIndex(i, j)] = type;
     }
 }
 
@@ -45,15 +77,19 @@ bool FDMGrid::isValidIndex(int i, int j) const {
     return i >= 0 && i < nx && j >= 0 && j < ny;
 }
 
+BoundaryArms FDMGrid::getBoundaryArms(int i, int j) const {
+    if (!isValidIndex(i, j)) return {};
+    const size_t cell = cellIndex(i, j);
+    auto it = std::lower_bound(armCells.begin(), armCells.end(), cell);
+    return (it != armCells.end() && *it == cell) ? arms[it - armCells.begin()] : BoundaryArms{};
+}
+
 
 std::vector<Point2D> FDMGrid::getPointsOfType(GridType type) const {
     std::vector<Point2D> points;
-    for (int i = 0; i < nx; i++) {
-        for (int j = 0; j < ny; j++) {
-            if (gridMatrix[i][j] == type) {
-                points.push_back(indexToPoint(i, j));
-            }
-        }
+    points.reserve(getCellCount(type));
+    for (const Point2D& point : pointsOfType(type)) {
+        points.push_back(point);
     }
     return points;
 }
@@ -68,85 +104,487 @@ std::vector<Point2D> FDMGrid::getExteriorPoints() const {
     return getPointsOfType(EXTERIOR);
 }
 
+void FDMGrid::indexCells() {
+    typeCounts.fill(0);
+    for (GridType type : cells) {
+        typeCounts[type + 1]++;
+    }
+    interiorCells.clear();
+    interiorCells.reserve(getCellCount(INTERIOR));
+    for (size_t c = 0; c < cells.size(); c++) {
+        if (cells[c] == INTERIOR) interiorCells.push_back(c);
+    }
+}
 
 
-void FDMGrid::markBoundaries(const Polygon& polygon) {
-    const std::vector<Point2D>& vertices = polygon.getVertices();
-    if (vertices.empty()) return;
-    
-    // For each edge of the polygon
-    for (size_t v = 0; v < vertices.size(); v++) {
-        const Point2D& start = vertices[v];
-        const Point2D& end = vertices[(v + 1) % vertices.size()];
-        
-        // Convert to grid indices
-        auto [i1, j1] = pointToIndex(start);
-        auto [i2, j2] = pointToIndex(end);
-        
-        // Use Bresenham's line algorithm to mark the line on the grid
-        int di = std::abs(i2 - i1);
-        int dj = std::abs(j2 - j1);
-        int si = i1 < i2 ? 1 : -1; // step in i direction
-        int sj = j1 < j2 ? 1 : -1; // step in j direction
-        
-        int error = di - dj;
-        
-        int i = i1, j = j1;
-        
-        // Draw the line on the grid
-        while (true) {
-            // Mark this cell as boundary if in range
-            if (isValidIndex(i, j)) {
-                gridMatrix[i][j] = BOUNDARY;
-            }
-            
-            // Exit if we've reached the end point
-            if (i == i2 && j == j2) break;
-            
-            // Calculate next point
-            int e2 = 2 * error;
-            if (e2 > -dj) {
-                error -= dj;
-                i += si;
-            }
-            if (e2 < di) {
-                error += di;
-                j += sj;
+
+/*====================================  Scan Conversion  =========================================*/
+
+struct FDMGrid::ScanEdge {
+    double yLo, yHi;  // y-extent of the edge, yLo <= yHi
+    double xLo, xHi;  // x at yLo and at yHi
+    double dxdy;      // inverse slope, 0 for horizontal edges
+
+    double xAt(double y) const { return xLo + (y - yLo) * dxdy; }
+};
+
+std::vector<FDMGrid::ScanEdge> FDMGrid::buildEdgeTable(const std::vector<std::span<const Point2D>>& rings, double yMin, double yMax) {
+    size_t total = 0;
+    for (std::span<const Point2D> ring : rings) total += ring.size();
+    std::vector<ScanEdge> edges;
+    edges.reserve(total);
+
+    for (std::span<const Point2D> vertices : rings) {
+        for (size_t v = 0; v < vertices.size(); v++) {
+            const Point2D& a = vertices[v];
+            const Point2D& b = vertices[(v + 1) % vertices.size()];
+            const bool upward = a.y <= b.y;
+            const Point2D& lo = upward ? a : b;
+            const Point2D& hi = upward ? b : a;
+            if (hi.y < yMin || lo.y > yMax) continue;
+
+            ScanEdge edge;
+            edge.yLo = lo.y;
+            edge.yHi = hi.y;
+            edge.xLo = lo.x;
+            edge.xHi = hi.x;
+            edge.dxdy = (edge.yHi > edge.yLo) ? (edge.xHi - edge.xLo) / (edge.yHi - edge.yLo) : 0.0;
+            edges.push_back(edge);
+        }
+    }
+
+    // Edge table ordered by the row at which each edge becomes active
+    std::sort(edges.begin(), edges.end(), [](const ScanEdge& a, const ScanEdge& b) { return a.yLo < b.yLo; });
+    return edges;
+}
+
+void FDMGrid::classify(const std::vector<std::span<const Point2D>>& rings) {
+    const std::vector<ScanEdge> edges = buildEdgeTable(rings);
+    if (edges.empty()) return;
+    classifyTile(edges, CellBox{0, nx, 0, ny});
+}
+
+void FDMGrid::classifyTile(const std::vector<ScanEdge>& edges, const CellBox& tile) {
+    // Each thread converts a contiguous band of rows; keep bands large enough to amortize thread start-up
+    const int width = tile.iEnd - tile.iBegin;
+    const int minRowsPerThread = std::max(1, (1 << 16) / std::max(1, width));
+    parallelFor(tile.jBegin, tile.jEnd, minRowsPerThread, numThreads,
+        [this, &edges, &tile](int first, int last) { classifyRows(edges, first, last, tile.iBegin, tile.iEnd); });
+}
+
+void FDMGrid::classifyRows(const std::vector<ScanEdge>& edges, int jBegin, int jEnd, int iBegin, int iEnd) {
+    const double halfDy = 0.5 * static_cast<double>(dy);
+    const double invDx = 1.0 / static_cast<double>(dx);
+
+    // Columns and rows are numbered in the full grid, so a window classifies its cells exactly as
+    // the full grid does; only the writes into the row are shifted by the window's offset
+    iBegin += iOffset;
+    iEnd += iOffset;
+
+    // Continuous column coordinate of x, node i sits at exactly i
+    auto column = [this, invDx](double x) { return (x - originX) * invDx; };
+    auto clampColumn = [this](double c) { return static_cast<int>(std::clamp(c, -1.0, static_cast<double>(iOffset + nx))); };
+
+    std::vector<const ScanEdge*> active;
+    std::vector<double> crossings;
+    size_t next = 0;
+
+    for (int j = jBegin; j < jEnd; j++) {
+        const double y = static_cast<double>(originY) + (j + jOffset) * static_cast<double>(dy);
+        const double bandLo = y - halfDy;
+        const double bandHi = y + halfDy;
+
+        // Active edges are those overlapping the half-open band [bandLo, bandHi) owned by this row
+        while (next < edges.size() && edges[next].yLo < bandHi) {
+            active.push_back(&edges[next++]);
+        }
+        std::erase_if(active, [bandLo](const ScanEdge* e) { return e->yHi < bandLo; });
+
+        GridType* row = cells.data() + cellIndex(0, j);
+        std::fill(row + (iBegin - iOffset), row + (iEnd - iOffset), EXTERIOR);
+
+        // Exact crossings of the scan line; the half-open rule [yLo, yHi) counts a vertex touching
+        // the line once when the polygon passes through it and zero or two times when it only touches,
+        // and skips horizontal edges entirely. Crossings too far left to bound a span reaching the
+        // columns are only counted; an odd count opens a span from the left end
+        crossings.clear();
+        bool leftOdd = false;
+        for (const ScanEdge* e : active) {
+            if (e->yLo <= y && y < e->yHi) {
+                const double x = e->xAt(y);
+                if (iBegin > 0 && column(x) < iBegin - 1) leftOdd = !leftOdd;
+                else crossings.push_back(x);
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+        if (leftOdd) crossings.insert(crossings.begin(), -HUGE_VAL);
+
+        // Nodes strictly between each pair of crossings are interior (even-odd rule over all rings)
+        for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+            const int first = std::max(clampColumn(std::floor(column(crossings[k]))) + 1, iBegin);
+            const int last = std::min(clampColumn(std::ceil(column(crossings[k + 1]))) - 1, iEnd - 1);
+            if (first <= last) {
+                std::fill(row + (first - iOffset), row + (last + 1 - iOffset), INTERIOR);
+            }
+        }
+
+        // Boundary nodes: the nearest node to every point of the polygon whose y falls in this row's band,
+        // so shallow and horizontal edges stay connected and every crossing lands on a boundary node.
+        // Node i owns the x-interval [i - 1/2, i + 1/2); the band top is open, so a right end clipped
+        // there only reaches the nodes it strictly enters
+        for (const ScanEdge* e : active) {
+            double xA = std::min(e->xLo, e->xHi), xB = std::max(e->xLo, e->xHi);
+            if (column(xB) + 0.5 < iBegin || column(xA) + 0.5 >= iEnd) continue;
+            bool openRight = false;
+            if (e->dxdy != 0.0) {
+                const double yA = std::max(bandLo, e->yLo);
+                const double yB = std::min(bandHi, e->yHi);
+                xA = e->xAt(yA);
+                xB = e->xAt(yB);
+                openRight = (yB == bandHi && e->dxdy > 0.0);
+                if (xA > xB) std::swap(xA, xB);
+            }
+
+            const double cA = column(xA) + 0.5;
+            const double cB = column(xB) + 0.5;
+            const int first = std::max(clampColumn(std::floor(cA)), iBegin);
+            const int last = std::min(clampColumn(openRight ? std::ceil(cB) - 1.0 : std::floor(cB)), iEnd - 1);
+            if (first <= last) {
+                std::fill(row + (first - iOffset), row + (last + 1 - iOffset), BOUNDARY);
             }
         }
     }
-    
 }
-void FDMGrid::fillInteriorExterior(const Polygon& polygon) {
 
-    
-    // Scan-line fill with proper boundary crossing detection
-    for (int j = 0; j < ny; j++) {
-        bool inside = false;
-        
-        for (int i = 0; i < nx; i++) {
-            if (gridMatrix[i][j] == BOUNDARY) {
-                // Check the type of boundary crossing
-                int nextI = i + 1;
-                while (nextI < nx && gridMatrix[nextI][j] == BOUNDARY) {
-                    nextI++;
+
+/*====================================  Boundary Arms  =========================================*/
+
+namespace {
+    constexpr float maxArm = FDMGrid::armReach;
+}
+
+void FDMGrid::measureBoundaryArms(const std::vector<std::span<const Point2D>>& rings, const CellBox& box,
+    std::vector<size_t>& boxCells, std::vector<BoundaryArms>& boxArms) const {
+    // One candidate arm per (cell, direction): 0 = west, 1 = east, 2 = south, 3 = north
+    struct ArmCut {
+        size_t cell;
+        int direction;
+        double length;
+    };
+    std::vector<ArmCut> cuts;
+
+    // Crossings and nodes are located in the indices of the full grid, node (i, j) of a window
+    // being (i + iOffset, j + jOffset) there, so a window measures its arms as the full grid does
+    const CellBox full{box.iBegin + iOffset, box.iEnd + iOffset, box.jBegin + jOffset, box.jEnd + jOffset};
+    auto valid = [this](int i, int j) { return isValidIndex(i - iOffset, j - jOffset); };
+    auto interior = [&](int i, int j) { return valid(i, j) && cells[cellIndex(i - iOffset, j - jOffset)] == INTERIOR; };
+
+    // A crossing at continuous index c of one grid line ends the forward arm of the nearest interior
+    // node at or below c and the backward arm of the nearest one above it, reached across non-interior
+    // nodes only; a steep edge can leave BOUNDARY nodes inside the polygon several spacings long
+    auto addCrossing = [&](double c, int line, bool alongX) {
+        auto node = [&](int k) { return alongX ? std::make_pair(k, line) : std::make_pair(line, k); };
+        auto interiorAt = [&](int k) { return interior(node(k).first, node(k).second); };
+        auto validAt = [&](int k) { return valid(node(k).first, node(k).second); };
+        auto inBox = [&](int k) {
+            const auto [i, j] = node(k);
+            return i >= full.iBegin && i < full.iEnd && j >= full.jBegin && j < full.jEnd;
+        };
+        auto addCut = [&](int k, int step, int direction, double length) {
+            if (length > 0.0 && length < maxArm && inBox(k) && interiorAt(k) && !interiorAt(k + step)) {
+                cuts.push_back({cellIndex(node(k).first - iOffset, node(k).second - jOffset), direction, length});
+            }
+        };
+        int k = static_cast<int>(std::floor(c));
+        while (validAt(k) && !interiorAt(k) && c - k < maxArm) k--;
+        addCut(k, 1, alongX ? 1 : 3, c - k);
+        k = static_cast<int>(std::ceil(c));
+        while (validAt(k) && !interiorAt(k) && k - c < maxArm) k++;
+        addCut(k, -1, alongX ? 0 : 2, k - c);
+    };
+
+    for (std::span<const Point2D> vertices : rings) {
+        for (size_t v = 0; v < vertices.size(); v++) {
+            const Point2D& a = vertices[v];
+            const Point2D& b = vertices[(v + 1) % vertices.size()];
+            // Edge in continuous grid coordinates, node (i, j) at exactly (i, j)
+            const double ax = (a.x - static_cast<double>(originX)) / dx, ay = (a.y - static_cast<double>(originY)) / dy;
+            const double bx = (b.x - static_cast<double>(originX)) / dx, by = (b.y - static_cast<double>(originY)) / dy;
+
+            // Only crossings within maxArm of the box can end the arm of a cell in it
+            if (std::max(ax, bx) < full.iBegin - maxArm || std::min(ax, bx) > full.iEnd - 1 + maxArm ||
+                std::max(ay, by) < full.jBegin - maxArm || std::min(ay, by) > full.jEnd - 1 + maxArm) {
+                continue;
+            }
+
+            // Crossings with the rows j (lines of constant y) in the box, then with its columns i
+            if (ay != by) {
+                const int jFirst = std::max(full.jBegin, static_cast<int>(std::ceil(std::min(ay, by))));
+                const int jLast = std::min(full.jEnd - 1, static_cast<int>(std::floor(std::max(ay, by))));
+                for (int j = jFirst; j <= jLast; j++) {
+                    addCrossing(ax + (j - ay) * (bx - ax) / (by - ay), j, true);
                 }
-                // Toggle inside/outside when crossing boundary
-                inside = !inside;
-                
-                i = nextI - 1; // Skip ahead past the boundary section
-            } 
-            else {
-                // Fill cells based on current inside/outside state
-                gridMatrix[i][j] = inside ? INTERIOR : EXTERIOR;
             }
+            if (ax != bx) {
+                const int iFirst = std::max(full.iBegin, static_cast<int>(std::ceil(std::min(ax, bx))));
+                const int iLast = std::min(full.iEnd - 1, static_cast<int>(std::floor(std::max(ax, bx))));
+                for (int i = iFirst; i <= iLast; i++) {
+                    addCrossing(ay + (i - ax) * (by - ay) / (bx - ax), i, false);
+                }
+            }
+        }
+    }
+
+    // Keep the nearest crossing of every arm
+    std::sort(cuts.begin(), cuts.end(), [](const ArmCut& p, const ArmCut& q) { return p.cell < q.cell; });
+    boxCells.clear();
+    boxArms.clear();
+    for (const ArmCut& cut : cuts) {
+        if (boxCells.empty() || boxCells.back() != cut.cell) {
+            boxCells.push_back(cut.cell);
+            boxArms.push_back({maxArm, maxArm, maxArm, maxArm});
+        }
+        float* arm[] = {&boxArms.back().west, &boxArms.back().east, &boxArms.back().south, &boxArms.back().north};
+        *arm[cut.direction] = std::min(*arm[cut.direction], static_cast<float>(cut.length));
+    }
+    // Arms without a crossing within maxArm spacings end at the neighbouring node
+    for (BoundaryArms& arm : boxArms) {
+        for (float* length : {&arm.west, &arm.east, &arm.south, &arm.north}) {
+            if (*length >= maxArm) *length = 1.0f;
         }
-        // in case of a corner, we need to backfill the falsely marked interior to exterior
-        if (gridMatrix[nx-1][j] == INTERIOR){
-            for (int i = nx - 1; gridMatrix[i][j] != BOUNDARY ; i--) {
-                gridMatrix[i][j] = EXTERIOR;
+    }
+}
+
+
+/*====================================  Incremental Update  =========================================*/
+
+namespace {
+    // Replaces length elements of a vector from position at with a range, shifting the tail once
+    template <class Vector, class Range>
+    void replaceRange(Vector& vector, size_t at, size_t length, const Range& with) {
+        if (with.size() > length) {
+            vector.insert(vector.begin() + at + length, with.size() - length, typename Vector::value_type{});
+        }
+        else {
+            vector.erase(vector.begin() + at + with.size(), vector.begin() + at + length);
+        }
+        std::copy(with.begin(), with.end(), vector.begin() + at);
+    }
+
+    bool overlaps(const CellBox& a, const CellBox& b) {
+        return a.iBegin < b.iEnd && b.iBegin < a.iEnd && a.jBegin < b.jEnd && b.jBegin < a.jEnd;
+    }
+
+    // Folds items whose boxes overlap into one until all boxes are disjoint; absorb(into, from)
+    // grows into by from, so that boxOf(into) covers both
+    template <class Item, class BoxOf, class Absorb>
+    void uniteOverlapping(std::vector<Item>& items, BoxOf boxOf, Absorb absorb) {
+        for (bool united = true; united;) {
+            united = false;
+            for (size_t a = 0; a < items.size(); a++) {
+                for (size_t b = a + 1; b < items.size();) {
+                    if (!overlaps(boxOf(items[a]), boxOf(items[b]))) {
+                        b++;
+                        continue;
+                    }
+                    absorb(items[a], items[b]);
+                    items.erase(items.begin() + static_cast<std::ptrdiff_t>(b));
+                    united = true;
+                }
             }
         }
     }
 
-}
\ No newline at end of file
+    // Extent in grid coordinates of the edges of a run of moved vertices
+    struct EdgeExtent {
+        double iLo = HUGE_VAL, iHi = -HUGE_VAL;
+        double jLo = HUGE_VAL, jHi = -HUGE_VAL;
+
+        void add(double i, double j) {
+            iLo = std::min(iLo, i);
+            iHi = std::max(iHi, i);
+            jLo = std::min(jLo, j);
+            jHi = std::max(jHi, j);
+        }
+        void add(const EdgeExtent& other) {
+            iLo = std::min(iLo, other.iLo);
+            iHi = std::max(iHi, other.iHi);
+            jLo = std::min(jLo, other.jLo);
+            jHi = std::max(jHi, other.jHi);
+        }
+    };
+}
+
+GridUpdate FDMGrid::moveVertices(Polygon& polygon, std::span<const VertexMove> moves) {
+    GridUpdate update;
+    if (moves.empty()) return update;
+    const std::vector<Point2D>& vertices = polygon.getVertices();
+    const size_t n = vertices.size();
+
+    // Runs of cyclically adjacent moved vertices, as first and last index; a run that wraps past
+    // the last vertex has first > last. The chain of edges of a run keeps its end points
+    std::vector<size_t> moved;
+    for (const VertexMove& move : moves) {
+        if (move.index < n) moved.push_back(move.index);
+    }
+    std::sort(moved.begin(), moved.end());
+    moved.erase(std::unique(moved.begin(), moved.end()), moved.end());
+    std::vector<std::pair<size_t, size_t>> runs;
+    for (size_t v : moved) {
+        if (!runs.empty() && runs.back().second + 1 == v) runs.back().second = v;
+        else runs.push_back({v, v});
+    }
+    if (runs.size() > 1 && runs.front().first == 0 && runs.back().second == n - 1) {
+        runs.front().first = runs.back().first;
+        runs.pop_back();
+    }
+
+    // Extent of each run's edges, before and after the move
+    std::vector<EdgeExtent> extents(runs.size());
+    auto extend = [&]() {
+        for (size_t r = 0; r < runs.size(); r++) {
+            const size_t length = (runs[r].second + n - runs[r].first) % n + 1;
+            for (size_t k = 0; k < length + 2; k++) {
+                const Point2D& vertex = vertices[(runs[r].first + n - 1 + k) % n];
+                extents[r].add((vertex.x - static_cast<double>(originX)) / dx - iOffset,
+                    (vertex.y - static_cast<double>(originY)) / dy - jOffset);
+            }
+        }
+    };
+    extend();
+    polygon.moveVertices(moves);
+    extend();
+
+    const std::vector<std::span<const Point2D>> rings{std::span<const Point2D>(vertices)};
+    auto clampIndex = [](double c, int limit) { return static_cast<int>(std::clamp(c, 0.0, static_cast<double>(limit))); };
+
+    // Row j owns the band [j - 1/2, j + 1/2) and node i the interval [i - 1/2, i + 1/2); a
+    // tile gets one extra row and two extra columns on each side to absorb rounding
+    auto tileOf = [&](const EdgeExtent& e) {
+        return CellBox{clampIndex(std::floor(e.iLo) - 2.0, nx), clampIndex(std::ceil(e.iHi) + 3.0, nx),
+            clampIndex(std::floor(e.jLo - 0.5) - 1.0, ny), clampIndex(std::ceil(e.jHi + 0.5) + 1.0, ny)};
+    };
+    // Tiles of runs far apart stay separate; only the cells under the moved edges are classified
+    uniteOverlapping(extents, tileOf, [](EdgeExtent& into, const EdgeExtent& from) { into.add(from); });
+
+    // A cell's arms depend on the crossings and the cells within maxArm + 1 of it along its lines
+    const double reach = maxArm + 1.0;
+    for (const EdgeExtent& extent : extents) {
+        const CellBox tile = tileOf(extent);
+        int iChangedLo = nx, iChangedHi = -1, jChangedLo = ny, jChangedHi = -1;
+        if (tile.iBegin < tile.iEnd && tile.jBegin < tile.jEnd) {
+            update.classified.push_back(tile);
+            const size_t width = static_cast<size_t>(tile.iEnd - tile.iBegin);
+            std::vector<GridType> before;
+            before.reserve(width * (tile.jEnd - tile.jBegin));
+            for (int j = tile.jBegin; j < tile.jEnd; j++) {
+                const auto row = cells.begin() + cellIndex(tile.iBegin, j);
+                before.insert(before.end(), row, row + width);
+            }
+
+            const double yMin = static_cast<double>(originY) + (tile.jBegin + jOffset - 1.0) * dy;
+            const double yMax = static_cast<double>(originY) + (tile.jEnd + jOffset + 0.0) * dy;
+            classifyTile(buildEdgeTable(rings, yMin, yMax), tile);
+
+            // Offsets of the tile that left or joined the INTERIOR cells, both sorted
+            std::vector<size_t> left, joined;
+            const size_t firstChange = update.changedCells.size();
+            auto previous = before.begin();
+            for (int j = tile.jBegin; j < tile.jEnd; j++) {
+                for (int i = tile.iBegin; i < tile.iEnd; i++, ++previous) {
+                    const size_t c = cellIndex(i, j);
+                    if (cells[c] == *previous) continue;
+
+                    update.changedCells.push_back({c, *previous, cells[c]});
+                    typeCounts[*previous + 1]--;
+                    typeCounts[cells[c] + 1]++;
+                    if (*previous == INTERIOR) left.push_back(c);
+                    if (cells[c] == INTERIOR) joined.push_back(c);
+                    iChangedLo = std::min(iChangedLo, i);
+                    iChangedHi = std::max(iChangedHi, i);
+                    jChangedLo = std::min(jChangedLo, j);
+                    jChangedHi = std::max(jChangedHi, j);
+                }
+            }
+
+            // Only the interior offsets between the tile's first and last changed cell are rewritten
+            if (update.changedCells.size() > firstChange) {
+                const auto from = std::lower_bound(interiorCells.begin(), interiorCells.end(), update.changedCells[firstChange].cell);
+                const auto to = std::upper_bound(from, interiorCells.end(), update.changedCells.back().cell);
+                std::vector<size_t> rewritten;
+                rewritten.reserve(static_cast<size_t>(to - from) + joined.size());
+                auto leaving = left.begin(), joining = joined.begin();
+                for (auto it = from; it != to; ++it) {
+                    if (leaving != left.end() && *leaving == *it) {
+                        ++leaving;
+                        continue;
+                    }
+                    while (joining != joined.end() && *joining < *it) rewritten.push_back(*joining++);
+                    rewritten.push_back(*it);
+                }
+                rewritten.insert(rewritten.end(), joining, joined.end());
+                replaceRange(interiorCells, static_cast<size_t>(from - interiorCells.begin()), static_cast<size_t>(to - from), rewritten);
+            }
+        }
+
+        const double boxILo = std::min(std::floor(extent.iLo), static_cast<double>(iChangedLo)) - reach;
+        const double boxIHi = std::max(std::ceil(extent.iHi), static_cast<double>(iChangedHi)) + reach + 1.0;
+        const double boxJLo = std::min(std::floor(extent.jLo), static_cast<double>(jChangedLo)) - reach;
+        const double boxJHi = std::max(std::ceil(extent.jHi), static_cast<double>(jChangedHi)) + reach + 1.0;
+        const CellBox box{clampIndex(boxILo, nx), clampIndex(boxIHi, nx), clampIndex(boxJLo, ny), clampIndex(boxJHi, ny)};
+        if (box.iBegin < box.iEnd && box.jBegin < box.jEnd) update.measured.push_back(box);
+    }
+    std::sort(update.changedCells.begin(), update.changedCells.end(),
+        [](const CellChange& a, const CellChange& b) { return a.cell < b.cell; });
+
+    // The boxes of separate tiles may still reach each other
+    uniteOverlapping(update.measured, [](const CellBox& box) { return box; }, [](CellBox& into, const CellBox& from) {
+        into = {std::min(into.iBegin, from.iBegin), std::max(into.iEnd, from.iEnd),
+            std::min(into.jBegin, from.jBegin), std::max(into.jEnd, from.jEnd)};
+    });
+    for (const CellBox& box : update.measured) {
+        std::vector<size_t> boxCells;
+        std::vector<BoundaryArms> boxArms;
+        measureBoundaryArms(rings, box, boxCells, boxArms);
+
+        // Cut cells outside the box keep their arms; those inside are replaced and compared. Only
+        // the entries in the box's rows are rewritten
+        const size_t from = static_cast<size_t>(std::lower_bound(armCells.begin(), armCells.end(), cellIndex(0, box.jBegin)) - armCells.begin());
+        const size_t to = static_cast<size_t>(std::lower_bound(armCells.begin() + from, armCells.end(), cellIndex(0, box.jEnd)) - armCells.begin());
+        std::vector<size_t> mergedCells;
+        std::vector<BoundaryArms> mergedArms;
+        mergedCells.reserve(to - from + boxCells.size());
+        mergedArms.reserve(to - from + boxCells.size());
+        size_t fresh = 0;
+        // Re-measured cut cells before an offset had no previous entry, so they are new
+        auto takeFresh = [&](size_t upTo) {
+            for (; fresh < boxCells.size() && boxCells[fresh] < upTo; fresh++) {
+                update.changedArms.push_back(boxCells[fresh]);
+                mergedCells.push_back(boxCells[fresh]);
+                mergedArms.push_back(boxArms[fresh]);
+            }
+        };
+        for (size_t k = from; k < to; k++) {
+            const size_t cell = armCells[k];
+            const int i = static_cast<int>(cell % nx);
+            takeFresh(cell);
+            if (i < box.iBegin || i >= box.iEnd) {
+                mergedCells.push_back(cell);
+                mergedArms.push_back(arms[k]);
+            }
+            else if (fresh < boxCells.size() && boxCells[fresh] == cell) {
+                if (boxArms[fresh] != arms[k]) update.changedArms.push_back(cell);
+                mergedCells.push_back(cell);
+                mergedArms.push_back(boxArms[fresh++]);
+            }
+            else {
+                update.changedArms.push_back(cell);
+            }
+        }
+        takeFresh(SIZE_MAX);
+        replaceRange(armCells, from, to - from, mergedCells);
+        replaceRange(arms, from, to - from, mergedArms);
+    }
+    std::sort(update.changedArms.begin(), update.changedArms.end());
+    return update;
+}
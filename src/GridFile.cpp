@@ -0,0 +1,223 @@
+#include "GridFile.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+// Sections are mapped in place, so their element types must have a fixed, padding-free layout
+static_assert(sizeof(GridFileHeader) == 128 && std::is_trivially_copyable_v<GridFileHeader>);
+static_assert(sizeof(GridFileSection) == 64 && std::is_trivially_copyable_v<GridFileSection>);
+static_assert(sizeof(GridType) == 1 && sizeof(size_t) == sizeof(uint64_t));
+static_assert(sizeof(BoundaryArms) == 4 * sizeof(float) && std::is_trivially_copyable_v<BoundaryArms>);
+
+namespace {
+    constexpr char magic[8] = {'P', 'D', 'E', 'G', 'R', 'I', 'D', '\0'};
+    constexpr uint64_t sectionAlignment = 64;
+
+    uint64_t alignUp(uint64_t offset) {
+        return (offset + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+    }
+
+    // Section data in memory, described by its table entry
+    struct Payload {
+        GridFileSection entry;
+        const void* data;
+    };
+
+    Payload payload(std::string_view name, GridSectionType type, uint32_t elementSize, const void* data, size_t count) {
+        Payload p{};
+        std::copy(name.begin(), name.end(), p.entry.name);
+        p.entry.type = type;
+        p.entry.elementSize = elementSize;
+        p.entry.count = count;
+        p.data = data;
+        return p;
+    }
+}
+
+/*====================================  Constructors  =========================================*/
+
+GridFile::GridFile(const std::string& path) : file(path) {
+    const std::span<const std::byte> bytes = file.getBytes();
+    if (bytes.size() < sizeof(GridFileHeader)) {
+        throw std::runtime_error(path + " is too short to be a grid file");
+    }
+    header = reinterpret_cast<const GridFileHeader*>(bytes.data());
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0) {
+        throw std::runtime_error(path + " is not a grid file");
+    }
+    if (header->version != version) {
+        throw std::runtime_error(path + " has grid file version " + std::to_string(header->version) +
+            ", expected " + std::to_string(version));
+    }
+    if (header->byteOrder != byteOrderMark) {
+        throw std::runtime_error(path + " was written with another byte order");
+    }
+    if (header->layout != 0 || header->nx < 1 || header->ny < 1) {
+        throw std::runtime_error(path + " has an unsupported layout or grid size");
+    }
+    const uint64_t tableBytes = static_cast<uint64_t>(header->sectionCount) * sizeof(GridFileSection);
+    if (header->sectionTable % alignof(GridFileSection) != 0 || header->sectionTable > bytes.size() ||
+        tableBytes > bytes.size() - header->sectionTable) {
+        throw std::runtime_error(path + " has a section table outside the file");
+    }
+
+    const uint64_t cellCount = static_cast<uint64_t>(header->nx) * static_cast<uint64_t>(header->ny);
+    const auto* table = reinterpret_cast<const GridFileSection*>(bytes.data() + header->sectionTable);
+    bool hasCells = false;
+    for (uint32_t s = 0; s < header->sectionCount; s++) {
+        const GridFileSection& section = table[s];
+        const std::string name(section.name, strnlen(section.name, sizeof(section.name)));
+        const uint32_t expectedSize[] = {sizeof(GridType), sizeof(size_t), sizeof(BoundaryArms), sizeof(double)};
+        const auto type = static_cast<uint32_t>(section.type);
+        if (name.size() == sizeof(section.name) || type > static_cast<uint32_t>(GridSectionType::FIELD) ||
+            section.elementSize != expectedSize[type]) {
+            throw std::runtime_error(path + " has a malformed section entry");
+        }
+        if (section.offset % sectionAlignment != 0 || section.offset > bytes.size() ||
+            section.count > (bytes.size() - section.offset) / section.elementSize) {
+            throw std::runtime_error(path + " has section " + name + " outside the file");
+        }
+
+        const std::byte* data = bytes.data() + section.offset;
+        const size_t count = static_cast<size_t>(section.count);
+        switch (section.type) {
+        case GridSectionType::CELL_TYPES:
+            if (count != cellCount) throw std::runtime_error(path + " has a cell section of the wrong size");
+            cells = {reinterpret_cast<const GridType*>(data), count};
+            hasCells = true;
+            break;
+        case GridSectionType::OFFSETS:
+            (name == "interior_cells" ? interiorCells : armCells) = {reinterpret_cast<const size_t*>(data), count};
+            break;
+        case GridSectionType::ARMS:
+            arms = {reinterpret_cast<const BoundaryArms*>(data), count};
+            break;
+        case GridSectionType::FIELD:
+            if (count != cellCount) throw std::runtime_error(path + " has field " + name + " of the wrong size");
+            fields.emplace_back(name, std::span<const double>(reinterpret_cast<const double*>(data), count));
+            break;
+        }
+    }
+    if (!hasCells || arms.size() != armCells.size() || interiorCells.size() != getCellCount(INTERIOR)) {
+        throw std::runtime_error(path + " is missing grid sections");
+    }
+
+    // Offsets index the cells unchecked later, so each list must be strictly increasing and inside the grid
+    auto validOffsets = [cellCount](std::span<const size_t> offsets) {
+        return std::adjacent_find(offsets.begin(), offsets.end(), std::greater_equal<size_t>()) == offsets.end() &&
+            (offsets.empty() || offsets.back() < cellCount);
+    };
+    if (!validOffsets(armCells) || !validOffsets(interiorCells)) {
+        throw std::runtime_error(path + " has cell offsets that are unsorted or outside the grid");
+    }
+    std::array<uint64_t, 4> counts{};
+    for (GridType type : cells) {
+        if (type < UNDEFINED || type > EXTERIOR) throw std::runtime_error(path + " has an unknown cell type");
+        counts[type + 1]++;
+    }
+    if (!std::equal(counts.begin(), counts.end(), std::begin(header->typeCounts))) {
+        throw std::runtime_error(path + " has type counts that do not match its cells");
+    }
+}
+
+/*====================================  Getters  =========================================*/
+
+std::vector<std::string> GridFile::getFieldNames() const {
+    std::vector<std::string> names;
+    names.reserve(fields.size());
+    for (const auto& field : fields) names.push_back(field.first);
+    return names;
+}
+
+bool GridFile::hasField(std::string_view name) const {
+    return std::any_of(fields.begin(), fields.end(), [name](const auto& field) { return field.first == name; });
+}
+
+std::span<const double> GridFile::getField(std::string_view name) const {
+    for (const auto& field : fields) {
+        if (field.first == name) return field.second;
+    }
+    throw std::invalid_argument("The grid file has no field " + std::string(name));
+}
+
+/*====================================  Methods  =========================================*/
+
+void GridFile::write(const std::string& path, const FDMGrid& grid, std::span<const GridFileField> fields) {
+    const size_t cellCount = grid.getCells().size();
+    for (size_t f = 0; f < fields.size(); f++) {
+        const std::string_view name = fields[f].name;
+        if (name.empty() || name.size() >= sizeof(GridFileSection::name)) {
+            throw std::invalid_argument("Field names must have 1 to 31 characters");
+        }
+        if (fields[f].values.size() != cellCount) {
+            throw std::invalid_argument("Field " + std::string(name) + " does not have one value per node");
+        }
+        for (size_t g = 0; g < f; g++) {
+            if (fields[g].name == name) throw std::invalid_argument("Field " + std::string(name) + " is stored twice");
+        }
+    }
+
+    std::vector<Payload> payloads = {
+        payload("cells", GridSectionType::CELL_TYPES, sizeof(GridType), grid.getCells().data(), cellCount),
+        payload("arm_cells", GridSectionType::OFFSETS, sizeof(size_t), grid.getArmCells().data(), grid.getArmCells().size()),
+        payload("arms", GridSectionType::ARMS, sizeof(BoundaryArms), grid.getArms().data(), grid.getArms().size()),
+        payload("interior_cells", GridSectionType::OFFSETS, sizeof(size_t), grid.getInteriorCells().data(), grid.getInteriorCells().size())};
+    for (const GridFileField& field : fields) {
+        payloads.push_back(payload(field.name, GridSectionType::FIELD, sizeof(double), field.values.data(), field.values.size()));
+    }
+
+    GridFileHeader header{};
+    std::copy(std::begin(magic), std::end(magic), header.magic);
+    header.version = version;
+    header.byteOrder = byteOrderMark;
+    header.layout = 0;
+    header.sectionCount = static_cast<uint32_t>(payloads.size());
+    header.originX = grid.getOriginX();
+    header.originY = grid.getOriginY();
+    header.dx = grid.getDx();
+    header.dy = grid.getDy();
+    header.nx = grid.getNx();
+    header.ny = grid.getNy();
+    for (GridType type : {UNDEFINED, BOUNDARY, INTERIOR, EXTERIOR}) {
+        header.typeCounts[type + 1] = grid.getCellCount(type);
+    }
+    header.sectionTable = sizeof(GridFileHeader);
+
+    std::vector<GridFileSection> table;
+    uint64_t offset = alignUp(header.sectionTable + payloads.size() * sizeof(GridFileSection));
+    for (Payload& p : payloads) {
+        p.entry.offset = offset;
+        table.push_back(p.entry);
+        offset = alignUp(offset + p.entry.count * p.entry.elementSize);
+    }
+
+    // Header and table first, then every section with one write, padded up to the next section
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create " + temporary);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(GridFileSection)));
+        uint64_t written = sizeof(header) + table.size() * sizeof(GridFileSection);
+        const char padding[sectionAlignment] = {};
+        for (const Payload& p : payloads) {
+            out.write(padding, static_cast<std::streamsize>(p.entry.offset - written));
+            const uint64_t length = p.entry.count * p.entry.elementSize;
+            out.write(static_cast<const char*>(p.data), static_cast<std::streamsize>(length));
+            written = p.entry.offset + length;
+        }
+        out.close();
+        if (!out) {
+            std::filesystem::remove(temporary);
+            throw std::runtime_error("Cannot write " + temporary);
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
@@ -0,0 +1,36 @@
+// HeatAvx2.cpp: compiled with AVX2 enabled, only called after runtime detection
+#include "HeatKernels.h"
+#include <cstring>
+
+#if defined(PDE_SOLVER_X86_SIMD)
+#include <immintrin.h>
+
+void heatRowAvx2(const double* in, size_t stride, const GridType* cells, double* out,
+    int iBegin, int iEnd, const HeatCoefficients& c) {
+    const __m256d cx = _mm256_set1_pd(c.cx), cy = _mm256_set1_pd(c.cy), center = _mm256_set1_pd(c.center);
+    const __m256i interior = _mm256_set1_epi64x(INTERIOR);
+
+    int i = iBegin;
+    for (; i + 4 <= iEnd; i += 4) {
+        int32_t packed;
+        std::memcpy(&packed, cells + i, sizeof(packed));
+        const __m256d mask = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_cvtepi8_epi64(_mm_cvtsi32_si128(packed)), interior));
+
+        const __m256d u = _mm256_loadu_pd(in + i);
+        const __m256d x = _mm256_add_pd(_mm256_loadu_pd(in + i - 1), _mm256_loadu_pd(in + i + 1));
+        const __m256d y = _mm256_add_pd(_mm256_loadu_pd(in + i - stride), _mm256_loadu_pd(in + i + stride));
+        const __m256d updated = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(center, u), _mm256_mul_pd(cx, x)), _mm256_mul_pd(cy, y));
+        _mm256_storeu_pd(out + i, _mm256_blendv_pd(u, updated, mask));
+    }
+
+    heatRowScalar(in, stride, cells, out, i, iEnd, c);
+}
+
+#else
+
+void heatRowAvx2(const double* in, size_t stride, const GridType* cells, double* out,
+    int iBegin, int iEnd, const HeatCoefficients& c) {
+    heatRowScalar(in, stride, cells, out, iBegin, iEnd, c);
+}
+
+#endif
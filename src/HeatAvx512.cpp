@@ -0,0 +1,34 @@
+// HeatAvx512.cpp: compiled with AVX-512F/BW/VL enabled, only called after runtime detection
+#include "HeatKernels.h"
+
+#if defined(PDE_SOLVER_X86_SIMD)
+#include <immintrin.h>
+
+void heatRowAvx512(const double* in, size_t stride, const GridType* cells, double* out,
+    int iBegin, int iEnd, const HeatCoefficients& c) {
+    const __m512d cx = _mm512_set1_pd(c.cx), cy = _mm512_set1_pd(c.cy), center = _mm512_set1_pd(c.center);
+    const __m128i interior = _mm_set1_epi8(INTERIOR);
+
+    int i = iBegin;
+    for (; i + 8 <= iEnd; i += 8) {
+        const __mmask8 mask = static_cast<__mmask8>(_mm_cmpeq_epi8_mask(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(cells + i)), interior));
+
+        const __m512d u = _mm512_loadu_pd(in + i);
+        const __m512d x = _mm512_add_pd(_mm512_loadu_pd(in + i - 1), _mm512_loadu_pd(in + i + 1));
+        const __m512d y = _mm512_add_pd(_mm512_loadu_pd(in + i - stride), _mm512_loadu_pd(in + i + stride));
+        const __m512d updated = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(center, u), _mm512_mul_pd(cx, x)), _mm512_mul_pd(cy, y));
+        _mm512_storeu_pd(out + i, _mm512_mask_blend_pd(mask, u, updated));
+    }
+
+    heatRowScalar(in, stride, cells, out, i, iEnd, c);
+}
+
+#else
+
+void heatRowAvx512(const double* in, size_t stride, const GridType* cells, double* out,
+    int iBegin, int iEnd, const HeatCoefficients& c) {
+    heatRowScalar(in, stride, cells, out, iBegin, iEnd, c);
+}
+
+#endif
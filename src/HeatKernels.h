@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include "FDMGrid.h"
+
+/**
+ * @brief Constant coefficients of the explicit heat update.
+ */
+struct HeatCoefficients {
+    double cx, cy;  // α dt / dx^2 and α dt / dy^2
+    double center;  // 1 - 2 cx - 2 cy
+};
+
+/**
+ * @brief Forward Euler update of one node. Shared by every kernel so they all round
+ * identically: separate multiplies and adds in a fixed order.
+ */
+inline double heatNode(const double* in, size_t stride, int i, const HeatCoefficients& c) {
+    return c.center * in[i] + c.cx * (in[i - 1] + in[i + 1]) + c.cy * (in[i - stride] + in[i + stride]);
+}
+
+/**
+ * @brief Advances cells [iBegin, iEnd) of one row by one step; non-interior cells are copied.
+ * in and out point at the row's node 0, in has the given row stride and cells is the row of
+ * the classification. Also used for the SIMD kernel tails.
+ */
+inline void heatRowScalar(const double* in, size_t stride, const GridType* cells, double* out,
+    int iBegin, int iEnd, const HeatCoefficients& c) {
+    for (int i = iBegin; i < iEnd; i++) {
+        out[i] = cells[i] == INTERIOR ? heatNode(in, stride, i, c) : in[i];
+    }
+}
+
+/// @brief AVX2 row kernel (4 nodes per register), see HeatAvx2.cpp.
+void heatRowAvx2(const double* in, size_t stride, const GridType* cells, double* out,
+    int iBegin, int iEnd, const HeatCoefficients& c);
+
+/// @brief AVX-512 row kernel (8 nodes per register), see HeatAvx512.cpp.
+void heatRowAvx512(const double* in, size_t stride, const GridType* cells, double* out,
+    int iBegin, int iEnd, const HeatCoefficients& c);
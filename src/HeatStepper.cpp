@@ -0,0 +1,139 @@
+#include "HeatStepper.h"
+#include "HeatKernels.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+    // Cells on the grid frame are never interior, so they are copied without reading neighbours
+    inline void heatFrameRow(const double* in, double* out, int iBegin, int iEnd) {
+        std::copy(in + iBegin, in + iEnd, out + iBegin);
+    }
+
+    void heatRowPortable(const double* in, size_t stride, const GridType* cells, double* out,
+        int iBegin, int iEnd, const HeatCoefficients& c) {
+        heatRowScalar(in, stride, cells, out, iBegin, iEnd, c);
+    }
+}
+
+HeatStepper::HeatStepper(const FDMGrid& grid_, double alpha_, double dt_, const HeatTiling& tiling_, SimdLevel level)
+    : grid(grid_), alpha(alpha_), dt(dt_), tiling(tiling_), simdLevel(resolveSimdLevel(level)) {
+    if (!(alpha > 0.0) || !(dt > 0.0)) {
+        throw std::invalid_argument("Diffusivity and time step must be positive");
+    }
+    if (dt > maxStableTimeStep(grid, alpha)) {
+        throw std::invalid_argument("Time step exceeds the explicit stability limit");
+    }
+    if (tiling.tileX <= 0 || tiling.tileY <= 0 || tiling.timeSteps <= 0) {
+        throw std::invalid_argument("Tile dimensions must be positive");
+    }
+}
+
+HeatStepper::RowKernel HeatStepper::rowKernel() const {
+    switch (simdLevel) {
+    case SimdLevel::AVX512:
+        return heatRowAvx512;
+    case SimdLevel::AVX2:
+        return heatRowAvx2;
+    default:
+        return heatRowPortable;
+    }
+}
+
+double HeatStepper::maxStableTimeStep(const FDMGrid& grid, double alpha) {
+    const double cx = 1.0 / (static_cast<double>(grid.getDx()) * grid.getDx());
+    const double cy = 1.0 / (static_cast<double>(grid.getDy()) * grid.getDy());
+    return 1.0 / (2.0 * alpha * (cx + cy));
+}
+
+void HeatStepper::stepNaive(GridField& u, int steps) const {
+    const int nx = grid.getNx(), ny = grid.getNy();
+    const double cx = alpha * dt / (static_cast<double>(grid.getDx()) * grid.getDx());
+    const double cy = alpha * dt / (static_cast<double>(grid.getDy()) * grid.getDy());
+    const HeatCoefficients c{cx, cy, 1.0 - 2.0 * cx - 2.0 * cy};
+    const RowKernel kernel = rowKernel();
+
+    GridField next = u;
+    for (int s = 0; s < steps; s++) {
+        const double* in = u.getValues().data();
+        double* out = next.getValues().data();
+        for (int j = 1; j < ny - 1; j++) {
+            const size_t row = grid.cellIndex(0, j);
+            heatFrameRow(in + row, out + row, 0, 1);
+            kernel(in + row, nx, grid.getCells().data() + row, out + row, 1, nx - 1, c);
+            heatFrameRow(in + row, out + row, nx - 1, nx);
+        }
+        std::swap(u, next);
+    }
+}
+
+void HeatStepper::step(GridField& u, int steps) const {
+    const int nx = grid.getNx(), ny = grid.getNy();
+    const double cx = alpha * dt / (static_cast<double>(grid.getDx()) * grid.getDx());
+    const double cy = alpha * dt / (static_cast<double>(grid.getDy()) * grid.getDy());
+    const HeatCoefficients c{cx, cy, 1.0 - 2.0 * cx - 2.0 * cy};
+    const GridType* cells = grid.getCells().data();
+    const RowKernel kernel = rowKernel();
+
+    const int tilesX = (nx + tiling.tileX - 1) / tiling.tileX;
+    const int tilesY = (ny + tiling.tileY - 1) / tiling.tileY;
+
+    GridField next(nx, ny);
+    for (int done = 0; done < steps; done += tiling.timeSteps) {
+        const int passSteps = std::min(tiling.timeSteps, steps - done);
+        const double* in = u.getValues().data();
+        double* out = next.getValues().data();
+
+        parallelFor(0, tilesX * tilesY, 1, grid.getNumThreads(), [&](int tileBegin, int tileEnd) {
+            std::vector<double> bufferA, bufferB;
+            for (int t = tileBegin; t < tileEnd; t++) {
+                const int i0 = (t % tilesX) * tiling.tileX, i1 = std::min(nx, i0 + tiling.tileX);
+                const int j0 = (t / tilesX) * tiling.tileY, j1 = std::min(ny, j0 + tiling.tileY);
+
+                // Tile plus a halo of passSteps nodes, clipped to the grid
+                const int ei0 = std::max(0, i0 - passSteps), ei1 = std::min(nx, i1 + passSteps);
+                const int ej0 = std::max(0, j0 - passSteps), ej1 = std::min(ny, j1 + passSteps);
+                const int width = ei1 - ei0;
+                bufferA.resize(static_cast<size_t>(width) * (ej1 - ej0));
+                bufferB.resize(bufferA.size());
+
+                for (int j = ej0; j < ej1; j++) {
+                    std::copy(in + grid.cellIndex(ei0, j), in + grid.cellIndex(ei1, j),
+                        bufferA.data() + static_cast<size_t>(j - ej0) * width);
+                }
+
+                // Local node (li, lj) is grid node (ei0 + li, ej0 + lj). After s steps the values
+                // are valid s nodes inside every halo edge that is not the grid frame
+                for (int s = 1; s <= passSteps; s++) {
+                    const int ci0 = ei0 == 0 ? 0 : ei0 + s, ci1 = ei1 == nx ? nx : ei1 - s;
+                    const int cj0 = ej0 == 0 ? 0 : ej0 + s, cj1 = ej1 == ny ? ny : ej1 - s;
+                    const int li0 = ci0 - ei0, li1 = ci1 - ei0;
+                    for (int j = cj0; j < cj1; j++) {
+                        const size_t local = static_cast<size_t>(j - ej0) * width;
+                        const double* rowIn = bufferA.data() + local;
+                        double* rowOut = bufferB.data() + local;
+                        if (j == 0 || j == ny - 1) {
+                            heatFrameRow(rowIn, rowOut, li0, li1);
+                            continue;
+                        }
+                        // Columns 0 and nx - 1 are the frame; the kernel takes the rest in local columns
+                        const int first = std::max(ci0, 1) - ei0, last = std::min(ci1, nx - 1) - ei0;
+                        if (li0 < first) heatFrameRow(rowIn, rowOut, li0, first);
+                        kernel(rowIn, width, cells + grid.cellIndex(ei0, j), rowOut, first, last, c);
+                        if (last < li1) heatFrameRow(rowIn, rowOut, last, li1);
+                    }
+                    std::swap(bufferA, bufferB);
+                }
+
+                for (int j = j0; j < j1; j++) {
+                    const double* local = bufferA.data() + static_cast<size_t>(j - ej0) * width;
+                    std::copy(local + (i0 - ei0), local + (i1 - ei0), out + grid.cellIndex(i0, j));
+                }
+            }
+        });
+        std::swap(u, next);
+    }
+}
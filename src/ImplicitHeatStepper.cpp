@@ -0,0 +1,75 @@
+#include "ImplicitHeatStepper.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double theta(TimeScheme scheme) {
+        return scheme == TimeScheme::BACKWARD_EULER ? 1.0 : 0.5;
+    }
+
+    // σ of the divided system (σI + A) u' = ..., rejecting invalid parameters before the solver is built
+    double shiftOf(double alpha, double dt, TimeScheme scheme, PreconditionerType preconditioner) {
+        if (!(alpha > 0.0) || !(dt > 0.0)) {
+            throw std::invalid_argument("Diffusivity and time step must be positive");
+        }
+        if (preconditioner == PreconditionerType::MULTIGRID) {
+            throw std::invalid_argument("The implicit heat stepper supports NONE, JACOBI and IC0 preconditioners");
+        }
+        return 1.0 / (theta(scheme) * alpha * dt);
+    }
+}
+
+ImplicitHeatStepper::ImplicitHeatStepper(const FDMGrid& grid_, double alpha_, double dt_, TimeScheme scheme_,
+    PreconditionerType preconditioner, const SolverOptions& solverOptions_)
+    : grid(grid_), alpha(alpha_), dt(dt_), scheme(scheme_), solverOptions(solverOptions_),
+    solver(grid_, preconditioner, shiftOf(alpha_, dt_, scheme_, preconditioner)) {
+    const size_t n = solver.getOperator().getUnknownCount();
+    u.resize(n);
+    rhs.resize(n);
+    work.resize(n);
+    coupling.resize(n);
+}
+
+void ImplicitHeatStepper::step(GridField& field, int steps) {
+    const PoissonOperator& op = solver.getOperator();
+    std::span<const size_t> cells = op.getIndexMap().getCells();
+    std::span<double> values = field.getValues();
+    const size_t n = cells.size();
+    const double sigma = op.getShift();
+
+    for (size_t k = 0; k < n; k++) u[k] = values[cells[k]];
+
+    // Dirichlet couplings c of the divided system: c / θ, from the field's current boundary values
+    std::fill(coupling.begin(), coupling.end(), 0.0);
+    const double couplingScale = 1.0 / theta(scheme);
+    for (const BoundaryCoupling& c : op.getBoundaryCouplings()) {
+        const auto [i, j] = grid.pointToIndex(c.location);
+        coupling[c.unknown] += couplingScale * c.weight * field(i, j);
+    }
+
+    for (int s = 0; s < steps; s++) {
+        const Clock::time_point start = Clock::now();
+        if (scheme == TimeScheme::BACKWARD_EULER) {
+            // (σI + A) u' = σu + c
+            for (size_t k = 0; k < n; k++) rhs[k] = sigma * u[k] + coupling[k];
+        }
+        else {
+            // (σI + A) u' = σu - Au + 2c = 2σu - (σI + A)u + 2c
+            op.apply(u, work);
+            for (size_t k = 0; k < n; k++) rhs[k] = 2.0 * sigma * u[k] - work[k] + coupling[k];
+        }
+
+        // u still holds the previous step, which is the initial guess
+        const PcgResult result = solver.solve(rhs, u, solverOptions);
+        if (!result.converged) {
+            throw std::runtime_error("Implicit heat step did not converge");
+        }
+        history.push_back({result.iterations, result.residualNorm,
+            std::chrono::duration<double, std::milli>(Clock::now() - start).count()});
+    }
+
+    for (size_t k = 0; k < n; k++) values[cells[k]] = u[k];
+}
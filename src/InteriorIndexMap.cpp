@@ -0,0 +1,33 @@
+#include "InteriorIndexMap.h"
+#include <algorithm>
+
+InteriorIndexMap::InteriorIndexMap(const FDMGrid& grid) : nx(grid.getNx()), ny(grid.getNy()), cells(grid.getInteriorCells()) {
+    rowOffsets.reserve(static_cast<size_t>(ny) + 1);
+    rowOffsets.push_back(0);
+
+    // The interior offsets are sorted, so a run is a stretch of consecutive offsets within one row
+    size_t k = 0;
+    for (int j = 0; j < ny; j++) {
+        const size_t rowEnd = grid.cellIndex(0, j + 1);
+        while (k < cells.size() && cells[k] < rowEnd) {
+            const size_t first = k;
+            while (k + 1 < cells.size() && cells[k + 1] == cells[k] + 1 && cells[k + 1] < rowEnd) k++;
+            k++;
+            const int iBegin = static_cast<int>(cells[first] - grid.cellIndex(0, j));
+            runs.push_back({iBegin, iBegin + static_cast<int>(k - first), static_cast<int32_t>(first)});
+        }
+        rowOffsets.push_back(static_cast<int32_t>(runs.size()));
+    }
+}
+
+int32_t InteriorIndexMap::unknownAt(int i, int j) const {
+    if (i < 0 || i >= nx || j < 0 || j >= ny) return -1;
+
+    // Last run starting at or before i
+    std::span<const InteriorRun> rowRuns = getRowRuns(j);
+    auto it = std::upper_bound(rowRuns.begin(), rowRuns.end(), i,
+        [](int x, const InteriorRun& run) { return x < run.iBegin; });
+    if (it == rowRuns.begin()) return -1;
+    --it;
+    return i < it->iEnd ? it->firstUnknown + (i - it->iBegin) : -1;
+}
@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    LARGE_INTEGER length{};
+    if (!GetFileSizeEx(file, &length)) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    size = static_cast<size_t>(length.QuadPart);
+    if (size > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+    CloseHandle(file);
+    if (size > 0 && data == nullptr) {
+        release();
+        throw std::runtime_error("Cannot map " + path);
+    }
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat status{};
+    if (::fstat(file, &status) != 0) {
+        ::close(file);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    size = static_cast<size_t>(status.st_size);
+    // A zero-length mapping is an error, so empty files keep a null view
+    if (size > 0) {
+        void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+        data = (address == MAP_FAILED) ? nullptr : static_cast<const std::byte*>(address);
+    }
+    ::close(file);
+    if (size > 0 && data == nullptr) {
+        size = 0;
+        throw std::runtime_error("Cannot map " + path);
+    }
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)) {
+#if defined(_WIN32)
+    mapping = std::exchange(other.mapping, nullptr);
+#endif
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+#if defined(_WIN32)
+        mapping = std::exchange(other.mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() {
+#if defined(_WIN32)
+    if (data != nullptr) UnmapViewOfFile(data);
+    if (mapping != nullptr) CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    if (data != nullptr) ::munmap(const_cast<std::byte*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
@@ -0,0 +1,32 @@
+#include "MpiCommunicator.h"
+#include <stdexcept>
+
+MpiCommunicator::MpiCommunicator(MPI_Comm comm_) : comm(comm_) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+}
+
+void MpiCommunicator::sendReceive(int dest, std::span<const double> sendData, int source,
+    std::span<double> receiveData, int tag) {
+    MPI_Status status;
+    MPI_Sendrecv(sendData.data(), static_cast<int>(sendData.size()), MPI_DOUBLE, dest < 0 ? MPI_PROC_NULL : dest, tag,
+        receiveData.data(), static_cast<int>(receiveData.size()), MPI_DOUBLE, source < 0 ? MPI_PROC_NULL : source, tag,
+        comm, &status);
+    if (source < 0) return;
+
+    int count = 0;
+    MPI_Get_count(&status, MPI_DOUBLE, &count);
+    if (static_cast<size_t>(count) != receiveData.size()) {
+        throw std::runtime_error("Received message size does not match the receive buffer");
+    }
+}
+
+double MpiCommunicator::allreduceSum(double value) {
+    double sum = 0.0;
+    MPI_Allreduce(&value, &sum, 1, MPI_DOUBLE, MPI_SUM, comm);
+    return sum;
+}
+
+void MpiCommunicator::barrier() {
+    MPI_Barrier(comm);
+}
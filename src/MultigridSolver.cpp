@@ -0,0 +1,275 @@
+#include "MultigridSolver.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    double dot(std::span<const double> a, std::span<const double> b) {
+        double sum = 0.0;
+        for (size_t k = 0; k < a.size(); k++) sum += a[k] * b[k];
+        return sum;
+    }
+
+    double norm(std::span<const double> v) {
+        return std::sqrt(dot(v, v));
+    }
+}
+
+MultigridSolver::MultigridSolver(int nx, int ny, Polygon& polygon, const MultigridOptions& options_, unsigned numThreads)
+    : options(options_) {
+    auto addLevel = [&](int levelNx, int levelNy) {
+        Level level;
+        level.grid = std::make_unique<FDMGrid>(levelNx, levelNy, polygon, numThreads);
+        level.op = std::make_unique<PoissonOperator>(*level.grid, 0.0, options.stencil);
+        levels.push_back(std::move(level));
+    };
+
+    addLevel(nx, ny);
+    if (levels.front().op->getUnknownCount() == 0) {
+        throw std::invalid_argument("The grid has no interior cells");
+    }
+
+    // Halve the grid until the problem is small enough for a direct solve
+    while (static_cast<int>(levels.size()) < options.maxLevels
+        && levels.back().op->getUnknownCount() > options.coarsestUnknowns) {
+        const int coarseNx = (levels.back().grid->getNx() - 1) / 2 + 1;
+        const int coarseNy = (levels.back().grid->getNy() - 1) / 2 + 1;
+        if (coarseNx < 3 || coarseNy < 3) break;
+
+        addLevel(coarseNx, coarseNy);
+        if (levels.back().op->getUnknownCount() == 0) {
+            levels.pop_back();
+            break;
+        }
+    }
+
+    for (size_t l = 0; l < levels.size(); l++) {
+        Level& level = levels[l];
+        const size_t n = level.op->getUnknownCount();
+        level.r.resize(n);
+        if (l > 0) {
+            level.x.resize(n);
+            level.b.resize(n);
+        }
+        if (l + 1 < levels.size()) buildTransfer(static_cast<int>(l));
+    }
+    factorCoarsest();
+}
+
+
+/*====================================  Intergrid Transfer  =========================================*/
+
+void MultigridSolver::buildTransfer(int l) {
+    const FDMGrid& fine = *levels[l].grid;
+    const FDMGrid& coarse = *levels[l + 1].grid;
+    const InteriorIndexMap& fineMap = levels[l].op->getIndexMap();
+    const InteriorIndexMap& coarseMap = levels[l + 1].op->getIndexMap();
+    GridTransfer& transfer = levels[l].toCoarse;
+
+    // Both levels span the same bounding box, so coarse coordinates are fine indices scaled by the spacing ratio
+    const double ratioX = static_cast<double>(coarse.getNx() - 1) / (fine.getNx() - 1);
+    const double ratioY = static_cast<double>(coarse.getNy() - 1) / (fine.getNy() - 1);
+    transfer.restrictionScale = ratioX * ratioY;
+
+    const int32_t n = fineMap.getUnknownCount();
+    transfer.coarse.assign(static_cast<size_t>(n) * 4, 0);
+    transfer.weight.assign(static_cast<size_t>(n) * 4, 0.0);
+
+    for (int32_t k = 0; k < n; k++) {
+        const auto [i, j] = fineMap.indexOf(k);
+        const double xi = i * ratioX;
+        const double eta = j * ratioY;
+        const int i0 = std::min(static_cast<int>(xi), coarse.getNx() - 2);
+        const int j0 = std::min(static_cast<int>(eta), coarse.getNy() - 2);
+        const double t = xi - i0;
+        const double s = eta - j0;
+
+        const int ci[4] = {i0, i0 + 1, i0, i0 + 1};
+        const int cj[4] = {j0, j0, j0 + 1, j0 + 1};
+        const double w[4] = {(1 - t) * (1 - s), t * (1 - s), (1 - t) * s, t * s};
+        for (int m = 0; m < 4; m++) {
+            // Boundary and exterior coarse nodes carry no correction
+            const int32_t unknown = w[m] != 0.0 ? coarseMap.unknownAt(ci[m], cj[m]) : -1;
+            if (unknown >= 0) {
+                transfer.coarse[4 * k + m] = unknown;
+                transfer.weight[4 * k + m] = w[m];
+            }
+        }
+    }
+}
+
+void MultigridSolver::restrictResidual(int l) {
+    const GridTransfer& transfer = levels[l].toCoarse;
+    std::span<const double> r = levels[l].r;
+    AlignedVector<double>& b = levels[l + 1].b;
+
+    std::fill(b.begin(), b.end(), 0.0);
+    for (size_t k = 0; k < r.size(); k++) {
+        const double value = transfer.restrictionScale * r[k];
+        for (int m = 0; m < 4; m++) {
+            b[transfer.coarse[4 * k + m]] += transfer.weight[4 * k + m] * value;
+        }
+    }
+}
+
+void MultigridSolver::prolongateCorrection(int l, std::span<double> x) const {
+    const GridTransfer& transfer = levels[l].toCoarse;
+    std::span<const double> e = levels[l + 1].x;
+
+    for (size_t k = 0; k < x.size(); k++) {
+        double correction = 0.0;
+        for (int m = 0; m < 4; m++) {
+            correction += transfer.weight[4 * k + m] * e[transfer.coarse[4 * k + m]];
+        }
+        x[k] += correction;
+    }
+}
+
+
+/*====================================  Coarsest Level  =========================================*/
+
+void MultigridSolver::factorCoarsest() {
+    const PoissonOperator& op = *levels.back().op;
+    const int32_t n = op.getUnknownCount();
+    std::span<const double> diag = op.getDiagonal();
+    std::span<const double> west = op.getWestWeights();
+    std::span<const double> south = op.getSouthWeights();
+    std::span<const int32_t> westIdx = op.getWestIndices();
+    std::span<const int32_t> southIdx = op.getSouthIndices();
+
+    // Row-major numbering puts the west and south neighbours below the diagonal
+    coarseBandwidth = 0;
+    for (int32_t k = 0; k < n; k++) {
+        coarseBandwidth = std::max({coarseBandwidth, k - westIdx[k], k - southIdx[k]});
+    }
+    const int p = coarseBandwidth;
+    coarseFactor.assign(static_cast<size_t>(n) * (p + 1), 0.0);
+    auto at = [&](int32_t row, int32_t col) -> double& { return coarseFactor[static_cast<size_t>(row) * (p + 1) + (row - col)]; };
+
+    for (int32_t k = 0; k < n; k++) {
+        at(k, k) = diag[k];
+        if (west[k] != 0.0) at(k, westIdx[k]) = -west[k];
+        if (south[k] != 0.0) at(k, southIdx[k]) = -south[k];
+    }
+
+    // In-place banded Cholesky A = L L^T
+    for (int32_t k = 0; k < n; k++) {
+        for (int32_t m = std::max(0, k - p); m <= k; m++) {
+            double sum = at(k, m);
+            for (int32_t q = std::max(0, k - p); q < m; q++) sum -= at(k, q) * at(m, q);
+            at(k, m) = m == k ? std::sqrt(sum) : sum / at(m, m);
+        }
+    }
+}
+
+void MultigridSolver::solveCoarsest(std::span<const double> b, std::span<double> x) const {
+    const int32_t n = static_cast<int32_t>(b.size());
+    const int p = coarseBandwidth;
+    auto at = [&](int32_t row, int32_t col) { return coarseFactor[static_cast<size_t>(row) * (p + 1) + (row - col)]; };
+
+    for (int32_t k = 0; k < n; k++) {
+        double sum = b[k];
+        for (int32_t q = std::max(0, k - p); q < k; q++) sum -= at(k, q) * x[q];
+        x[k] = sum / at(k, k);
+    }
+    for (int32_t k = n - 1; k >= 0; k--) {
+        double sum = x[k];
+        for (int32_t q = k + 1; q <= std::min(n - 1, k + p); q++) sum -= at(q, k) * x[q];
+        x[k] = sum / at(k, k);
+    }
+}
+
+
+/*====================================  Cycles  =========================================*/
+
+void MultigridSolver::cycleLevel(int l, MultigridCycle type, std::span<const double> b, std::span<double> x) {
+    if (l + 1 == static_cast<int>(levels.size())) {
+        solveCoarsest(b, x);
+        return;
+    }
+
+    Level& level = levels[l];
+    for (int s = 0; s < options.preSmoothing; s++) level.op->gaussSeidel(b, x);
+
+    level.op->residual(b, x, level.r);
+    restrictResidual(l);
+
+    Level& coarse = levels[l + 1];
+    std::fill(coarse.x.begin(), coarse.x.end(), 0.0);
+    switch (type) {
+        case MultigridCycle::V:
+            cycleLevel(l + 1, MultigridCycle::V, coarse.b, coarse.x);
+            break;
+        case MultigridCycle::W:
+            cycleLevel(l + 1, MultigridCycle::W, coarse.b, coarse.x);
+            cycleLevel(l + 1, MultigridCycle::W, coarse.b, coarse.x);
+            break;
+        case MultigridCycle::F:
+            cycleLevel(l + 1, MultigridCycle::F, coarse.b, coarse.x);
+            cycleLevel(l + 1, MultigridCycle::V, coarse.b, coarse.x);
+            break;
+    }
+    prolongateCorrection(l, x);
+
+    for (int s = 0; s < options.postSmoothing; s++) level.op->gaussSeidel(b, x, true);
+}
+
+void MultigridSolver::cycle(std::span<const double> b, std::span<double> x) {
+    cycleLevel(0, options.cycle, b, x);
+}
+
+SolveResult MultigridSolver::solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& solverOptions) {
+    const PoissonOperator& op = *levels.front().op;
+    const AlignedVector<double> rhs = op.assembleRhs(source, boundaryValue);
+    const size_t n = rhs.size();
+    AlignedVector<double> u(n, 0.0);
+    AlignedVector<double> r(rhs);
+
+    const double bNorm = norm(rhs);
+    const double scale = bNorm > 0.0 ? 1.0 / bNorm : 1.0;
+
+    SolveResult result;
+    result.residualNorm = norm(r) * scale;
+
+    if (!options.krylovAcceleration) {
+        while (result.residualNorm > solverOptions.tolerance && result.iterations < solverOptions.maxIterations) {
+            cycle(rhs, u);
+            op.residual(rhs, u, r);
+            result.residualNorm = norm(r) * scale;
+            result.iterations++;
+        }
+    }
+    else {
+        // Flexible (Polak-Ribiere) conjugate gradients, robust to the slight asymmetry of F-cycles
+        AlignedVector<double> z(n, 0.0), p(n), ap(n), rPrev(n);
+        cycle(r, z);
+        p = z;
+        double rz = dot(r, z);
+        while (result.residualNorm > solverOptions.tolerance && result.iterations < solverOptions.maxIterations) {
+            op.apply(p, ap);
+            const double alpha = rz / dot(p, ap);
+            rPrev = r;
+            for (size_t k = 0; k < n; k++) {
+                u[k] += alpha * p[k];
+                r[k] -= alpha * ap[k];
+            }
+            result.residualNorm = norm(r) * scale;
+            result.iterations++;
+            if (result.residualNorm <= solverOptions.tolerance) break;
+
+            std::fill(z.begin(), z.end(), 0.0);
+            cycle(r, z);
+            double rzNext = 0.0, zDelta = 0.0;
+            for (size_t k = 0; k < n; k++) {
+                rzNext += r[k] * z[k];
+                zDelta += z[k] * (r[k] - rPrev[k]);
+            }
+            const double beta = zDelta / rz;
+            for (size_t k = 0; k < n; k++) p[k] = z[k] + beta * p[k];
+            rz = rzNext;
+        }
+    }
+
+    result.converged = result.residualNorm <= solverOptions.tolerance;
+    result.field = op.toField(u, boundaryValue);
+    return result;
+}
@@ -0,0 +1,67 @@
+#include "PackedCells.h"
+#include "Parallel.h"
+
+namespace {
+    // Rows per tile when packing; a row of a large grid is already several kilobytes
+    constexpr int minRowsPerTile = 16;
+}
+
+PackedCells::PackedCells(const FDMGrid& grid)
+    : originX(grid.getFullOriginX()), originY(grid.getFullOriginY()), dx(grid.getDx()), dy(grid.getDy()),
+      nx(grid.getNx()), ny(grid.getNy()), iOffset(grid.getIOffset()), jOffset(grid.getJOffset()),
+      wordsPerRow((grid.getNx() + 63) / 64) {
+    const int tailBits = nx % 64;
+    tailMask = tailBits == 0 ? ~uint64_t{0} : (uint64_t{1} << tailBits) - 1;
+    low.assign(static_cast<size_t>(wordsPerRow) * ny, 0);
+    high.assign(low.size(), 0);
+
+    parallelFor(0, ny, minRowsPerTile, grid.getNumThreads(), [&](int jBegin, int jEnd) {
+        for (int j = jBegin; j < jEnd; j++) {
+            std::span<const GridType> row = grid.getRow(j);
+            for (int word = 0; word < wordsPerRow; word++) {
+                const int first = word * 64;
+                const int last = std::min(nx, first + 64);
+                uint64_t bit0 = 0, bit1 = 0;
+                for (int i = first; i < last; i++) {
+                    const uint64_t code = static_cast<uint8_t>(row[i]) & 3u;
+                    bit0 |= (code & 1) << (i - first);
+                    bit1 |= (code >> 1) << (i - first);
+                }
+                low[static_cast<size_t>(j) * wordsPerRow + word] = bit0;
+                high[static_cast<size_t>(j) * wordsPerRow + word] = bit1;
+            }
+        }
+    });
+}
+
+GridType PackedCells::getCellType(int i, int j) const {
+    if (i < 0 || i >= nx || j < 0 || j >= ny) return EXTERIOR;
+    const size_t k = static_cast<size_t>(j) * wordsPerRow + i / 64;
+    const int code = static_cast<int>(((low[k] >> (i % 64)) & 1) | (((high[k] >> (i % 64)) & 1) << 1));
+    return code == 3 ? UNDEFINED : static_cast<GridType>(code);
+}
+
+size_t PackedCells::count(GridType type) const {
+    size_t total = 0;
+    for (int j = 0; j < ny; j++) {
+        for (int word = 0; word < wordsPerRow; word++) {
+            total += static_cast<size_t>(std::popcount(typeMask(j, word, type)));
+        }
+    }
+    return total;
+}
+
+std::vector<Point2D> PackedCells::getPointsOfType(GridType type) const {
+    std::vector<Point2D> points;
+    points.reserve(count(type));
+    forEachOfType(type, [&](int i, int j) { points.push_back({originX + (i + iOffset) * dx, originY + (j + jOffset) * dy}); });
+    return points;
+}
+
+AlignedVector<GridType> PackedCells::unpack() const {
+    AlignedVector<GridType> cells(static_cast<size_t>(nx) * ny);
+    for (int j = 0; j < ny; j++) {
+        for (int i = 0; i < nx; i++) cells[static_cast<size_t>(j) * nx + i] = getCellType(i, j);
+    }
+    return cells;
+}
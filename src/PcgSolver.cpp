@@ -0,0 +1,142 @@
+#include "PcgSolver.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Entries per tile of the vector kernels; fixed, so reductions do not depend on the thread count
+    constexpr int entriesPerTile = 8192;
+
+    double sum(double a, double b) {
+        return a + b;
+    }
+
+    double dot(std::span<const double> a, std::span<const double> b, unsigned numThreads) {
+        return parallelReduce(0, static_cast<int>(a.size()), entriesPerTile, numThreads, 0.0, [&](int first, int last) {
+            double partial = 0.0;
+            for (int k = first; k < last; k++) partial += a[k] * b[k];
+            return partial;
+        }, sum);
+    }
+}
+
+PcgSolver::PcgSolver(const FDMGrid& grid, PreconditionerType type_, double shift) : type(type_) {
+    if (type == PreconditionerType::MULTIGRID) {
+        throw std::invalid_argument("The multigrid preconditioner needs the polygon to build its hierarchy");
+    }
+    ownedOperator = std::make_unique<PoissonOperator>(grid, shift);
+    op = ownedOperator.get();
+    buildPreconditioner();
+}
+
+PcgSolver::PcgSolver(int nx, int ny, Polygon& polygon, PreconditionerType type_,
+    const MultigridOptions& multigridOptions, unsigned numThreads) : type(type_) {
+    if (type != PreconditionerType::MULTIGRID) {
+        ownedGrid = std::make_unique<FDMGrid>(nx, ny, polygon, numThreads);
+        ownedOperator = std::make_unique<PoissonOperator>(*ownedGrid);
+        op = ownedOperator.get();
+        buildPreconditioner();
+        return;
+    }
+
+    // The hierarchy's finest level is the problem; building the levels is the setup cost
+    const Clock::time_point start = Clock::now();
+    multigrid = std::make_unique<MultigridSolver>(nx, ny, polygon, multigridOptions, numThreads);
+    op = &multigrid->getOperator();
+    buildPreconditioner();
+    setupMilliseconds = millisecondsSince(start);
+}
+
+void PcgSolver::buildPreconditioner() {
+    const Clock::time_point start = Clock::now();
+    switch (type) {
+    case PreconditionerType::NONE:
+        preconditioner = std::make_unique<IdentityPreconditioner>();
+        break;
+    case PreconditionerType::JACOBI:
+        preconditioner = std::make_unique<JacobiPreconditioner>(*op);
+        break;
+    case PreconditionerType::IC0:
+        preconditioner = std::make_unique<IncompleteCholesky>(CsrMatrix(*op));
+        break;
+    case PreconditionerType::MULTIGRID:
+        preconditioner = std::make_unique<MultigridPreconditioner>(*multigrid);
+        break;
+    }
+    setupMilliseconds = millisecondsSince(start);
+}
+
+void PcgSolver::setPreconditioner(std::unique_ptr<Preconditioner> preconditioner_) {
+    preconditioner = std::move(preconditioner_);
+    setupMilliseconds = 0.0;
+}
+
+PcgResult PcgSolver::solve(std::span<const double> b, std::span<double> x, const SolverOptions& options) {
+    const Clock::time_point start = Clock::now();
+    const size_t n = b.size();
+    AlignedVector<double> r(n), z(n), p(n), ap(n);
+    AlignedVector<double> rPrev(preconditioner->isSymmetric() ? 0 : n);
+
+    PcgResult result;
+    result.setupMilliseconds = setupMilliseconds;
+
+    op->residual(b, x, r);
+    const unsigned numThreads = op->getGrid().getNumThreads();
+    const double bNorm = std::sqrt(dot(b, b, numThreads));
+    const double scale = bNorm > 0.0 ? 1.0 / bNorm : 1.0;
+    double rr = dot(r, r, numThreads);
+    result.residualNorm = std::sqrt(rr) * scale;
+    result.history.push_back({result.residualNorm, millisecondsSince(start)});
+
+    double rz = preconditioner->applyDot(r, z);
+    p = z;
+    while (result.residualNorm > options.tolerance && result.iterations < options.maxIterations) {
+        const double alpha = rz / op->applyDot(p, ap);
+
+        // x += alpha p and r -= alpha Ap in one pass, accumulating the new r·r
+        rr = parallelReduce(0, static_cast<int>(n), entriesPerTile, numThreads, 0.0, [&](int first, int last) {
+            double partial = 0.0;
+            if (!rPrev.empty()) std::copy(r.begin() + first, r.begin() + last, rPrev.begin() + first);
+            for (int k = first; k < last; k++) {
+                x[k] += alpha * p[k];
+                r[k] -= alpha * ap[k];
+                partial += r[k] * r[k];
+            }
+            return partial;
+        }, sum);
+
+        result.iterations++;
+        result.residualNorm = std::sqrt(rr) * scale;
+        result.history.push_back({result.residualNorm, millisecondsSince(start)});
+        if (result.residualNorm <= options.tolerance) break;
+
+        const double rzNext = preconditioner->applyDot(r, z);
+        // Flexible update: beta = z·(r - rPrev) / rz, which equals rzNext / rz for a symmetric M
+        const double beta = (rPrev.empty() ? rzNext : rzNext - dot(z, rPrev, numThreads)) / rz;
+        parallelFor(0, static_cast<int>(n), entriesPerTile, numThreads, [&](int first, int last) {
+            for (int k = first; k < last; k++) p[k] = z[k] + beta * p[k];
+        });
+        rz = rzNext;
+    }
+
+    result.converged = result.residualNorm <= options.tolerance;
+    result.solveMilliseconds = millisecondsSince(start);
+    return result;
+}
+
+PcgResult PcgSolver::solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& options) {
+    const AlignedVector<double> rhs = op->assembleRhs(source, boundaryValue);
+    AlignedVector<double> u(rhs.size(), 0.0);
+
+    PcgResult result = solve(rhs, u, options);
+    result.field = op->toField(u, boundaryValue);
+    return result;
+}
@@ -1,4 +1,8 @@
 #include "Point2D.h"
+#include <type_traits>
+
+// Vertex arrays are copied and loaded from files with memcpy
+static_assert(std::is_trivially_copyable_v<Point2D>);
 
 
 
@@ -16,8 +20,6 @@ const Point2D Point2D::down{0, -1};
 
 Point2D::Point2D(float x_, float y_) : x{ x_ }, y{ y_ } {}
 
-Point2D::Point2D(const Point2D &point): x{point.x}, y{point.y} {}
-
 Point2D::Point2D(const std::pair<float,float>& coords): x{coords.first}, y{coords.second} {}
 
 Point2D::Point2D(const std::vector<float> &coords)
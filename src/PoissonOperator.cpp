@@ -0,0 +1,145 @@
+#include "PoissonOperator.h"
+#include "Parallel.h"
+#include <algorithm>
+
+namespace {
+    // Shortest arm used by the Shortley-Weller stencil, so a node lying on an edge keeps a finite weight
+    constexpr double minArm = 1e-3;
+
+    // Unknowns per tile of the parallel kernels; fixed, so reductions do not depend on the thread count
+    constexpr int unknownsPerTile = 8192;
+}
+
+PoissonOperator::PoissonOperator(const FDMGrid& grid_, double shift_, BoundaryStencil stencil_)
+    : grid(grid_), indexMap(grid_), shift(shift_), stencil(stencil_) {
+    const int32_t n = indexMap.getUnknownCount();
+    const double cx = 1.0 / (static_cast<double>(grid.getDx()) * grid.getDx());
+    const double cy = 1.0 / (static_cast<double>(grid.getDy()) * grid.getDy());
+
+    diag.assign(n, 2.0 * cx + 2.0 * cy + shift);
+    west.resize(n);
+    east.resize(n);
+    south.resize(n);
+    north.resize(n);
+    westIdx.resize(n);
+    eastIdx.resize(n);
+    southIdx.resize(n);
+    northIdx.resize(n);
+
+    // Connects unknown k to the neighbour (i + di, j + dj): another unknown, or a Dirichlet value moved to the
+    // right-hand side, sampled at the neighbouring node or at the end of the node's arm
+    auto link = [this](int32_t k, int i, int j, int di, int dj, double weight, float arm, double& w, int32_t& idx) {
+        const int32_t neighbour = indexMap.unknownAt(i + di, j + dj);
+        if (neighbour >= 0) {
+            w = weight;
+            idx = neighbour;
+            return;
+        }
+        w = 0.0;
+        idx = k;
+        couplings.push_back(dirichletCoupling(grid, stencil, k, i, j, di, dj, weight, arm));
+        diag[k] += couplings.back().weight - weight;
+    };
+
+    for (int32_t k = 0; k < n; k++) {
+        const auto [i, j] = indexMap.indexOf(k);
+        const BoundaryArms arms = stencil == BoundaryStencil::SHORTLEY_WELLER ? grid.getBoundaryArms(i, j) : BoundaryArms{};
+        link(k, i, j, -1, 0, cx, arms.west, west[k], westIdx[k]);
+        link(k, i, j, 1, 0, cx, arms.east, east[k], eastIdx[k]);
+        link(k, i, j, 0, -1, cy, arms.south, south[k], southIdx[k]);
+        link(k, i, j, 0, 1, cy, arms.north, north[k], northIdx[k]);
+    }
+}
+
+BoundaryCoupling PoissonOperator::dirichletCoupling(const FDMGrid& grid, BoundaryStencil stencil, int32_t k, int i, int j,
+    int di, int dj, double weight, float arm) {
+    if (stencil == BoundaryStencil::SNAPPED) {
+        return {k, grid.indexToPoint(i + di, j + dj), weight};
+    }
+    const double theta = std::max(minArm, static_cast<double>(arm));
+    const Point2D node = grid.indexToPoint(i, j);
+    const Point2D end(static_cast<float>(node.x + di * theta * grid.getDx()), static_cast<float>(node.y + dj * theta * grid.getDy()));
+    return {k, end, weight / theta};
+}
+
+void PoissonOperator::apply(std::span<const double> x, std::span<double> y) const {
+    parallelFor(0, indexMap.getUnknownCount(), unknownsPerTile, grid.getNumThreads(), [&](int32_t first, int32_t last) {
+        for (int32_t k = first; k < last; k++) {
+            y[k] = diag[k] * x[k]
+                - west[k] * x[westIdx[k]] - east[k] * x[eastIdx[k]]
+                - south[k] * x[southIdx[k]] - north[k] * x[northIdx[k]];
+        }
+    });
+}
+
+double PoissonOperator::applyDot(std::span<const double> x, std::span<double> y) const {
+    return parallelReduce(0, indexMap.getUnknownCount(), unknownsPerTile, grid.getNumThreads(), 0.0,
+        [&](int32_t first, int32_t last) {
+            double sum = 0.0;
+            for (int32_t k = first; k < last; k++) {
+                y[k] = diag[k] * x[k]
+                    - west[k] * x[westIdx[k]] - east[k] * x[eastIdx[k]]
+                    - south[k] * x[southIdx[k]] - north[k] * x[northIdx[k]];
+                sum += x[k] * y[k];
+            }
+            return sum;
+        },
+        [](double a, double b) { return a + b; });
+}
+
+void PoissonOperator::residual(std::span<const double> b, std::span<const double> x, std::span<double> r) const {
+    parallelFor(0, indexMap.getUnknownCount(), unknownsPerTile, grid.getNumThreads(), [&](int32_t first, int32_t last) {
+        for (int32_t k = first; k < last; k++) {
+            r[k] = b[k] - diag[k] * x[k]
+                + west[k] * x[westIdx[k]] + east[k] * x[eastIdx[k]]
+                + south[k] * x[southIdx[k]] + north[k] * x[northIdx[k]];
+        }
+    });
+}
+
+void PoissonOperator::gaussSeidel(std::span<const double> b, std::span<double> x, bool reverse) const {
+    const int32_t n = indexMap.getUnknownCount();
+    // A Dirichlet neighbour points at k itself with weight 0, so it drops out of the update
+    auto update = [&](int32_t k) {
+        x[k] = (b[k] + west[k] * x[westIdx[k]] + east[k] * x[eastIdx[k]]
+            + south[k] * x[southIdx[k]] + north[k] * x[northIdx[k]]) / diag[k];
+    };
+    if (reverse) {
+        for (int32_t k = n - 1; k >= 0; k--) update(k);
+    }
+    else {
+        for (int32_t k = 0; k < n; k++) update(k);
+    }
+}
+
+AlignedVector<double> PoissonOperator::assembleRhs(const ScalarFunction& source, const ScalarFunction& boundaryValue) const {
+    const int32_t n = indexMap.getUnknownCount();
+    AlignedVector<double> rhs(n);
+    for (int32_t k = 0; k < n; k++) {
+        const auto [i, j] = indexMap.indexOf(k);
+        rhs[k] = source(grid.indexToPoint(i, j));
+    }
+    for (const BoundaryCoupling& coupling : couplings) {
+        rhs[coupling.unknown] += coupling.weight * boundaryValue(coupling.location);
+    }
+    return rhs;
+}
+
+GridField PoissonOperator::toField(std::span<const double> u, const ScalarFunction& boundaryValue) const {
+    GridField field(grid.getNx(), grid.getNy());
+    for (int j = 0; j < grid.getNy(); j++) {
+        std::span<const GridType> row = grid.getRow(j);
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (row[i] == BOUNDARY) {
+                field(i, j) = boundaryValue(grid.indexToPoint(i, j));
+            }
+        }
+    }
+
+    std::span<const size_t> cells = indexMap.getCells();
+    std::span<double> values = field.getValues();
+    for (size_t k = 0; k < cells.size(); k++) {
+        values[cells[k]] = u[k];
+    }
+    return field;
+}
@@ -0,0 +1,56 @@
+#include "PoissonSolver.h"
+#include <cmath>
+
+namespace {
+    double dot(std::span<const double> a, std::span<const double> b) {
+        double sum = 0.0;
+        for (size_t k = 0; k < a.size(); k++) sum += a[k] * b[k];
+        return sum;
+    }
+
+    // Unpreconditioned conjugate gradients on the SPD operator, x holds the initial guess
+    void conjugateGradient(const PoissonOperator& op, std::span<const double> b, std::span<double> x,
+        const SolverOptions& options, SolveResult& result) {
+        const size_t n = b.size();
+        AlignedVector<double> r(n), p(n), ap(n);
+
+        op.apply(x, ap);
+        for (size_t k = 0; k < n; k++) r[k] = b[k] - ap[k];
+        p = r;
+
+        const double bNorm = std::sqrt(dot(b, b));
+        const double scale = bNorm > 0.0 ? 1.0 / bNorm : 1.0;
+        double rr = dot(r, r);
+
+        int iteration = 0;
+        while (std::sqrt(rr) * scale > options.tolerance && iteration < options.maxIterations) {
+            op.apply(p, ap);
+            const double alpha = rr / dot(p, ap);
+            for (size_t k = 0; k < n; k++) {
+                x[k] += alpha * p[k];
+                r[k] -= alpha * ap[k];
+            }
+            const double rrNext = dot(r, r);
+            const double beta = rrNext / rr;
+            for (size_t k = 0; k < n; k++) p[k] = r[k] + beta * p[k];
+            rr = rrNext;
+            iteration++;
+        }
+
+        result.iterations = iteration;
+        result.residualNorm = std::sqrt(rr) * scale;
+        result.converged = result.residualNorm <= options.tolerance;
+    }
+}
+
+PoissonSolver::PoissonSolver(const FDMGrid& grid, BoundaryStencil stencil) : op(grid, 0.0, stencil) {}
+
+SolveResult PoissonSolver::solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& options) const {
+    const AlignedVector<double> rhs = op.assembleRhs(source, boundaryValue);
+    AlignedVector<double> u(rhs.size(), 0.0);
+
+    SolveResult result;
+    conjugateGradient(op, rhs, u, options, result);
+    result.field = op.toField(u, boundaryValue);
+    return result;
+}
@@ -1,15 +1,93 @@
 // Polygon.cpp
 #include "Polygon.h"
+#include "PolygonKernels.h"
 #include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
 
 /*==================================  Helper Functions  =========================================*/
 
 namespace {
-    // Helper function for orientation check
+    // Error-free transformations used by the exact orientation fallback (Shewchuk, 1997)
+    inline void twoSum(double a, double b, double& sum, double& err) {
+        sum = a + b;
+        const double bVirtual = sum - a;
+        err = (a - (sum - bVirtual)) + (b - bVirtual);
+    }
+
+    inline void twoProduct(double a, double b, double& product, double& err) {
+        product = a * b;
+        err = std::fma(a, b, -product);
+    }
+
+    // Nonoverlapping floating-point expansion whose components sum exactly to the represented value
+    struct Expansion {
+        double components[64];
+        int size = 0;
+
+        // Grow-Expansion with zero elimination
+        void add(double b) {
+            double q = b;
+            int k = 0;
+            for (int i = 0; i < size; i++) {
+                double sum, err;
+                twoSum(q, components[i], sum, err);
+                if (err != 0.0) components[k++] = err;
+                q = sum;
+            }
+            components[k++] = q;
+            size = k;
+        }
+
+        // Components increase in magnitude, so the sign is that of the largest nonzero one
+        int sign() const {
+            for (int i = size - 1; i >= 0; i--) {
+                if (components[i] != 0.0) return components[i] > 0.0 ? 1 : -1;
+            }
+            return 0;
+        }
+    };
+
+    // Exact sign of the cross product (q - p) x (r - p): 1 counterclockwise, -1 clockwise, 0 collinear
+    int orient2d(const Point2D& p, const Point2D& q, const Point2D& r) {
+        const double acx = static_cast<double>(q.x) - p.x, acy = static_cast<double>(q.y) - p.y;
+        const double bcx = static_cast<double>(r.x) - p.x, bcy = static_cast<double>(r.y) - p.y;
+        const double detLeft = acx * bcy;
+        const double detRight = acy * bcx;
+        const double det = detLeft - detRight;
+
+        // Fast path: the rounded determinant is certainly on the right side of zero
+        const double errBound = 3.3306690738754716e-16 * (std::abs(detLeft) + std::abs(detRight));
+        if (det > errBound) return 1;
+        if (det < -errBound) return -1;
+
+        // Slow path: exact differences and products summed as an expansion
+        double ax[2], ay[2], bx[2], by[2];
+        twoSum(q.x, -static_cast<double>(p.x), ax[0], ax[1]);
+        twoSum(q.y, -static_cast<double>(p.y), ay[0], ay[1]);
+        twoSum(r.x, -static_cast<double>(p.x), bx[0], bx[1]);
+        twoSum(r.y, -static_cast<double>(p.y), by[0], by[1]);
+
+        Expansion exact;
+        for (int i = 0; i < 2; i++) {
+            for (int k = 0; k < 2; k++) {
+                double product, err;
+                twoProduct(ax[i], by[k], product, err);
+                exact.add(product);
+                exact.add(err);
+                twoProduct(-ay[i], bx[k], product, err);
+                exact.add(product);
+                exact.add(err);
+            }
+        }
+        return exact.sign();
+    }
+
+    // Helper function for orientation check: 1 clockwise, 2 counterclockwise, 0 collinear
     int orientation(const Point2D& p, const Point2D& q, const Point2D& r) {
-        const double val = (q.y - p.y) * (r.x - q.x) -
-            (q.x - p.x) * (r.y - q.y);
-        return (val > 1e-9) ? 1 : (val < -1e-9) ? 2 : 0;
+        const int sign = orient2d(p, q, r);
+        return (sign < 0) ? 1 : (sign > 0) ? 2 : 0;
     }
 
     // Helper function to check if point lies on segment
@@ -39,16 +117,205 @@ namespace {
     
         return false;
     }
+
+    // Lexicographic (x, then y) order of the sweep
+    bool sweepLess(const Point2D& a, const Point2D& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    }
+
+    // Polygon edge with its endpoints in sweep order
+    struct SweepSegment {
+        Point2D left, right;
+        int edge;
+    };
+
+    // Vertical order of two segments that are both cut by the sweep line and do not cross,
+    // decided by orientation against the segment that entered the sweep first
+    struct SweepSegmentBelow {
+        const std::vector<SweepSegment>* segments;
+
+        bool operator()(int ia, int ib) const {
+            if (ia == ib) return false;
+            const SweepSegment& a = (*segments)[ia];
+            const SweepSegment& b = (*segments)[ib];
+
+            if (sweepLess(a.left, b.left)) {
+                int o = orient2d(a.left, a.right, b.left);
+                if (o == 0) o = orient2d(a.left, a.right, b.right);
+                return o != 0 ? o > 0 : ia < ib;
+            }
+            int o = orient2d(b.left, b.right, a.left);
+            if (o == 0) o = orient2d(b.left, b.right, a.right);
+            return o != 0 ? o < 0 : ia < ib;
+        }
+    };
+
+    // Edges of one or more closed rings, numbered ring by ring; edge e runs from vertex e to the
+    // next vertex of its ring
+    class RingEdges {
+    private:
+        std::vector<Point2D> points;  // Vertices of all rings, concatenated
+        std::vector<int> next;        // Index of the end vertex of each edge
+
+    public:
+        explicit RingEdges(const std::vector<std::span<const Point2D>>& rings) {
+            for (std::span<const Point2D> ring : rings) {
+                const int start = static_cast<int>(points.size());
+                const int n = static_cast<int>(ring.size());
+                points.insert(points.end(), ring.begin(), ring.end());
+                for (int v = 0; v < n; v++) next.push_back(start + (v + 1) % n);
+            }
+        }
+
+        int size() const { return static_cast<int>(points.size()); }
+        const Point2D& from(int e) const { return points[e]; }
+        const Point2D& to(int e) const { return points[next[e]]; }
+
+        // Edges sharing a vertex of the same ring
+        bool adjacent(int a, int b) const { return next[a] == b || next[b] == a; }
+    };
+
+    void throwIfIntersecting(const RingEdges& edges, int ia, int ib) {
+        if (edges.adjacent(ia, ib)) return;
+        if (edgesIntersect(edges.from(ia), edges.to(ia), edges.from(ib), edges.to(ib))) {
+            throw std::invalid_argument("Self-intersection detected");
+        }
+    }
+
+    // O(n^2) check of every pair of non-adjacent edges
+    void validateBruteForce(const RingEdges& edges) {
+        for (int i = 0; i < edges.size(); ++i) {
+            for (int j = i + 1; j < edges.size(); ++j) {
+                throwIfIntersecting(edges, i, j);
+            }
+        }
+    }
+
+    // Shamos-Hoey sweep over all edges of all rings at once
+    void validateSweepLine(const std::vector<std::span<const Point2D>>& rings) {
+        // Zero-length edges and spikes (an edge folding back over its predecessor) make adjacent edges overlap,
+        // which the sweep order cannot represent. With four or more vertices they always touch a non-adjacent edge
+        for (std::span<const Point2D> ring : rings) {
+            const int n = static_cast<int>(ring.size());
+            if (n < 4) continue;
+            for (int i = 0; i < n; i++) {
+                const Point2D& prev = ring[(i + n - 1) % n];
+                const Point2D& curr = ring[i];
+                const Point2D& next = ring[(i + 1) % n];
+                const bool zeroLength = curr == next;
+                const bool foldsBack = orient2d(prev, curr, next) == 0 &&
+                    (static_cast<double>(curr.x) - prev.x) * (static_cast<double>(next.x) - curr.x) +
+                    (static_cast<double>(curr.y) - prev.y) * (static_cast<double>(next.y) - curr.y) < 0.0;
+                if (zeroLength || foldsBack) {
+                    throw std::invalid_argument("Self-intersection detected");
+                }
+            }
+        }
+
+        const RingEdges edges(rings);
+        const int n = edges.size();
+        std::vector<SweepSegment> segments(n);
+        for (int i = 0; i < n; i++) {
+            const Point2D& a = edges.from(i);
+            const Point2D& b = edges.to(i);
+            segments[i] = sweepLess(b, a) ? SweepSegment{b, a, i} : SweepSegment{a, b, i};
+        }
+
+        // Events: 2 * edge for the left endpoint (insert), 2 * edge + 1 for the right endpoint (remove).
+        // At a shared point insertions come first so segments touching at an endpoint meet in the status
+        std::vector<int> events(2 * n);
+        for (int e = 0; e < 2 * n; e++) events[e] = e;
+        auto eventPoint = [&segments](int e) -> const Point2D& {
+            return (e & 1) ? segments[e >> 1].right : segments[e >> 1].left;
+        };
+        std::sort(events.begin(), events.end(), [&eventPoint](int a, int b) {
+            const Point2D& pa = eventPoint(a);
+            const Point2D& pb = eventPoint(b);
+            if (sweepLess(pa, pb)) return true;
+            if (sweepLess(pb, pa)) return false;
+            return (a & 1) < (b & 1);
+        });
+
+        // Status: segments cut by the sweep line ordered bottom to top
+        using Status = std::set<int, SweepSegmentBelow>;
+        Status status(SweepSegmentBelow{&segments});
+        std::vector<Status::iterator> position(n, status.end());
+
+        for (int e : events) {
+            const int seg = e >> 1;
+            if ((e & 1) == 0) {
+                const Status::iterator it = status.insert(seg).first;
+                position[seg] = it;
+                if (it != status.begin()) throwIfIntersecting(edges, *std::prev(it), seg);
+                if (std::next(it) != status.end()) throwIfIntersecting(edges, seg, *std::next(it));
+            }
+            else {
+                const Status::iterator it = position[seg];
+                if (it != status.begin() && std::next(it) != status.end()) {
+                    throwIfIntersecting(edges, *std::prev(it), *std::next(it));
+                }
+                status.erase(it);
+            }
+        }
+    }
+
+    // Tests the edges next to moved vertices against every edge whose bounding box overlaps theirs.
+    // Pairs of unmoved edges were already disjoint; spikes and zero-length edges with four or more
+    // vertices touch a non-adjacent edge next to the moved one, so brute force over these pairs is complete
+    void validateMovedEdges(const std::vector<Point2D>& vertices, const std::vector<int>& moved) {
+        const int n = static_cast<int>(vertices.size());
+        auto from = [&](int e) -> const Point2D& { return vertices[e]; };
+        auto to = [&](int e) -> const Point2D& { return vertices[(e + 1) % n]; };
+        auto overlaps = [&](int a, int b) {
+            return std::max(from(a).x, to(a).x) >= std::min(from(b).x, to(b).x) &&
+                std::max(from(b).x, to(b).x) >= std::min(from(a).x, to(a).x) &&
+                std::max(from(a).y, to(a).y) >= std::min(from(b).y, to(b).y) &&
+                std::max(from(b).y, to(b).y) >= std::min(from(a).y, to(a).y);
+        };
+
+        float minX = from(moved.front()).x, maxX = minX, minY = from(moved.front()).y, maxY = minY;
+        for (int e : moved) {
+            for (const Point2D& p : {from(e), to(e)}) {
+                minX = std::min(minX, p.x);
+                maxX = std::max(maxX, p.x);
+                minY = std::min(minY, p.y);
+                maxY = std::max(maxY, p.y);
+            }
+        }
+        std::vector<int> near;
+        for (int e = 0; e < n; e++) {
+            if (std::max(from(e).x, to(e).x) >= minX && std::min(from(e).x, to(e).x) <= maxX &&
+                std::max(from(e).y, to(e).y) >= minY && std::min(from(e).y, to(e).y) <= maxY) {
+                near.push_back(e);
+            }
+        }
+
+        for (int a : moved) {
+            for (int b : near) {
+                if (a == b || (a + 1) % n == b || (b + 1) % n == a || !overlaps(a, b)) continue;
+                if (edgesIntersect(from(a), to(a), from(b), to(b))) {
+                    throw std::invalid_argument("Self-intersection detected");
+                }
+            }
+        }
+    }
 }
 
 /*====================================  Constructors  =========================================*/
 
-Polygon::Polygon(const std::vector<Point2D>& verts) : vertices(verts) {
+Polygon::Polygon(std::vector<Point2D> verts, ValidationMethod method) : vertices(std::move(verts)) {
     if (vertices.size() < 3) {
         throw std::invalid_argument("Polygon requires at least 3 vertices");
     }
-    validatePolygon();
+    validatePolygon(method);
+    prepare();
+}
+
+Polygon::Polygon(std::vector<Point2D> verts, Prevalidated) : vertices(std::move(verts)) {
+    prepare();
+}
 
+void Polygon::prepare() {
     // Calculate bounding box (minX, minY, maxX, maxY)
     auto minmaxX = std::minmax_element(vertices.begin(), vertices.end(),
         [](const Point2D& a, const Point2D& b) { return a.x < b.x; });
@@ -59,95 +326,193 @@ Polygon::Polygon(const std::vector<Point2D>& verts) : vertices(verts) {
         [](const Point2D& a, const Point2D& b) { return a.y < b.y; });
     minY = minmaxY.first->y;
     maxY = minmaxY.second->y;
+
+    // Precompute the edge arrays used by the ray-casting queries
+    const size_t n = vertices.size();
+    edges.x.resize(n);
+    edges.y.resize(n);
+    edges.yPrev.resize(n);
+    edges.slope.resize(n);
+    for (size_t i = 0, j = n - 1; i < n; j = i++) {
+        edges.x[i] = vertices[i].x;
+        edges.y[i] = vertices[i].y;
+        edges.yPrev[i] = vertices[j].y;
+        edges.slope[i] = (vertices[j].y != vertices[i].y) ? (vertices[j].x - vertices[i].x) / (vertices[j].y - vertices[i].y) : 0.f;
+    }
 }
 
 /*=================================  Other Methods   ==============================================*/
 
 bool Polygon::containsPoint(const Point2D& point) const
 {
-    // Check first if the point is within the bounding box of the polygon
-    if (point.x < minX || point.x > maxX || point.y < minY || point.y > maxY) {
-        return false;
+    // Ray-casting algorithm to check if the point is inside the polygon by shooting a ray to the right, counting the number of intersections.
+    // The bounding box is checked first and the per-edge slopes are precomputed in the constructor
+    if (usesIndex()) {
+        return getIndex().containsPoint(edges, point.x, point.y);
     }
+    return containsPointScalar(edges, PolygonBounds{minX, minY, maxX, maxY}, point.x, point.y);
+}
 
-    // Ray-casting algorithm to check if the point is inside the polygon by shooting a ray to the right, counting the number of intersections
-    bool inside = false;
-    size_t j = vertices.size() - 1;
-    
-    for (size_t i = 0; i < vertices.size(); i++) {
-        if (((vertices[i].y > point.y) != (vertices[j].y > point.y)) &&
-            (point.x < (vertices[j].x - vertices[i].x) * (point.y - vertices[i].y) / (vertices[j].y - vertices[i].y) + vertices[i].x)) {
-            inside = !inside;
+void Polygon::containsPoints(std::span<const float> xs, std::span<const float> ys, std::span<uint8_t> inside, SimdLevel level) const
+{
+    if (xs.size() != ys.size() || xs.size() != inside.size()) {
+        throw std::invalid_argument("Point coordinate and result spans must have the same size");
+    }
+
+    // Large polygons: a few edges per point through the slab index beat streaming every edge
+    if (usesIndex()) {
+        const PolygonIndex& slabs = getIndex();
+        for (size_t p = 0; p < xs.size(); p++) {
+            inside[p] = slabs.containsPoint(edges, xs[p], ys[p]);
         }
-        j = i;
+        return;
+    }
+
+    const PolygonBounds bounds{minX, minY, maxX, maxY};
+    switch (resolveSimdLevel(level)) {
+    case SimdLevel::AVX512:
+        containsPointsAvx512(edges, bounds, xs.data(), ys.data(), inside.data(), xs.size());
+        break;
+    case SimdLevel::AVX2:
+        containsPointsAvx2(edges, bounds, xs.data(), ys.data(), inside.data(), xs.size());
+        break;
+    default:
+        for (size_t p = 0; p < xs.size(); p++) {
+            inside[p] = containsPointScalar(edges, bounds, xs[p], ys[p]);
+        }
+        break;
     }
-    return inside;
 }
 
 bool Polygon::isOnBoundary(const Point2D& point, float epsilon) const
 {
+    if (usesIndex()) {
+        return getIndex().isOnBoundary(vertices, point, epsilon);
+    }
+
     // Check if point is on any edge
     for (size_t i = 0; i < vertices.size(); i++) {
         size_t j = (i + 1) % vertices.size();
-        
-        const Point2D& v1 = vertices[i];
-        const Point2D& v2 = vertices[j];
-        
-        // Vector from v1 to v2
-        Point2D edge = {v2.x - v1.x, v2.y - v1.y};
-        // Vector from v1 to point
-        Point2D toPoint = {point.x - v1.x, point.y - v1.y};
-        
-        // Calculate distance from point to line segment
-        float edgeLength = std::sqrt(edge.x * edge.x + edge.y * edge.y);
-        if (edgeLength < epsilon) continue; // Skip degenerate edges
-        
-        // Normalize edge vector
-        edge.x /= edgeLength;
-        edge.y /= edgeLength;
-        
-        // Calculate projection of toPoint onto edge
-        float projection = toPoint.x * edge.x + toPoint.y * edge.y;
-        
-        // Check if projection is within segment bounds
-        if (projection < 0 || projection > edgeLength) continue;
-        
-        // Calculate distance from point to line
-        float distance = std::abs(toPoint.x * edge.y - toPoint.y * edge.x);
-        
-        if (distance < epsilon) return true;
+        if (pointNearSegment(vertices[i], vertices[j], point, epsilon)) return true;
     }
     return false;
 }
 
+void Polygon::moveVertices(std::span<const VertexMove> moves) {
+    if (moves.empty()) return;
+    const size_t n = vertices.size();
+    std::vector<size_t> indices;
+    indices.reserve(moves.size());
+    for (const VertexMove& move : moves) {
+        if (move.index >= n) {
+            throw std::invalid_argument("Vertex index out of range");
+        }
+        indices.push_back(move.index);
+    }
+    std::sort(indices.begin(), indices.end());
+    if (std::adjacent_find(indices.begin(), indices.end()) != indices.end()) {
+        throw std::invalid_argument("Vertex moved more than once");
+    }
+
+    // Edges v - 1 and v end at vertex v
+    std::vector<int> moved;
+    moved.reserve(2 * indices.size());
+    for (size_t v : indices) {
+        moved.push_back(static_cast<int>((v + n - 1) % n));
+        moved.push_back(static_cast<int>(v));
+    }
+    std::sort(moved.begin(), moved.end());
+    moved.erase(std::unique(moved.begin(), moved.end()), moved.end());
+
+    std::vector<Point2D> previous;
+    previous.reserve(moves.size());
+    for (const VertexMove& move : moves) {
+        previous.push_back(vertices[move.index]);
+        vertices[move.index] = move.position;
+    }
+    try {
+        validateMovedEdges(vertices, moved);
+    }
+    catch (...) {
+        for (size_t k = 0; k < moves.size(); k++) vertices[moves[k].index] = previous[k];
+        throw;
+    }
+
+    // A vertex leaving the bounding box edge may shrink it, which needs a full pass
+    bool shrinks = false;
+    for (const Point2D& p : previous) {
+        shrinks = shrinks || p.x == minX || p.x == maxX || p.y == minY || p.y == maxY;
+    }
+    for (const VertexMove& move : moves) {
+        minX = std::min(minX, move.position.x);
+        maxX = std::max(maxX, move.position.x);
+        minY = std::min(minY, move.position.y);
+        maxY = std::max(maxY, move.position.y);
+    }
+    if (shrinks) {
+        prepare();
+    }
+    else {
+        // Entry i of the edge arrays holds the edge from vertex i - 1 to vertex i
+        for (int e : moved) {
+            const size_t i = (static_cast<size_t>(e) + 1) % n;
+            const size_t j = static_cast<size_t>(e);
+            edges.x[i] = vertices[i].x;
+            edges.y[i] = vertices[i].y;
+            edges.yPrev[i] = vertices[j].y;
+            edges.slope[i] = (vertices[j].y != vertices[i].y) ? (vertices[j].x - vertices[i].x) / (vertices[j].y - vertices[i].y) : 0.f;
+        }
+    }
+    index.reset();
+}
+
+void Polygon::setIndexMinEdges(size_t minEdges) { indexMinEdges = minEdges; }
+
+bool Polygon::usesIndex() const { return vertices.size() >= indexMinEdges; }
+
+const PolygonIndex& Polygon::getIndex() const {
+    return index.get(vertices, edges, PolygonBounds{minX, minY, maxX, maxY});
+}
+
 
 /*==================================  Helper Methods  =========================================*/
 
-void Polygon::validatePolygon() const {
-    const int n = vertices.size();
+void Polygon::validatePolygon(ValidationMethod method) const {
+    if (method == ValidationMethod::BRUTE_FORCE) {
+        validatePolygonBruteForce();
+    }
+    else {
+        validatePolygonSweepLine();
+    }
+}
 
-    for (int i = 0; i < n; ++i) {
-        for (int j = i + 1; j < n; ++j) {
-            // Skip adjacent edges
-            if (j == (i + 1) % n || i == (j + 1) % n) continue;
+void Polygon::validatePolygonBruteForce() const {
+    validateBruteForce(RingEdges({std::span<const Point2D>(vertices)}));
+}
 
-            const Point2D& a1 = vertices[i];
-            const Point2D& a2 = vertices[(i + 1) % n];
-            const Point2D& b1 = vertices[j];
-            const Point2D& b2 = vertices[(j + 1) % n];
+void Polygon::validatePolygonSweepLine() const {
+    validateSweepLine({std::span<const Point2D>(vertices)});
+}
 
-            if (edgesIntersect(a1, a2, b1, b2)) {
-                throw std::invalid_argument("Self-intersection detected");
-            }
+void Polygon::validateRings(const std::vector<std::span<const Point2D>>& rings, ValidationMethod method) {
+    for (std::span<const Point2D> ring : rings) {
+        if (ring.size() < 3) {
+            throw std::invalid_argument("Polygon requires at least 3 vertices");
         }
     }
+    if (method == ValidationMethod::BRUTE_FORCE) {
+        validateBruteForce(RingEdges(rings));
+    }
+    else {
+        validateSweepLine(rings);
+    }
 }
 
 
-
 /*==================================  Getters/Setters  =========================================*/
 
 const std::vector<Point2D>& Polygon::getVertices() const { return vertices; }
+const PolygonEdges& Polygon::getEdges() const { return edges; }
 float Polygon::getMinX() const { return minX; }
 float Polygon::getMinY() const { return minY; }
 float Polygon::getMaxX() const { return maxX; }
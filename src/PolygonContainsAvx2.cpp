@@ -0,0 +1,55 @@
+// PolygonContainsAvx2.cpp: compiled with AVX2 enabled, only called after runtime detection
+#include "PolygonKernels.h"
+
+#if defined(PDE_SOLVER_X86_SIMD)
+#include <immintrin.h>
+
+void containsPointsAvx2(const PolygonEdges& edges, const PolygonBounds& bounds,
+    const float* xs, const float* ys, uint8_t* inside, size_t count) {
+    const size_t n = edges.x.size();
+    const __m256 minX = _mm256_set1_ps(bounds.minX), maxX = _mm256_set1_ps(bounds.maxX);
+    const __m256 minY = _mm256_set1_ps(bounds.minY), maxY = _mm256_set1_ps(bounds.maxY);
+
+    size_t p = 0;
+    for (; p + 8 <= count; p += 8) {
+        const __m256 px = _mm256_loadu_ps(xs + p);
+        const __m256 py = _mm256_loadu_ps(ys + p);
+
+        // Bounding box rejection, skip the edge loop when no lane is inside the box
+        __m256 inBox = _mm256_and_ps(_mm256_cmp_ps(px, minX, _CMP_GE_OQ), _mm256_cmp_ps(px, maxX, _CMP_LE_OQ));
+        inBox = _mm256_and_ps(inBox, _mm256_and_ps(_mm256_cmp_ps(py, minY, _CMP_GE_OQ), _mm256_cmp_ps(py, maxY, _CMP_LE_OQ)));
+        int mask = _mm256_movemask_ps(inBox);
+
+        if (mask != 0) {
+            __m256 parity = _mm256_setzero_ps();
+            for (size_t k = 0; k < n; k++) {
+                const __m256 y = _mm256_broadcast_ss(&edges.y[k]);
+                const __m256 yPrev = _mm256_broadcast_ss(&edges.yPrev[k]);
+                const __m256 straddle = _mm256_xor_ps(_mm256_cmp_ps(y, py, _CMP_GT_OQ), _mm256_cmp_ps(yPrev, py, _CMP_GT_OQ));
+                const __m256 product = _mm256_mul_ps(_mm256_broadcast_ss(&edges.slope[k]), _mm256_sub_ps(py, y));
+                const __m256 xCross = _mm256_add_ps(product, _mm256_broadcast_ss(&edges.x[k]));
+                parity = _mm256_xor_ps(parity, _mm256_and_ps(straddle, _mm256_cmp_ps(px, xCross, _CMP_LT_OQ)));
+            }
+            mask &= _mm256_movemask_ps(parity);
+        }
+
+        for (int b = 0; b < 8; b++) {
+            inside[p + b] = static_cast<uint8_t>((mask >> b) & 1);
+        }
+    }
+
+    for (; p < count; p++) {
+        inside[p] = containsPointScalar(edges, bounds, xs[p], ys[p]);
+    }
+}
+
+#else
+
+void containsPointsAvx2(const PolygonEdges& edges, const PolygonBounds& bounds,
+    const float* xs, const float* ys, uint8_t* inside, size_t count) {
+    for (size_t p = 0; p < count; p++) {
+        inside[p] = containsPointScalar(edges, bounds, xs[p], ys[p]);
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+// PolygonContainsAvx512.cpp: compiled with AVX-512F/BW/VL enabled, only called after runtime detection
+#include "PolygonKernels.h"
+
+#if defined(PDE_SOLVER_X86_SIMD)
+#include <immintrin.h>
+
+void containsPointsAvx512(const PolygonEdges& edges, const PolygonBounds& bounds,
+    const float* xs, const float* ys, uint8_t* inside, size_t count) {
+    const size_t n = edges.x.size();
+    const __m512 minX = _mm512_set1_ps(bounds.minX), maxX = _mm512_set1_ps(bounds.maxX);
+    const __m512 minY = _mm512_set1_ps(bounds.minY), maxY = _mm512_set1_ps(bounds.maxY);
+    const __m128i one = _mm_set1_epi8(1);
+
+    size_t p = 0;
+    for (; p + 16 <= count; p += 16) {
+        const __m512 px = _mm512_loadu_ps(xs + p);
+        const __m512 py = _mm512_loadu_ps(ys + p);
+
+        // Bounding box rejection, skip the edge loop when no lane is inside the box
+        __mmask16 mask = _mm512_cmp_ps_mask(px, minX, _CMP_GE_OQ);
+        mask = _mm512_mask_cmp_ps_mask(mask, px, maxX, _CMP_LE_OQ);
+        mask = _mm512_mask_cmp_ps_mask(mask, py, minY, _CMP_GE_OQ);
+        mask = _mm512_mask_cmp_ps_mask(mask, py, maxY, _CMP_LE_OQ);
+
+        if (mask != 0) {
+            __mmask16 parity = 0;
+            for (size_t k = 0; k < n; k++) {
+                const __m512 y = _mm512_set1_ps(edges.y[k]);
+                const __mmask16 straddle = _mm512_cmp_ps_mask(y, py, _CMP_GT_OQ) ^ _mm512_cmp_ps_mask(_mm512_set1_ps(edges.yPrev[k]), py, _CMP_GT_OQ);
+                const __m512 product = _mm512_mul_ps(_mm512_set1_ps(edges.slope[k]), _mm512_sub_ps(py, y));
+                const __m512 xCross = _mm512_add_ps(product, _mm512_set1_ps(edges.x[k]));
+                parity ^= _mm512_mask_cmp_ps_mask(straddle, px, xCross, _CMP_LT_OQ);
+            }
+            mask &= parity;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(inside + p), _mm_maskz_mov_epi8(mask, one));
+    }
+
+    for (; p < count; p++) {
+        inside[p] = containsPointScalar(edges, bounds, xs[p], ys[p]);
+    }
+}
+
+#else
+
+void containsPointsAvx512(const PolygonEdges& edges, const PolygonBounds& bounds,
+    const float* xs, const float* ys, uint8_t* inside, size_t count) {
+    for (size_t p = 0; p < count; p++) {
+        inside[p] = containsPointScalar(edges, bounds, xs[p], ys[p]);
+    }
+}
+
+#endif
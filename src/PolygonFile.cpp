@@ -0,0 +1,185 @@
+#include "PolygonFile.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+    // Position in the text of a vertex file, with the line number for error messages
+    struct TextCursor {
+        const char* p;
+        const char* end;
+        size_t line = 1;
+
+        // Skips blanks on the current line
+        void skipBlanks() {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        }
+
+        // Skips blanks and line breaks
+        void skipSpace() {
+            for (; p < end && std::isspace(static_cast<unsigned char>(*p)); p++) {
+                if (*p == '\n') line++;
+            }
+        }
+
+        bool accept(char c) {
+            if (p == end || *p != c) return false;
+            p++;
+            return true;
+        }
+
+        bool number(float& value) {
+            if (p < end && *p == '+') p++;
+            const auto [next, error] = std::from_chars(p, end, value);
+            if (error != std::errc()) return false;
+            p = next;
+            return true;
+        }
+
+        [[noreturn]] void fail(const std::string& what) const {
+            throw std::runtime_error("Line " + std::to_string(line) + " of the vertex file " + what);
+        }
+    };
+
+    // Whether a CSV line has a field that reads fully as a number; a column header has none
+    bool hasNumericField(const char* p, const char* lineEnd) {
+        auto isSeparator = [](char c) { return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r'; };
+        while (p < lineEnd) {
+            const char* fieldEnd = std::find_if(p, lineEnd, isSeparator);
+            const char* digits = p < fieldEnd && *p == '+' ? p + 1 : p;
+            float value;
+            const auto [next, error] = std::from_chars(digits, fieldEnd, value);
+            if (digits < fieldEnd && error == std::errc() && next == fieldEnd) return true;
+            p = fieldEnd < lineEnd ? fieldEnd + 1 : lineEnd;
+        }
+        return false;
+    }
+
+    std::vector<Point2D> parseCsv(std::string_view text) {
+        std::vector<Point2D> vertices;
+        vertices.reserve(static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+        TextCursor cursor{text.data(), text.data() + text.size()};
+        bool first = true;
+        for (; cursor.p < cursor.end; cursor.line++) {
+            const auto* found = static_cast<const char*>(std::memchr(cursor.p, '\n', static_cast<size_t>(cursor.end - cursor.p)));
+            const char* lineEnd = found ? found : cursor.end;
+            cursor.skipBlanks();
+            if (cursor.p != lineEnd && *cursor.p != '#') {
+                const char* lineStart = cursor.p;
+                Point2D vertex;
+                bool valid = cursor.number(vertex.x);
+                if (valid) {
+                    cursor.skipBlanks();
+                    if (cursor.p < lineEnd && (*cursor.p == ',' || *cursor.p == ';')) cursor.p++;
+                    cursor.skipBlanks();
+                    valid = cursor.number(vertex.y);
+                    cursor.skipBlanks();
+                    valid = valid && cursor.p == lineEnd;
+                }
+                // The first line may be a column header, but not a pair with a bad field
+                if (valid) {
+                    vertices.push_back(vertex);
+                } else if (!first || hasNumericField(lineStart, lineEnd)) {
+                    cursor.fail("is not an x,y pair");
+                }
+                first = false;
+            }
+            cursor.p = found ? found + 1 : cursor.end;
+        }
+        return vertices;
+    }
+
+    std::vector<Point2D> parseWkt(std::string_view text) {
+        constexpr std::string_view keyword = "POLYGON";
+        TextCursor cursor{text.data(), text.data() + text.size()};
+        cursor.skipSpace();
+        const bool isPolygon = static_cast<size_t>(cursor.end - cursor.p) >= keyword.size() &&
+            std::equal(keyword.begin(), keyword.end(), cursor.p, [](char k, char c) { return k == std::toupper(static_cast<unsigned char>(c)); });
+        if (!isPolygon) cursor.fail("is not a WKT POLYGON");
+        cursor.p += keyword.size();
+        cursor.skipSpace();
+        if (!cursor.accept('(')) cursor.fail("is missing the '(' of the polygon");
+        cursor.skipSpace();
+        if (!cursor.accept('(')) cursor.fail("is missing the '(' of the ring");
+
+        std::vector<Point2D> vertices;
+        vertices.reserve(static_cast<size_t>(std::count(text.begin(), text.end(), ',')) + 1);
+        do {
+            Point2D vertex;
+            cursor.skipSpace();
+            if (!cursor.number(vertex.x)) cursor.fail("has a malformed x coordinate");
+            cursor.skipSpace();
+            if (!cursor.number(vertex.y)) cursor.fail("has a malformed y coordinate");
+            cursor.skipSpace();
+            vertices.push_back(vertex);
+        } while (cursor.accept(','));
+
+        if (!cursor.accept(')')) cursor.fail("is missing the ')' of the ring");
+        cursor.skipSpace();
+        if (cursor.accept(',')) cursor.fail("has a polygon with holes; load its rings into a Domain");
+        if (!cursor.accept(')')) cursor.fail("is missing the ')' of the polygon");
+        cursor.skipSpace();
+        if (cursor.p != cursor.end) cursor.fail("has text after the polygon");
+        return vertices;
+    }
+
+    std::vector<Point2D> parseBinary(std::span<const std::byte> bytes) {
+        if (bytes.size() % sizeof(Point2D) != 0) {
+            throw std::runtime_error("A binary vertex file must hold whole float32 x, y pairs");
+        }
+        std::vector<Point2D> vertices(bytes.size() / sizeof(Point2D));
+        if (!bytes.empty()) std::memcpy(vertices.data(), bytes.data(), bytes.size());
+        return vertices;
+    }
+}
+
+/*====================================  Methods  =========================================*/
+
+PolygonFormat PolygonFile::formatOf(const std::string& path) {
+    std::string extension = std::filesystem::path(path).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == ".csv") return PolygonFormat::CSV;
+    if (extension == ".wkt") return PolygonFormat::WKT;
+    if (extension == ".bin" || extension == ".f32") return PolygonFormat::BINARY;
+    throw std::invalid_argument("No polygon file format has the extension of " + path);
+}
+
+std::vector<Point2D> PolygonFile::parse(std::span<const std::byte> bytes, PolygonFormat format) {
+    const std::string_view text(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    std::vector<Point2D> vertices;
+    switch (format) {
+    case PolygonFormat::CSV: vertices = parseCsv(text); break;
+    case PolygonFormat::WKT: vertices = parseWkt(text); break;
+    case PolygonFormat::BINARY: vertices = parseBinary(bytes); break;
+    }
+    if (vertices.size() > 1 && vertices.front() == vertices.back()) vertices.pop_back();
+    return vertices;
+}
+
+std::vector<Point2D> PolygonFile::readVertices(const std::string& path, PolygonFormat format) {
+    const MappedFile file(path);
+    try {
+        return parse(file.getBytes(), format);
+    } catch (const std::runtime_error& error) {
+        throw std::runtime_error(path + ": " + error.what());
+    }
+}
+
+Polygon PolygonFile::read(const std::string& path, PolygonFormat format, ValidationMethod method) {
+    return Polygon(readVertices(path, format), method);
+}
+
+void PolygonFile::writeBinary(const std::string& path, std::span<const Point2D> vertices) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(vertices.data()), static_cast<std::streamsize>(vertices.size_bytes()));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
@@ -0,0 +1,229 @@
+#include "PolygonIndex.h"
+#include "PolygonKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    // Slab and grid resolution are reduced until the edge references fit in about this many entries per edge
+    constexpr size_t maxEntriesPerEdge = 8;
+
+    // Bucket holding an offset from the lower bound, clamped to [0, count - 1]
+    int bucketOf(double offset, double scale, int count) {
+        const double b = std::floor(offset * scale);
+        return static_cast<int>(std::clamp(b, 0.0, static_cast<double>(count - 1)));
+    }
+}
+
+/*====================================  Constructor  =========================================*/
+
+PolygonIndex::PolygonIndex(const std::vector<Point2D>& vertices, const PolygonEdges& edges, const PolygonBounds& bounds_)
+    : bounds(bounds_) {
+    const auto start = std::chrono::steady_clock::now();
+
+    buildSlabs(edges);
+    buildGrid(vertices);
+
+    stats.buildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.memoryBytes = slabOffsets.capacity() * sizeof(size_t) + slabEdges.capacity() * sizeof(uint32_t) +
+        cellOffsets.capacity() * sizeof(size_t) + cellEdges.capacity() * sizeof(uint32_t) + sizeof(PolygonIndex);
+    stats.slabCount = slabCount;
+    stats.slabEntries = slabEdges.size();
+    stats.gridCols = gridCols;
+    stats.gridRows = gridRows;
+    stats.gridEntries = cellEdges.size();
+}
+
+/*====================================  Methods  =========================================*/
+
+bool PolygonIndex::containsPoint(const PolygonEdges& edges, float px, float py) const {
+    if (px < bounds.minX || px > bounds.maxX || py < bounds.minY || py > bounds.maxY) {
+        return false;
+    }
+
+    // Only edges whose y-range contains py can straddle the ray, and they all live in py's slab
+    const int slab = slabOf(py);
+    bool inside = false;
+    for (size_t e = slabOffsets[slab]; e < slabOffsets[slab + 1]; e++) {
+        inside ^= edgeCrossesRay(edges, slabEdges[e], px, py);
+    }
+    return inside;
+}
+
+bool PolygonIndex::isOnBoundary(const std::vector<Point2D>& vertices, const Point2D& point, float epsilon) const {
+    const size_t n = vertices.size();
+
+    // Widen the search box slightly beyond epsilon to cover the rounding of the distance test
+    const double slack = epsilon + 1e-5 * ((bounds.maxX - bounds.minX) + (bounds.maxY - bounds.minY));
+    if (point.x < bounds.minX - slack || point.x > bounds.maxX + slack ||
+        point.y < bounds.minY - slack || point.y > bounds.maxY + slack) {
+        return false;
+    }
+
+    const int c0 = cellCol(point.x - slack), c1 = cellCol(point.x + slack);
+    const int r0 = cellRow(point.y - slack), r1 = cellRow(point.y + slack);
+
+    // A huge tolerance would visit more cells than there are edges, scan linearly instead
+    if (static_cast<size_t>(c1 - c0 + 1) * static_cast<size_t>(r1 - r0 + 1) > n) {
+        for (size_t i = 0; i < n; i++) {
+            if (pointNearSegment(vertices[i], vertices[(i + 1) % n], point, epsilon)) return true;
+        }
+        return false;
+    }
+
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            const size_t cell = static_cast<size_t>(r) * gridCols + c;
+            for (size_t e = cellOffsets[cell]; e < cellOffsets[cell + 1]; e++) {
+                const uint32_t i = cellEdges[e];
+                if (pointNearSegment(vertices[i], vertices[(i + 1) % n], point, epsilon)) return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*====================================  Helper Methods  =========================================*/
+
+int PolygonIndex::slabOf(double y) const { return bucketOf(y - bounds.minY, slabScale, slabCount); }
+int PolygonIndex::cellCol(double x) const { return bucketOf(x - bounds.minX, cellScaleX, gridCols); }
+int PolygonIndex::cellRow(double y) const { return bucketOf(y - bounds.minY, cellScaleY, gridRows); }
+
+void PolygonIndex::buildSlabs(const PolygonEdges& edges) {
+    const size_t n = edges.x.size();
+    const double height = static_cast<double>(bounds.maxY) - bounds.minY;
+
+    // Start with one slab per edge and halve while long edges replicate into too many slabs
+    slabCount = height > 0.0 ? static_cast<int>(std::min<size_t>(n, 1u << 22)) : 1;
+    size_t entries = 0;
+    while (true) {
+        slabScale = height > 0.0 ? slabCount / height : 0.0;
+        entries = 0;
+        for (size_t k = 0; k < n; k++) {
+            entries += slabOf(std::max(edges.y[k], edges.yPrev[k])) - slabOf(std::min(edges.y[k], edges.yPrev[k])) + 1;
+        }
+        if (slabCount == 1 || entries <= maxEntriesPerEdge * n) break;
+        slabCount = std::max(1, slabCount / 2);
+    }
+
+    // Compressed slab lists: count, prefix sum, fill
+    slabOffsets.assign(slabCount + 1, 0);
+    for (size_t k = 0; k < n; k++) {
+        const int s1 = slabOf(std::max(edges.y[k], edges.yPrev[k]));
+        for (int s = slabOf(std::min(edges.y[k], edges.yPrev[k])); s <= s1; s++) slabOffsets[s + 1]++;
+    }
+    for (int s = 0; s < slabCount; s++) slabOffsets[s + 1] += slabOffsets[s];
+
+    slabEdges.resize(entries);
+    std::vector<size_t> cursor(slabOffsets.begin(), slabOffsets.end() - 1);
+    for (size_t k = 0; k < n; k++) {
+        const int s1 = slabOf(std::max(edges.y[k], edges.yPrev[k]));
+        for (int s = slabOf(std::min(edges.y[k], edges.yPrev[k])); s <= s1; s++) {
+            slabEdges[cursor[s]++] = static_cast<uint32_t>(k);
+        }
+    }
+}
+
+void PolygonIndex::buildGrid(const std::vector<Point2D>& vertices) {
+    const size_t n = vertices.size();
+    const double width = std::max(static_cast<double>(bounds.maxX) - bounds.minX, 1e-30);
+    const double height = std::max(static_cast<double>(bounds.maxY) - bounds.minY, 1e-30);
+
+    // About one square-ish cell per edge, coarsened when long edges would cross too many cells:
+    // an edge visits roughly |dx| * cols / width + |dy| * rows / height + 1 cells
+    const double cells = static_cast<double>(n);
+    double cols = std::sqrt(cells * width / height);
+    double rows = cells / std::max(cols, 1.0);
+    double crossings = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        const Point2D& a = vertices[i];
+        const Point2D& b = vertices[(i + 1) % n];
+        crossings += std::abs(static_cast<double>(b.x) - a.x) * cols / width + std::abs(static_cast<double>(b.y) - a.y) * rows / height;
+    }
+    const double budget = static_cast<double>((maxEntriesPerEdge - 2) * n);
+    if (crossings > budget) {
+        cols *= budget / crossings;
+        rows *= budget / crossings;
+    }
+    gridCols = static_cast<int>(std::clamp(std::round(cols), 1.0, 4096.0));
+    gridRows = static_cast<int>(std::clamp(std::round(rows), 1.0, 4096.0));
+    cellScaleX = gridCols / width;
+    cellScaleY = gridRows / height;
+
+    // Visits every cell an edge passes through: per grid row, the x-extent of the edge clipped to the row
+    auto forEachCell = [this](const Point2D& a, const Point2D& b, auto&& visit) {
+        const double yLo = std::min(a.y, b.y), yHi = std::max(a.y, b.y);
+        const int r0 = cellRow(yLo), r1 = cellRow(yHi);
+        for (int r = r0; r <= r1; r++) {
+            double xA = std::min(a.x, b.x), xB = std::max(a.x, b.x);
+            if (a.y != b.y && r0 != r1) {
+                const double rowLo = std::max(yLo, bounds.minY + r / cellScaleY);
+                const double rowHi = std::min(yHi, bounds.minY + (r + 1) / cellScaleY);
+                const double t0 = (rowLo - a.y) / (static_cast<double>(b.y) - a.y);
+                const double t1 = (rowHi - a.y) / (static_cast<double>(b.y) - a.y);
+                const double x0 = a.x + std::clamp(t0, 0.0, 1.0) * (static_cast<double>(b.x) - a.x);
+                const double x1 = a.x + std::clamp(t1, 0.0, 1.0) * (static_cast<double>(b.x) - a.x);
+                xA = std::min(x0, x1);
+                xB = std::max(x0, x1);
+            }
+            const int c1 = cellCol(xB);
+            for (int c = cellCol(xA); c <= c1; c++) {
+                visit(static_cast<size_t>(r) * gridCols + c);
+            }
+        }
+    };
+
+    cellOffsets.assign(static_cast<size_t>(gridCols) * gridRows + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+        forEachCell(vertices[i], vertices[(i + 1) % n], [this](size_t cell) { cellOffsets[cell + 1]++; });
+    }
+    for (size_t cell = 0; cell + 1 < cellOffsets.size(); cell++) cellOffsets[cell + 1] += cellOffsets[cell];
+
+    cellEdges.resize(cellOffsets.back());
+    std::vector<size_t> cursor(cellOffsets.begin(), cellOffsets.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        forEachCell(vertices[i], vertices[(i + 1) % n], [this, &cursor, i](size_t cell) {
+            cellEdges[cursor[cell]++] = static_cast<uint32_t>(i);
+        });
+    }
+}
+
+/*====================================  Lazy Holder  =========================================*/
+
+LazyPolygonIndex::LazyPolygonIndex(const LazyPolygonIndex& other) {
+    std::lock_guard<std::mutex> lock(other.buildMutex);
+    owned = other.owned;
+    ready.store(owned.get(), std::memory_order_release);
+}
+
+LazyPolygonIndex& LazyPolygonIndex::operator=(const LazyPolygonIndex& other) {
+    if (this == &other) return *this;
+    std::shared_ptr<const PolygonIndex> shared;
+    {
+        std::lock_guard<std::mutex> lock(other.buildMutex);
+        shared = other.owned;
+    }
+    std::lock_guard<std::mutex> lock(buildMutex);
+    owned = std::move(shared);
+    ready.store(owned.get(), std::memory_order_release);
+    return *this;
+}
+
+const PolygonIndex& LazyPolygonIndex::get(const std::vector<Point2D>& vertices, const PolygonEdges& edges, const PolygonBounds& bounds) const {
+    if (const PolygonIndex* index = ready.load(std::memory_order_acquire)) {
+        return *index;
+    }
+
+    std::lock_guard<std::mutex> lock(buildMutex);
+    if (!owned) {
+        owned = std::make_shared<const PolygonIndex>(vertices, edges, bounds);
+        ready.store(owned.get(), std::memory_order_release);
+    }
+    return *owned;
+}
+
+void LazyPolygonIndex::reset() {
+    std::lock_guard<std::mutex> lock(buildMutex);
+    owned.reset();
+    ready.store(nullptr, std::memory_order_release);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "Polygon.h"
+
+/**
+ * @brief Checks whether the rightward ray from (px, py) crosses edge k.
+ * Shared by every containment path so they all round identically: the crossing abscissa
+ * is slope * (py - y) + x with a separate multiply and add.
+ */
+inline bool edgeCrossesRay(const PolygonEdges& edges, size_t k, float px, float py) {
+    if ((edges.y[k] > py) != (edges.yPrev[k] > py)) {
+        const float product = edges.slope[k] * (py - edges.y[k]);
+        return px < product + edges.x[k];
+    }
+    return false;
+}
+
+/**
+ * @brief Ray-casting test of one point against all precomputed edges.
+ * Used by the scalar path and the SIMD kernel tails.
+ */
+inline bool containsPointScalar(const PolygonEdges& edges, const PolygonBounds& bounds, float px, float py) {
+    if (px < bounds.minX || px > bounds.maxX || py < bounds.minY || py > bounds.maxY) {
+        return false;
+    }
+
+    bool inside = false;
+    const size_t n = edges.x.size();
+    for (size_t k = 0; k < n; k++) {
+        inside ^= edgeCrossesRay(edges, k, px, py);
+    }
+    return inside;
+}
+
+/**
+ * @brief Checks whether a point lies within epsilon of the segment v1-v2.
+ * Degenerate segments shorter than epsilon never match.
+ */
+inline bool pointNearSegment(const Point2D& v1, const Point2D& v2, const Point2D& point, float epsilon) {
+    // Vector from v1 to v2
+    Point2D edge = {v2.x - v1.x, v2.y - v1.y};
+    // Vector from v1 to point
+    Point2D toPoint = {point.x - v1.x, point.y - v1.y};
+
+    // Calculate distance from point to line segment
+    float edgeLength = std::sqrt(edge.x * edge.x + edge.y * edge.y);
+    if (edgeLength < epsilon) return false; // Skip degenerate edges
+
+    // Normalize edge vector
+    edge.x /= edgeLength;
+    edge.y /= edgeLength;
+
+    // Calculate projection of toPoint onto edge
+    float projection = toPoint.x * edge.x + toPoint.y * edge.y;
+
+    // Check if projection is within segment bounds
+    if (projection < 0 || projection > edgeLength) return false;
+
+    // Calculate distance from point to line
+    float distance = std::abs(toPoint.x * edge.y - toPoint.y * edge.x);
+
+    return distance < epsilon;
+}
+
+/// @brief AVX2 batch kernel (8 points per register), see PolygonContainsAvx2.cpp.
+void containsPointsAvx2(const PolygonEdges& edges, const PolygonBounds& bounds,
+    const float* xs, const float* ys, uint8_t* inside, size_t count);
+
+/// @brief AVX-512 batch kernel (16 points per register), see PolygonContainsAvx512.cpp.
+void containsPointsAvx512(const PolygonEdges& edges, const PolygonBounds& bounds,
+    const float* xs, const float* ys, uint8_t* inside, size_t count);
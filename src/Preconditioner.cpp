@@ -0,0 +1,134 @@
+#include "Preconditioner.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+double Preconditioner::applyDot(std::span<const double> r, std::span<double> z) {
+    apply(r, z);
+    double sum = 0.0;
+    for (size_t k = 0; k < r.size(); k++) sum += r[k] * z[k];
+    return sum;
+}
+
+/*====================================  Identity  =========================================*/
+
+void IdentityPreconditioner::apply(std::span<const double> r, std::span<double> z) {
+    std::copy(r.begin(), r.end(), z.begin());
+}
+
+double IdentityPreconditioner::applyDot(std::span<const double> r, std::span<double> z) {
+    double sum = 0.0;
+    for (size_t k = 0; k < r.size(); k++) {
+        z[k] = r[k];
+        sum += r[k] * r[k];
+    }
+    return sum;
+}
+
+/*====================================  Jacobi  =========================================*/
+
+JacobiPreconditioner::JacobiPreconditioner(const PoissonOperator& op) {
+    std::span<const double> diag = op.getDiagonal();
+    invDiag.resize(diag.size());
+    for (size_t k = 0; k < diag.size(); k++) invDiag[k] = 1.0 / diag[k];
+}
+
+void JacobiPreconditioner::apply(std::span<const double> r, std::span<double> z) {
+    for (size_t k = 0; k < r.size(); k++) z[k] = r[k] * invDiag[k];
+}
+
+double JacobiPreconditioner::applyDot(std::span<const double> r, std::span<double> z) {
+    double sum = 0.0;
+    for (size_t k = 0; k < r.size(); k++) {
+        z[k] = r[k] * invDiag[k];
+        sum += r[k] * z[k];
+    }
+    return sum;
+}
+
+/*====================================  Incomplete Cholesky  =========================================*/
+
+IncompleteCholesky::IncompleteCholesky(const CsrMatrix& matrix) {
+    const int32_t n = matrix.getRowCount();
+    rowPtr.reserve(static_cast<size_t>(n) + 1);
+    rowPtr.push_back(0);
+    for (int32_t i = 0; i < n; i++) {
+        for (int32_t column : matrix.getRowColumns(i)) {
+            if (column > i) break;
+            colIdx.push_back(column);
+        }
+        if (colIdx.size() == static_cast<size_t>(rowPtr.back()) || colIdx.back() != i) {
+            throw std::invalid_argument("Incomplete Cholesky needs a stored diagonal in every row");
+        }
+        rowPtr.push_back(static_cast<int64_t>(colIdx.size()));
+    }
+    values.resize(colIdx.size());
+    invDiag.resize(n);
+
+    // Row-oriented (left-looking) factorization: L_ik = (a_ik - Σ_j L_ij L_kj) / L_kk over the
+    // columns j < k present in both rows, found by merging the two sorted rows
+    for (int32_t i = 0; i < n; i++) {
+        std::span<const int32_t> aColumns = matrix.getRowColumns(i);
+        std::span<const double> aValues = matrix.getRowValues(i);
+        double diagonal = 0.0;
+        for (int64_t e = rowPtr[i]; e < rowPtr[i + 1]; e++) {
+            const int32_t k = colIdx[e];
+            const double a = aValues[std::lower_bound(aColumns.begin(), aColumns.end(), k) - aColumns.begin()];
+            if (k == i) {
+                diagonal = a;
+                continue;
+            }
+
+            double sum = a;
+            int64_t p = rowPtr[i], q = rowPtr[k];
+            while (p < e && colIdx[q] < k) {
+                if (colIdx[p] < colIdx[q]) p++;
+                else if (colIdx[q] < colIdx[p]) q++;
+                else sum -= values[p++] * values[q++];
+            }
+            values[e] = sum * invDiag[k];
+        }
+
+        const int64_t d = rowPtr[i + 1] - 1;
+        for (int64_t e = rowPtr[i]; e < d; e++) diagonal -= values[e] * values[e];
+        if (!(diagonal > 0.0)) {
+            throw std::invalid_argument("Incomplete Cholesky factorization broke down (non-positive pivot)");
+        }
+        values[d] = std::sqrt(diagonal);
+        invDiag[i] = 1.0 / values[d];
+    }
+}
+
+double IncompleteCholesky::solve(std::span<const double> r, std::span<double> z) const {
+    const int32_t n = static_cast<int32_t>(invDiag.size());
+    // Forward substitution L y = r, y stored in z
+    for (int32_t i = 0; i < n; i++) {
+        double sum = r[i];
+        for (int64_t e = rowPtr[i]; e < rowPtr[i + 1] - 1; e++) sum -= values[e] * z[colIdx[e]];
+        z[i] = sum * invDiag[i];
+    }
+    // Backward substitution Lᵀ z = y: z_i is final once every later row has scattered into it
+    double rz = 0.0;
+    for (int32_t i = n - 1; i >= 0; i--) {
+        const double zi = z[i] * invDiag[i];
+        z[i] = zi;
+        rz += r[i] * zi;
+        for (int64_t e = rowPtr[i]; e < rowPtr[i + 1] - 1; e++) z[colIdx[e]] -= values[e] * zi;
+    }
+    return rz;
+}
+
+void IncompleteCholesky::apply(std::span<const double> r, std::span<double> z) {
+    solve(r, z);
+}
+
+double IncompleteCholesky::applyDot(std::span<const double> r, std::span<double> z) {
+    return solve(r, z);
+}
+
+/*====================================  Multigrid  =========================================*/
+
+void MultigridPreconditioner::apply(std::span<const double> r, std::span<double> z) {
+    std::fill(z.begin(), z.end(), 0.0);
+    multigrid.cycle(r, z);
+}
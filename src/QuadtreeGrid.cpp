@@ -0,0 +1,171 @@
+#include "QuadtreeGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // Spreads the 32 bits of v over the even bits of a 64-bit word
+    uint64_t spreadBits(uint32_t v) {
+        uint64_t x = v;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x << 2)) & 0x3333333333333333ull;
+        x = (x | (x << 1)) & 0x5555555555555555ull;
+        return x;
+    }
+
+    // Gathers the even bits of a 64-bit word, the inverse of spreadBits
+    uint32_t compactBits(uint64_t x) {
+        x &= 0x5555555555555555ull;
+        x = (x | (x >> 1)) & 0x3333333333333333ull;
+        x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+        return static_cast<uint32_t>(x);
+    }
+}
+
+QuadtreeGrid::QuadtreeGrid(const Polygon& polygon, const QuadtreeOptions& options) : maxDepth(options.maxDepth) {
+    if (options.maxDepth < 0 || options.maxDepth > 31) {
+        throw std::invalid_argument("Quadtree depth must be between 0 and 31");
+    }
+    if (options.minDepth < 0 || options.minDepth > options.maxDepth) {
+        throw std::invalid_argument("Quadtree minimum depth must be between 0 and the maximum depth");
+    }
+    originX = polygon.getMinX();
+    originY = polygon.getMinY();
+    size = std::max(polygon.getMaxX() - originX, polygon.getMaxY() - originY);
+
+    // Depth-first build with the children pushed in reverse, so leaves come out in Morton order
+    std::vector<std::pair<uint64_t, int>> stack = {{0, 0}};
+    while (!stack.empty()) {
+        const auto [code, depth] = stack.back();
+        stack.pop_back();
+
+        const float side = size / static_cast<float>(uint64_t{1} << depth);
+        const auto [ix, iy] = decodeMorton(code);
+        const double finest = static_cast<double>(size) / static_cast<double>(uint64_t{1} << maxDepth);
+        const double half = 0.5 * static_cast<double>(uint64_t{1} << (maxDepth - depth));
+        const Point2D center(static_cast<float>(originX + (ix + half) * finest), static_cast<float>(originY + (iy + half) * finest));
+
+        const bool cut = polygon.isOnBoundary(center, side * 0.70710678f);
+        const bool split = depth < options.minDepth
+            || (depth < maxDepth && (cut || (options.indicator && options.indicator(center, side))));
+        if (split) {
+            const uint64_t quarter = uint64_t{1} << (2 * (maxDepth - depth - 1));
+            for (int q = 3; q >= 0; q--) stack.push_back({code + q * quarter, depth + 1});
+        }
+        else {
+            const GridType type = cut ? BOUNDARY : (polygon.containsPoint(center) ? INTERIOR : EXTERIOR);
+            leaves.push_back({code, static_cast<uint8_t>(depth), type});
+        }
+    }
+
+    if (options.balance) balance();
+}
+
+uint64_t QuadtreeGrid::encodeMorton(uint32_t ix, uint32_t iy) {
+    return spreadBits(ix) | (spreadBits(iy) << 1);
+}
+
+std::pair<uint32_t, uint32_t> QuadtreeGrid::decodeMorton(uint64_t code) {
+    return {compactBits(code), compactBits(code >> 1)};
+}
+
+float QuadtreeGrid::leafSize(size_t k) const {
+    return size / static_cast<float>(uint64_t{1} << leaves[k].depth);
+}
+
+Point2D QuadtreeGrid::leafCenter(size_t k) const {
+    const auto [ix, iy] = decodeMorton(leaves[k].code);
+    const double finest = static_cast<double>(size) / static_cast<double>(uint64_t{1} << maxDepth);
+    const double half = 0.5 * static_cast<double>(uint64_t{1} << (maxDepth - leaves[k].depth));
+    return Point2D(static_cast<float>(originX + (ix + half) * finest), static_cast<float>(originY + (iy + half) * finest));
+}
+
+int64_t QuadtreeGrid::findLeaf(int64_t ix, int64_t iy) const {
+    const int64_t cells = int64_t{1} << maxDepth;
+    if (ix < 0 || iy < 0 || ix >= cells || iy >= cells) return -1;
+
+    // The leaves tile the square, so the last leaf starting at or before the cell's code covers it
+    const uint64_t code = encodeMorton(static_cast<uint32_t>(ix), static_cast<uint32_t>(iy));
+    auto it = std::upper_bound(leaves.begin(), leaves.end(), code,
+        [](uint64_t c, const QuadtreeLeaf& leaf) { return c < leaf.code; });
+    return static_cast<int64_t>(it - leaves.begin()) - 1;
+}
+
+int64_t QuadtreeGrid::findLeaf(const Point2D& point) const {
+    const double finest = static_cast<double>(size) / static_cast<double>(uint64_t{1} << maxDepth);
+    const double fx = (point.x - static_cast<double>(originX)) / finest;
+    const double fy = (point.y - static_cast<double>(originY)) / finest;
+    const double cells = static_cast<double>(uint64_t{1} << maxDepth);
+    if (!(fx >= 0.0 && fy >= 0.0 && fx <= cells && fy <= cells)) return -1;
+    // The top and right sides of the square belong to the last row and column of cells
+    const int64_t last = (int64_t{1} << maxDepth) - 1;
+    return findLeaf(std::min(static_cast<int64_t>(fx), last), std::min(static_cast<int64_t>(fy), last));
+}
+
+int64_t QuadtreeGrid::findNeighbour(size_t k, QuadDirection direction) const {
+    const auto [ix, iy] = decodeMorton(leaves[k].code);
+    const int64_t side = int64_t{1} << (maxDepth - leaves[k].depth);
+    switch (direction) {
+    case QuadDirection::WEST: return findLeaf(int64_t{ix} - 1, iy);
+    case QuadDirection::EAST: return findLeaf(ix + side, iy);
+    case QuadDirection::SOUTH: return findLeaf(ix, int64_t{iy} - 1);
+    case QuadDirection::NORTH: return findLeaf(ix, iy + side);
+    }
+    return -1;
+}
+
+size_t QuadtreeGrid::countLeaves(GridType type) const {
+    return static_cast<size_t>(std::count_if(leaves.begin(), leaves.end(),
+        [type](const QuadtreeLeaf& leaf) { return leaf.type == type; }));
+}
+
+void QuadtreeGrid::balance() {
+    // Only leaves away from the polygon are ever too coarse (cut leaves sit at maxDepth), and the
+    // quadrants of such a leaf are not cut either, so they inherit its type. A split can only make
+    // the new quadrants too deep for their own neighbours, so after the first sweep over all leaves
+    // each sweep checks just the quadrants created by the previous one and the leaves that caused
+    // them, whose neighbour may still be too coarse
+    std::vector<size_t> check(leaves.size());
+    for (size_t k = 0; k < leaves.size(); k++) check[k] = k;
+    std::vector<uint8_t> split, recheck;
+    std::vector<QuadtreeLeaf> refined;
+    while (!check.empty()) {
+        split.assign(leaves.size(), 0);
+        recheck.assign(leaves.size(), 0);
+        size_t splits = 0;
+        for (size_t k : check) {
+            for (QuadDirection direction : {QuadDirection::WEST, QuadDirection::EAST, QuadDirection::SOUTH, QuadDirection::NORTH}) {
+                const int64_t n = findNeighbour(k, direction);
+                if (n >= 0 && leaves[n].depth + 1 < leaves[k].depth) {
+                    splits += !split[n];
+                    split[n] = 1;
+                    recheck[k] = 1;
+                }
+            }
+        }
+
+        check.clear();
+        if (splits == 0) break;
+        refined.clear();
+        refined.reserve(leaves.size() + 3 * splits);
+        for (size_t k = 0; k < leaves.size(); k++) {
+            const QuadtreeLeaf& leaf = leaves[k];
+            if (!split[k]) {
+                if (recheck[k]) check.push_back(refined.size());
+                refined.push_back(leaf);
+                continue;
+            }
+            const uint64_t quarter = uint64_t{1} << (2 * (maxDepth - leaf.depth - 1));
+            for (uint64_t q = 0; q < 4; q++) {
+                check.push_back(refined.size());
+                refined.push_back({leaf.code + q * quarter, static_cast<uint8_t>(leaf.depth + 1), leaf.type});
+            }
+        }
+        leaves.swap(refined);
+    }
+}
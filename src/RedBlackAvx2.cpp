@@ -0,0 +1,50 @@
+// RedBlackAvx2.cpp: compiled with AVX2 enabled, only called after runtime detection
+#include "RedBlackKernels.h"
+#include <cstring>
+
+#if defined(PDE_SOLVER_X86_SIMD)
+#include <immintrin.h>
+
+void relaxRowAvx2(const RelaxRow& row, const RelaxCoefficients& c) {
+    const __m256d cx = _mm256_set1_pd(c.cx), cy = _mm256_set1_pd(c.cy);
+    const __m256d invDiag = _mm256_set1_pd(c.invDiag), omega = _mm256_set1_pd(c.omega);
+    const __m256i interior = _mm256_set1_epi64x(INTERIOR);
+    // Blocks advance by 4, so every block has the same color pattern as the first
+    const __m256i color = (row.iBegin & 1) == row.parity ? _mm256_setr_epi64x(-1, 0, -1, 0) : _mm256_setr_epi64x(0, -1, 0, -1);
+
+    // The west neighbours are shifted in from the previous block's register: reloading them
+    // from memory would partially overlap the previous store and stall store forwarding.
+    // They have the other color, so the values loaded before the update are still current
+    __m256d previous = _mm256_broadcast_sd(row.u + row.iBegin - 1);
+
+    int i = row.iBegin;
+    for (; i + 4 <= row.iEnd; i += 4) {
+        const __m256d u = _mm256_loadu_pd(row.u + i);
+        const __m256d west = _mm256_shuffle_pd(_mm256_permute2f128_pd(previous, u, 0x21), u, 0x5);
+        previous = u;
+
+        int32_t packed;
+        std::memcpy(&packed, row.cells + i, sizeof(packed));
+        const __m256i types = _mm256_cvtepi8_epi64(_mm_cvtsi32_si128(packed));
+        const __m256i mask = _mm256_and_si256(_mm256_cmpeq_epi64(types, interior), color);
+        if (_mm256_testz_si256(mask, mask)) continue;
+
+        // The whole block is evaluated; only cells of this color are stored, so no neighbour read is stale
+        const __m256d x = _mm256_add_pd(west, _mm256_loadu_pd(row.u + i + 1));
+        const __m256d y = _mm256_add_pd(_mm256_loadu_pd(row.uSouth + i), _mm256_loadu_pd(row.uNorth + i));
+        const __m256d sum = _mm256_add_pd(_mm256_add_pd(_mm256_loadu_pd(row.f + i), _mm256_mul_pd(cx, x)), _mm256_mul_pd(cy, y));
+        const __m256d gs = _mm256_mul_pd(sum, invDiag);
+        const __m256d result = _mm256_add_pd(u, _mm256_mul_pd(omega, _mm256_sub_pd(gs, u)));
+        _mm256_maskstore_pd(row.u + i, mask, result);
+    }
+
+    relaxRowScalar(row, c, i);
+}
+
+#else
+
+void relaxRowAvx2(const RelaxRow& row, const RelaxCoefficients& c) {
+    relaxRowScalar(row, c, row.iBegin);
+}
+
+#endif
@@ -0,0 +1,47 @@
+// RedBlackAvx512.cpp: compiled with AVX-512F/BW/VL enabled, only called after runtime detection
+#include "RedBlackKernels.h"
+
+#if defined(PDE_SOLVER_X86_SIMD)
+#include <immintrin.h>
+
+void relaxRowAvx512(const RelaxRow& row, const RelaxCoefficients& c) {
+    const __m512d cx = _mm512_set1_pd(c.cx), cy = _mm512_set1_pd(c.cy);
+    const __m512d invDiag = _mm512_set1_pd(c.invDiag), omega = _mm512_set1_pd(c.omega);
+    const __m128i interior = _mm_set1_epi8(INTERIOR);
+    // Blocks advance by 8, so every block has the same color pattern as the first
+    const __mmask8 color = (row.iBegin & 1) == row.parity ? 0x55 : 0xAA;
+
+    // The west neighbours are shifted in from the previous block's register: reloading them
+    // from memory would partially overlap the previous store and stall store forwarding.
+    // They have the other color, so the values loaded before the update are still current
+    __m512d previous = _mm512_set1_pd(row.u[row.iBegin - 1]);
+
+    int i = row.iBegin;
+    for (; i + 8 <= row.iEnd; i += 8) {
+        const __m512d u = _mm512_loadu_pd(row.u + i);
+        const __m512d west = _mm512_castsi512_pd(_mm512_alignr_epi64(_mm512_castpd_si512(u), _mm512_castpd_si512(previous), 7));
+        previous = u;
+
+        const __m128i types = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row.cells + i));
+        const __mmask8 mask = static_cast<__mmask8>(_mm_cmpeq_epi8_mask(types, interior)) & color;
+        if (mask == 0) continue;
+
+        // The whole block is evaluated; only cells of this color are stored, so no neighbour read is stale
+        const __m512d x = _mm512_add_pd(west, _mm512_loadu_pd(row.u + i + 1));
+        const __m512d y = _mm512_add_pd(_mm512_loadu_pd(row.uSouth + i), _mm512_loadu_pd(row.uNorth + i));
+        const __m512d sum = _mm512_add_pd(_mm512_add_pd(_mm512_loadu_pd(row.f + i), _mm512_mul_pd(cx, x)), _mm512_mul_pd(cy, y));
+        const __m512d gs = _mm512_mul_pd(sum, invDiag);
+        const __m512d result = _mm512_add_pd(u, _mm512_mul_pd(omega, _mm512_sub_pd(gs, u)));
+        _mm512_mask_storeu_pd(row.u + i, mask, result);
+    }
+
+    relaxRowScalar(row, c, i);
+}
+
+#else
+
+void relaxRowAvx512(const RelaxRow& row, const RelaxCoefficients& c) {
+    relaxRowScalar(row, c, row.iBegin);
+}
+
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include "FDMGrid.h"
+
+/**
+ * @brief Constant coefficients of the 5-point SOR update.
+ */
+struct RelaxCoefficients {
+    double cx, cy;    // 1 / dx^2 and 1 / dy^2
+    double invDiag;   // 1 / (2 cx + 2 cy)
+    double omega;     // relaxation factor, 1 = Gauss-Seidel
+};
+
+/**
+ * @brief One grid row of a red-black pass.
+ * Cells i in [iBegin, iEnd) with i % 2 == parity and type INTERIOR are updated in place.
+ */
+struct RelaxRow {
+    double* u;              // row j of the field
+    const double* uSouth;   // row j - 1
+    const double* uNorth;   // row j + 1
+    const double* f;        // row j of the source
+    const GridType* cells;  // row j of the classification
+    int iBegin, iEnd;       // updated x range, 1 <= iBegin and iEnd <= nx - 1
+    int parity;             // i % 2 of the cells with the pass's color
+};
+
+/**
+ * @brief SOR update of one node. Shared by every kernel so they all round identically:
+ * separate multiplies and adds in a fixed order.
+ */
+inline double relaxNode(const RelaxRow& row, const RelaxCoefficients& c, int i) {
+    const double x = row.u[i - 1] + row.u[i + 1];
+    const double y = row.uSouth[i] + row.uNorth[i];
+    const double gs = (row.f[i] + c.cx * x + c.cy * y) * c.invDiag;
+    return row.u[i] + c.omega * (gs - row.u[i]);
+}
+
+/**
+ * @brief Scalar red-black row kernel, visits only the cells of the pass's color.
+ * Also used for the SIMD kernel tails.
+ */
+inline void relaxRowScalar(const RelaxRow& row, const RelaxCoefficients& c, int iBegin) {
+    const int first = iBegin + ((iBegin & 1) != row.parity);
+    for (int i = first; i < row.iEnd; i += 2) {
+        if (row.cells[i] == INTERIOR) {
+            row.u[i] = relaxNode(row, c, i);
+        }
+    }
+}
+
+/// @brief AVX2 row kernel (4 nodes per register), see RedBlackAvx2.cpp.
+void relaxRowAvx2(const RelaxRow& row, const RelaxCoefficients& c);
+
+/// @brief AVX-512 row kernel (8 nodes per register), see RedBlackAvx512.cpp.
+void relaxRowAvx512(const RelaxRow& row, const RelaxCoefficients& c);
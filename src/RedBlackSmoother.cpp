@@ -0,0 +1,156 @@
+#include "RedBlackSmoother.h"
+#include "RedBlackKernels.h"
+#include "Parallel.h"
+#include <cmath>
+#include <mutex>
+#include <numbers>
+#include <stdexcept>
+
+namespace {
+    constexpr int residualCheckInterval = 10;
+
+    RelaxCoefficients coefficients(const FDMGrid& grid, double omega) {
+        const double cx = 1.0 / (static_cast<double>(grid.getDx()) * grid.getDx());
+        const double cy = 1.0 / (static_cast<double>(grid.getDy()) * grid.getDy());
+        return {cx, cy, 1.0 / (2.0 * cx + 2.0 * cy), omega};
+    }
+
+    void relaxRowPortable(const RelaxRow& row, const RelaxCoefficients& c) {
+        relaxRowScalar(row, c, row.iBegin);
+    }
+
+    // Rows per parallel block, matching the granularity of the grid classification
+    int minRows(const FDMGrid& grid) {
+        return std::max(1, 65536 / grid.getNx());
+    }
+}
+
+RedBlackSmoother::RedBlackSmoother(const FDMGrid& grid_, double omega_, SimdLevel level)
+    : grid(grid_), omega(1.0), simdLevel(resolveSimdLevel(level)) {
+    setOmega(omega_);
+}
+
+void RedBlackSmoother::setOmega(double omega_) {
+    if (!(omega_ > 0.0 && omega_ < 2.0)) {
+        throw std::invalid_argument("The relaxation factor must lie in (0, 2)");
+    }
+    omega = omega_;
+}
+
+double RedBlackSmoother::optimalOmega(const FDMGrid& grid) {
+    const int n = std::max(grid.getNx(), grid.getNy()) - 1;
+    return 2.0 / (1.0 + std::sin(std::numbers::pi / n));
+}
+
+GridField RedBlackSmoother::sample(const FDMGrid& grid, const ScalarFunction& function, GridType type) {
+    GridField field(grid.getNx(), grid.getNy());
+    for (int j = 0; j < grid.getNy(); j++) {
+        std::span<const GridType> row = grid.getRow(j);
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (type == UNDEFINED || row[i] == type) {
+                field(i, j) = function(grid.indexToPoint(i, j));
+            }
+        }
+    }
+    return field;
+}
+
+RedBlackSmoother::RowKernel RedBlackSmoother::rowKernel() const {
+    switch (simdLevel) {
+    case SimdLevel::AVX512:
+        return relaxRowAvx512;
+    case SimdLevel::AVX2:
+        return relaxRowAvx2;
+    default:
+        return relaxRowPortable;
+    }
+}
+
+void RedBlackSmoother::relaxRow(GridField& u, const GridField& f, int j, int color, RowKernel kernel) const {
+    const int nx = grid.getNx();
+    const size_t offset = grid.cellIndex(0, j);
+    double* values = u.getValues().data() + offset;
+    const RelaxRow row{values, values - nx, values + nx, f.getValues().data() + offset,
+        grid.getCells().data() + offset, 1, nx - 1, (color + j) & 1};
+    kernel(row, coefficients(grid, omega));
+}
+
+void RedBlackSmoother::relaxColor(GridField& u, const GridField& f, int color) const {
+    const RowKernel kernel = rowKernel();
+
+    // Rows of one color only read the other color, so any row partition gives the serial result
+    parallelFor(1, grid.getNy() - 1, minRows(grid), grid.getNumThreads(), [&](int jBegin, int jEnd) {
+        for (int j = jBegin; j < jEnd; j++) {
+            relaxRow(u, f, j, color, kernel);
+        }
+    });
+}
+
+void RedBlackSmoother::sweep(GridField& u, const GridField& f, int count) const {
+    const RowKernel kernel = rowKernel();
+    std::mutex deferredMutex;
+    std::vector<int> deferred;
+
+    for (int s = 0; s < count; s++) {
+        // Fused pass: the black half of row j - 1 is relaxed right after the red half of row j,
+        // while the three rows are still in cache. Black rows on a block edge read red rows of
+        // the neighbouring block and are deferred until every block has finished
+        deferred.clear();
+        parallelFor(1, grid.getNy() - 1, minRows(grid), grid.getNumThreads(), [&](int jBegin, int jEnd) {
+            for (int j = jBegin; j < jEnd; j++) {
+                relaxRow(u, f, j, 0, kernel);
+                if (j - 1 > jBegin) relaxRow(u, f, j - 1, 1, kernel);
+            }
+            std::lock_guard<std::mutex> lock(deferredMutex);
+            deferred.push_back(jBegin);
+            if (jEnd - 1 > jBegin) deferred.push_back(jEnd - 1);
+        });
+        for (int j : deferred) {
+            relaxRow(u, f, j, 1, kernel);
+        }
+    }
+}
+
+double RedBlackSmoother::residualNorm(const GridField& u, const GridField& f) const {
+    const RelaxCoefficients c = coefficients(grid, omega);
+    const double diag = 2.0 * c.cx + 2.0 * c.cy;
+    std::vector<double> rowSums(grid.getNy(), 0.0);
+
+    parallelFor(1, grid.getNy() - 1, minRows(grid), grid.getNumThreads(), [&](int jBegin, int jEnd) {
+        for (int j = jBegin; j < jEnd; j++) {
+            std::span<const GridType> row = grid.getRow(j);
+            double sum = 0.0;
+            for (int i = 1; i < grid.getNx() - 1; i++) {
+                if (row[i] != INTERIOR) continue;
+                const double r = f(i, j) - diag * u(i, j)
+                    + c.cx * (u(i - 1, j) + u(i + 1, j)) + c.cy * (u(i, j - 1) + u(i, j + 1));
+                sum += r * r;
+            }
+            rowSums[j] = sum;
+        }
+    });
+
+    double total = 0.0;
+    for (double sum : rowSums) total += sum;
+    return std::sqrt(total);
+}
+
+SolveResult RedBlackSmoother::solve(const ScalarFunction& source, const ScalarFunction& boundaryValue, const SolverOptions& options) const {
+    const GridField f = sample(grid, source);
+    SolveResult result;
+    result.field = sample(grid, boundaryValue, BOUNDARY);
+
+    // With zero interior values the residual is the full right-hand side, Dirichlet terms included
+    const double bNorm = residualNorm(result.field, f);
+    const double scale = bNorm > 0.0 ? 1.0 / bNorm : 1.0;
+
+    result.residualNorm = bNorm * scale;
+    while (result.residualNorm > options.tolerance && result.iterations < options.maxIterations) {
+        const int count = std::min(residualCheckInterval, options.maxIterations - result.iterations);
+        sweep(result.field, f, count);
+        result.iterations += count;
+        result.residualNorm = residualNorm(result.field, f) * scale;
+    }
+    result.converged = result.residualNorm <= options.tolerance;
+    return result;
+}
@@ -0,0 +1,40 @@
+#include "SimdDispatch.h"
+
+#if defined(PDE_SOLVER_X86_SIMD) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    SimdLevel queryCpu() {
+#if defined(PDE_SOLVER_X86_SIMD) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl")) return SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        return SimdLevel::SCALAR;
+#elif defined(PDE_SOLVER_X86_SIMD) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        const bool osSavesYmm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+        if (!osSavesYmm) return SimdLevel::SCALAR;
+
+        __cpuidex(info, 7, 0);
+        const bool avx2 = info[1] & (1 << 5);
+        const bool avx512 = (info[1] & (1 << 16)) && (info[1] & (1 << 30)) && (info[1] & (1u << 31)) && ((_xgetbv(0) & 0xE6) == 0xE6);
+        if (avx512) return SimdLevel::AVX512;
+        if (avx2) return SimdLevel::AVX2;
+        return SimdLevel::SCALAR;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+}
+
+SimdLevel detectSimdLevel() {
+    static const SimdLevel level = queryCpu();
+    return level;
+}
+
+SimdLevel resolveSimdLevel(SimdLevel requested) {
+    const SimdLevel available = detectSimdLevel();
+    return static_cast<int8_t>(requested) < static_cast<int8_t>(available) ? requested : available;
+}
@@ -0,0 +1,281 @@
+#include "SnapshotWriter.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    const char* byteOrder() {
+        return std::endian::native == std::endian::little ? "LittleEndian" : "BigEndian";
+    }
+
+    // Bounding box of the INTERIOR and BOUNDARY cells, empty if there are none
+    CellBox solvedBox(const FDMGrid& grid) {
+        CellBox box{grid.getNx(), 0, grid.getNy(), 0};
+        for (int j = 0; j < grid.getNy(); j++) {
+            const std::span<const GridType> row = grid.getRow(j);
+            int first = 0, last = grid.getNx() - 1;
+            while (first <= last && row[first] != INTERIOR && row[first] != BOUNDARY) first++;
+            if (first > last) continue;
+            while (row[last] != INTERIOR && row[last] != BOUNDARY) last--;
+            box.iBegin = std::min(box.iBegin, first);
+            box.iEnd = std::max(box.iEnd, last + 1);
+            box.jBegin = std::min(box.jBegin, j);
+            box.jEnd = j + 1;
+        }
+        return box;
+    }
+}
+
+/*====================================  Constructor  =========================================*/
+
+SnapshotWriter::SnapshotWriter(const FDMGrid& grid_, const std::string& directory_, const std::string& name_, int bufferCount)
+    : grid(grid_), directory(directory_), name(name_), box(solvedBox(grid_)) {
+    if (name.empty() || bufferCount < 1) {
+        throw std::invalid_argument("A snapshot writer needs a name and at least one buffer");
+    }
+    if (box.iBegin >= box.iEnd) {
+        throw std::invalid_argument("The grid has no INTERIOR or BOUNDARY cell to write");
+    }
+    if (!std::filesystem::is_directory(directory)) {
+        throw std::runtime_error("Snapshot directory " + directory + " does not exist");
+    }
+    const size_t boxCells = static_cast<size_t>(box.iEnd - box.iBegin) * (box.jEnd - box.jBegin);
+    buffers.resize(bufferCount);
+    for (Snapshot& snapshot : buffers) {
+        snapshot.values.resize(boxCells);
+        available.push_back(&snapshot);
+    }
+    thread = std::thread([this] { writerLoop(); });
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    stop();
+}
+
+/*==================================== Getters =========================================*/
+
+std::string SnapshotWriter::getSeriesPath() const {
+    return (std::filesystem::path(directory) / (name + ".pvd")).string();
+}
+
+SnapshotStats SnapshotWriter::getStats() const {
+    std::lock_guard lock(mutex);
+    return stats;
+}
+
+/*====================================  Methods  =========================================*/
+
+void SnapshotWriter::submit(const GridField& u, double time) {
+    if (u.getNx() != grid.getNx() || u.getNy() != grid.getNy()) {
+        throw std::invalid_argument("The field does not match the grid of the snapshot writer");
+    }
+    Snapshot* snapshot;
+    {
+        std::unique_lock lock(mutex);
+        if (closing) throw std::logic_error("The snapshot writer is closed");
+        if (error) std::rethrow_exception(error);
+        if (available.empty()) {
+            const Clock::time_point start = Clock::now();
+            bufferFreed.wait(lock, [this] { return !available.empty(); });
+            stats.stalls++;
+            stats.stallMilliseconds += millisecondsSince(start);
+        }
+        snapshot = available.back();
+        available.pop_back();
+        snapshot->index = stats.submitted++;
+    }
+
+    // The buffer belongs to this thread until it is queued, so the copy runs unlocked
+    const Clock::time_point start = Clock::now();
+    const std::span<const double> values = u.getValues();
+    const size_t width = static_cast<size_t>(box.iEnd - box.iBegin);
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    double* out = snapshot->values.data();
+    for (int j = box.jBegin; j < box.jEnd; j++, out += width) {
+        const size_t rowStart = static_cast<size_t>(j) * grid.getNx() + box.iBegin;
+        const GridType* cells = grid.getCells().data() + rowStart;
+        const double* in = values.data() + rowStart;
+        for (size_t i = 0; i < width; i++) {
+            out[i] = (cells[i] == INTERIOR || cells[i] == BOUNDARY) ? in[i] : nan;
+        }
+    }
+    snapshot->time = time;
+
+    {
+        std::lock_guard lock(mutex);
+        stats.copyMilliseconds += millisecondsSince(start);
+        pending.push_back(snapshot);
+        stats.maxPending = std::max<uint64_t>(stats.maxPending, pending.size());
+    }
+    snapshotQueued.notify_one();
+}
+
+void SnapshotWriter::flush() {
+    std::unique_lock lock(mutex);
+    bufferFreed.wait(lock, [this] { return pending.empty() && !listing; });
+    if (error) std::rethrow_exception(error);
+}
+
+void SnapshotWriter::close() {
+    stop();
+    std::lock_guard lock(mutex);
+    if (error) std::rethrow_exception(error);
+}
+
+/*====================================  Helper Methods  =========================================*/
+
+void SnapshotWriter::writerLoop() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        snapshotQueued.wait(lock, [this] { return closing || !pending.empty(); });
+        if (pending.empty()) break;
+        Snapshot* snapshot = pending.front();
+        const double time = snapshot->time;
+        const uint64_t index = snapshot->index;
+        const bool failed = static_cast<bool>(error);
+        lock.unlock();
+
+        // After a failure the remaining snapshots are dropped, so the series stays contiguous
+        const Clock::time_point start = Clock::now();
+        uint64_t bytes = 0;
+        std::exception_ptr writeError;
+        if (!failed) {
+            try {
+                bytes = writeSnapshot(*snapshot);
+            } catch (...) {
+                writeError = std::current_exception();
+            }
+        }
+
+        lock.lock();
+        stats.writeMilliseconds += millisecondsSince(start);
+        if (writeError) {
+            error = writeError;
+        } else if (!failed) {
+            stats.written++;
+            stats.bytesWritten += bytes;
+        }
+        pending.pop_front();
+        available.push_back(snapshot);
+        listing = !error;
+        bufferFreed.notify_all();
+
+        // The buffer is free before the snapshot is listed, so the solver never waits for the collection
+        if (listing) {
+            lock.unlock();
+            const Clock::time_point listStart = Clock::now();
+            std::exception_ptr seriesError;
+            try {
+                bytes = appendSeries(time, snapshotFile(index));
+            } catch (...) {
+                seriesError = std::current_exception();
+            }
+            lock.lock();
+            stats.seriesMilliseconds += millisecondsSince(listStart);
+            if (seriesError) {
+                error = seriesError;
+            } else {
+                stats.seriesWrites++;
+                stats.seriesBytesWritten += bytes;
+            }
+            listing = false;
+            bufferFreed.notify_all();
+        }
+    }
+    lock.unlock();
+    series.close();
+}
+
+std::string SnapshotWriter::snapshotFile(uint64_t index) const {
+    char suffix[64];
+    std::snprintf(suffix, sizeof(suffix), "_%06llu.vti", static_cast<unsigned long long>(index));
+    return name + suffix;
+}
+
+uint64_t SnapshotWriter::writeSnapshot(const Snapshot& snapshot) {
+    const std::string path = (std::filesystem::path(directory) / snapshotFile(snapshot.index)).string();
+
+    // Extents are node indices of the full grid, so every snapshot lands at its true position
+    std::ostringstream header;
+    header.precision(std::numeric_limits<float>::max_digits10);
+    header << "<?xml version=\"1.0\"?>\n"
+           << "<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\"" << byteOrder() << "\" header_type=\"UInt64\">\n"
+           << "  <ImageData WholeExtent=\"" << box.iBegin << ' ' << box.iEnd - 1 << ' ' << box.jBegin << ' ' << box.jEnd - 1 << " 0 0\""
+           << " Origin=\"" << grid.getOriginX() << ' ' << grid.getOriginY() << " 0\""
+           << " Spacing=\"" << grid.getDx() << ' ' << grid.getDy() << " 1\">\n"
+           << "    <Piece Extent=\"" << box.iBegin << ' ' << box.iEnd - 1 << ' ' << box.jBegin << ' ' << box.jEnd - 1 << " 0 0\">\n"
+           << "      <PointData Scalars=\"" << name << "\">\n"
+           << "        <DataArray type=\"Float64\" Name=\"" << name << "\" format=\"appended\" offset=\"0\"/>\n"
+           << "      </PointData>\n"
+           << "    </Piece>\n"
+           << "  </ImageData>\n"
+           << "  <AppendedData encoding=\"raw\">\n_";
+    const std::string head = header.str();
+    const std::string tail = "\n  </AppendedData>\n</VTKFile>\n";
+    const uint64_t length = snapshot.values.size() * sizeof(double);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot create " + path);
+    }
+    out.write(head.data(), static_cast<std::streamsize>(head.size()));
+    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.write(reinterpret_cast<const char*>(snapshot.values.data()), static_cast<std::streamsize>(length));
+    out.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+
+    return head.size() + sizeof(length) + length + tail.size();
+}
+
+uint64_t SnapshotWriter::appendSeries(double time, const std::string& file) {
+    std::ostringstream entry;
+    entry.precision(std::numeric_limits<double>::max_digits10);
+    if (!series.is_open()) {
+        const std::string path = getSeriesPath();
+        series.open(path, std::ios::binary | std::ios::trunc);
+        if (!series) {
+            throw std::runtime_error("Cannot create " + path);
+        }
+        entry << "<?xml version=\"1.0\"?>\n"
+              << "<VTKFile type=\"Collection\" version=\"1.0\" byte_order=\"" << byteOrder() << "\">\n"
+              << "  <Collection>\n";
+    }
+    entry << "    <DataSet timestep=\"" << time << "\" part=\"0\" file=\"" << file << "\"/>\n";
+    const std::string text = entry.str();
+    const std::string tail = "  </Collection>\n</VTKFile>\n";
+
+    // The entry goes where the closing tags were; the tags follow it again
+    series.seekp(seriesTail);
+    series.write(text.data(), static_cast<std::streamsize>(text.size()));
+    series.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    series.flush();
+    if (!series) {
+        throw std::runtime_error("Cannot write " + getSeriesPath());
+    }
+    seriesTail += static_cast<std::streamoff>(text.size());
+    return text.size() + tail.size();
+}
+
+void SnapshotWriter::stop() {
+    {
+        std::lock_guard lock(mutex);
+        closing = true;
+    }
+    snapshotQueued.notify_one();
+    if (thread.joinable()) thread.join();
+}
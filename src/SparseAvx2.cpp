@@ -0,0 +1,34 @@
+// SparseAvx2.cpp: compiled with AVX2 enabled, only called after runtime detection
+#include "SparseKernels.h"
+
+#if defined(PDE_SOLVER_X86_SIMD)
+#include <immintrin.h>
+
+void sellChunkAvx2(const SellChunk& chunk, const double* x, double* y) {
+    int g = 0;
+    for (; g + 4 <= chunk.height; g += 4) {
+        __m256d sum = _mm256_setzero_pd();
+        for (int k = 0; k < chunk.width; k++) {
+            const int64_t e = static_cast<int64_t>(k) * chunk.height + g;
+            const __m128i columns = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk.columns + e));
+            const __m256d xs = _mm256_i32gather_pd(x, columns, 8);
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_loadu_pd(chunk.values + e), xs));
+        }
+
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, sum);
+        for (int l = 0; l < 4; l++) {
+            if (chunk.rows[g + l] >= 0) y[chunk.rows[g + l]] = lanes[l];
+        }
+    }
+
+    sellChunkScalar(chunk, x, y, g);
+}
+
+#else
+
+void sellChunkAvx2(const SellChunk& chunk, const double* x, double* y) {
+    sellChunkScalar(chunk, x, y);
+}
+
+#endif
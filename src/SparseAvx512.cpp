@@ -0,0 +1,33 @@
+// SparseAvx512.cpp: compiled with AVX-512F/BW/VL enabled, only called after runtime detection
+#include "SparseKernels.h"
+
+#if defined(PDE_SOLVER_X86_SIMD)
+#include <immintrin.h>
+
+void sellChunkAvx512(const SellChunk& chunk, const double* x, double* y) {
+    int g = 0;
+    for (; g + 8 <= chunk.height; g += 8) {
+        __m512d sum = _mm512_setzero_pd();
+        for (int k = 0; k < chunk.width; k++) {
+            const int64_t e = static_cast<int64_t>(k) * chunk.height + g;
+            const __m256i columns = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk.columns + e));
+            const __m512d xs = _mm512_i32gather_pd(columns, x, 8);
+            sum = _mm512_add_pd(sum, _mm512_mul_pd(_mm512_loadu_pd(chunk.values + e), xs));
+        }
+
+        // Slots past the last row are marked -1 and masked out of the scatter
+        const __m256i rows = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk.rows + g));
+        const __mmask8 valid = _mm256_cmpge_epi32_mask(rows, _mm256_setzero_si256());
+        _mm512_mask_i32scatter_pd(y, valid, rows, sum, 8);
+    }
+
+    sellChunkScalar(chunk, x, y, g);
+}
+
+#else
+
+void sellChunkAvx512(const SellChunk& chunk, const double* x, double* y) {
+    sellChunkScalar(chunk, x, y);
+}
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief One chunk of a SellMatrix: height rows padded to width entries, stored column-major.
+ * Entry k of lane l is at values[k * height + l]; lane l belongs to row rows[l], or to no row
+ * if rows[l] < 0.
+ */
+struct SellChunk {
+    const double* values;
+    const int32_t* columns;
+    const int32_t* rows;
+    int width;
+    int height;
+};
+
+/**
+ * @brief Multiplies one chunk with x and writes the sums of its rows to y.
+ * Each lane is summed from 0 in entry order, one multiply and one add per entry, which is the
+ * order every kernel and CsrMatrix::multiply use. Also used for lanes the SIMD kernels leave over.
+ */
+inline void sellChunkScalar(const SellChunk& chunk, const double* x, double* y, int firstLane = 0) {
+    for (int l = firstLane; l < chunk.height; l++) {
+        if (chunk.rows[l] < 0) continue;
+        double sum = 0.0;
+        for (int k = 0; k < chunk.width; k++) {
+            const int64_t e = static_cast<int64_t>(k) * chunk.height + l;
+            sum += chunk.values[e] * x[chunk.columns[e]];
+        }
+        y[chunk.rows[l]] = sum;
+    }
+}
+
+/// @brief AVX2 chunk kernel (4 lanes per register with a gather), see SparseAvx2.cpp.
+void sellChunkAvx2(const SellChunk& chunk, const double* x, double* y);
+
+/// @brief AVX-512 chunk kernel (8 lanes per register with a gather and a masked scatter), see SparseAvx512.cpp.
+void sellChunkAvx512(const SellChunk& chunk, const double* x, double* y);
@@ -0,0 +1,162 @@
+#include "SparseMatrix.h"
+#include "SparseKernels.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+    // Rows per parallel block: about a quarter of a megabyte of matrix data
+    constexpr int minRowsPerBlock = 4096;
+
+    void sellChunkPortable(const SellChunk& chunk, const double* x, double* y) {
+        sellChunkScalar(chunk, x, y);
+    }
+}
+
+CsrMatrix::CsrMatrix(const PoissonOperator& op)
+    : rows(op.getUnknownCount()), numThreads(op.getGrid().getNumThreads()) {
+    std::span<const double> diag = op.getDiagonal();
+    // Neighbours in increasing column order: unknowns are numbered row by row
+    const std::pair<std::span<const double>, std::span<const int32_t>> lower[] = {
+        {op.getSouthWeights(), op.getSouthIndices()}, {op.getWestWeights(), op.getWestIndices()}};
+    const std::pair<std::span<const double>, std::span<const int32_t>> upper[] = {
+        {op.getEastWeights(), op.getEastIndices()}, {op.getNorthWeights(), op.getNorthIndices()}};
+
+    rowPtr.reserve(static_cast<size_t>(rows) + 1);
+    colIdx.reserve(static_cast<size_t>(rows) * 5);
+    values.reserve(static_cast<size_t>(rows) * 5);
+    rowPtr.push_back(0);
+
+    // The operator stores -∇² as diag u - Σ w u_neighbour; a zero weight marks a Dirichlet neighbour
+    auto append = [this](const auto& neighbours, int32_t k) {
+        for (const auto& [weights, indices] : neighbours) {
+            if (weights[k] == 0.0) continue;
+            colIdx.push_back(indices[k]);
+            values.push_back(-weights[k]);
+        }
+    };
+    for (int32_t k = 0; k < rows; k++) {
+        append(lower, k);
+        colIdx.push_back(k);
+        values.push_back(diag[k]);
+        append(upper, k);
+        rowPtr.push_back(static_cast<int64_t>(colIdx.size()));
+    }
+}
+
+CsrMatrix::CsrMatrix(int32_t rows_, AlignedVector<int64_t> rowPtr_, AlignedVector<int32_t> colIdx_,
+    AlignedVector<double> values_, unsigned numThreads_)
+    : rows(rows_), rowPtr(std::move(rowPtr_)), colIdx(std::move(colIdx_)), values(std::move(values_)), numThreads(numThreads_) {
+    if (rows < 0 || rowPtr.size() != static_cast<size_t>(rows) + 1 || rowPtr[0] != 0) {
+        throw std::invalid_argument("CSR row pointers must have one entry per row plus one, starting at 0");
+    }
+    if (colIdx.size() != values.size() || rowPtr[rows] != static_cast<int64_t>(colIdx.size())) {
+        throw std::invalid_argument("CSR row pointers, columns and values have inconsistent sizes");
+    }
+    for (int32_t k = 0; k < rows; k++) {
+        if (rowPtr[k + 1] < rowPtr[k]) {
+            throw std::invalid_argument("CSR row pointers must be non-decreasing");
+        }
+        for (int64_t e = rowPtr[k]; e < rowPtr[k + 1]; e++) {
+            if (colIdx[e] < 0 || colIdx[e] >= rows || (e > rowPtr[k] && colIdx[e] <= colIdx[e - 1])) {
+                throw std::invalid_argument("CSR columns must be in range and strictly increasing within a row");
+            }
+        }
+    }
+}
+
+void CsrMatrix::multiply(std::span<const double> x, std::span<double> y) const {
+    parallelFor(0, rows, minRowsPerBlock, numThreads, [&](int first, int last) {
+        for (int32_t k = first; k < last; k++) {
+            double sum = 0.0;
+            for (int64_t e = rowPtr[k]; e < rowPtr[k + 1]; e++) {
+                sum += values[e] * x[colIdx[e]];
+            }
+            y[k] = sum;
+        }
+    });
+}
+
+SellMatrix::SellMatrix(const CsrMatrix& csr, int chunkHeight_, int sortWindow_, SimdLevel level)
+    : rows(csr.getRowCount()), chunkHeight(chunkHeight_), sortWindow(sortWindow_), nonzeros(csr.getNonzeroCount()),
+    numThreads(csr.getNumThreads()), simdLevel(resolveSimdLevel(level)) {
+    if (chunkHeight <= 0 || chunkHeight > 64 || (chunkHeight & (chunkHeight - 1)) != 0) {
+        throw std::invalid_argument("The SELL chunk height must be a power of two no larger than 64");
+    }
+    if (sortWindow != 1 && (sortWindow <= 0 || sortWindow % chunkHeight != 0)) {
+        throw std::invalid_argument("The SELL sorting window must be 1 or a multiple of the chunk height");
+    }
+
+    std::span<const int64_t> csrRowPtr = csr.getRowPointers();
+    auto rowLength = [&](int32_t k) { return static_cast<int32_t>(csrRowPtr[k + 1] - csrRowPtr[k]); };
+
+    // Sort by decreasing length within each window; stable, so equal rows keep their locality
+    std::vector<int32_t> order(rows);
+    std::iota(order.begin(), order.end(), 0);
+    if (sortWindow > 1) {
+        for (int32_t w = 0; w < rows; w += sortWindow) {
+            const int32_t end = std::min(rows, w + sortWindow);
+            std::stable_sort(order.begin() + w, order.begin() + end,
+                [&](int32_t a, int32_t b) { return rowLength(a) > rowLength(b); });
+        }
+    }
+
+    const int32_t chunks = (rows + chunkHeight - 1) / chunkHeight;
+    rowOrder.assign(static_cast<size_t>(chunks) * chunkHeight, -1);
+    std::copy(order.begin(), order.end(), rowOrder.begin());
+    chunkWidth.resize(chunks);
+    chunkPtr.resize(static_cast<size_t>(chunks) + 1);
+    chunkPtr[0] = 0;
+    for (int32_t c = 0; c < chunks; c++) {
+        int32_t width = 0;
+        for (int l = 0; l < chunkHeight; l++) {
+            const int32_t row = rowOrder[static_cast<size_t>(c) * chunkHeight + l];
+            if (row >= 0) width = std::max(width, rowLength(row));
+        }
+        chunkWidth[c] = width;
+        chunkPtr[c + 1] = chunkPtr[c] + static_cast<int64_t>(width) * chunkHeight;
+    }
+
+    colIdx.assign(chunkPtr[chunks], 0);
+    values.assign(chunkPtr[chunks], 0.0);
+    for (int32_t c = 0; c < chunks; c++) {
+        for (int l = 0; l < chunkHeight; l++) {
+            const int32_t row = rowOrder[static_cast<size_t>(c) * chunkHeight + l];
+            if (row < 0) continue;
+            std::span<const int32_t> columns = csr.getRowColumns(row);
+            std::span<const double> rowValues = csr.getRowValues(row);
+            // Padding repeats the row's last column with weight 0, so it touches no new cache line
+            const int32_t padColumn = columns.empty() ? row : columns.back();
+            for (int k = 0; k < chunkWidth[c]; k++) {
+                const int64_t e = chunkPtr[c] + static_cast<int64_t>(k) * chunkHeight + l;
+                const bool stored = k < static_cast<int>(columns.size());
+                colIdx[e] = stored ? columns[k] : padColumn;
+                values[e] = stored ? rowValues[k] : 0.0;
+            }
+        }
+    }
+}
+
+SellMatrix::ChunkKernel SellMatrix::chunkKernel() const {
+    switch (simdLevel) {
+    case SimdLevel::AVX512:
+        return chunkHeight >= 8 ? sellChunkAvx512 : (chunkHeight >= 4 ? sellChunkAvx2 : sellChunkPortable);
+    case SimdLevel::AVX2:
+        return chunkHeight >= 4 ? sellChunkAvx2 : sellChunkPortable;
+    default:
+        return sellChunkPortable;
+    }
+}
+
+void SellMatrix::multiply(std::span<const double> x, std::span<double> y) const {
+    const ChunkKernel kernel = chunkKernel();
+    parallelFor(0, getChunkCount(), std::max(1, minRowsPerBlock / chunkHeight), numThreads, [&](int first, int last) {
+        for (int32_t c = first; c < last; c++) {
+            const SellChunk chunk{values.data() + chunkPtr[c], colIdx.data() + chunkPtr[c],
+                rowOrder.data() + static_cast<size_t>(c) * chunkHeight, chunkWidth[c], chunkHeight};
+            kernel(chunk, x.data(), y.data());
+        }
+    });
+}
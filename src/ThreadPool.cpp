@@ -0,0 +1,268 @@
+#include "ThreadPool.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#endif
+
+namespace {
+    // Pool and worker index of the calling thread, so nested loops start from their own deque
+    thread_local const ThreadPool* currentPool = nullptr;
+    thread_local int currentIndex = -1;
+
+    std::mutex globalMutex;
+    ThreadPoolOptions globalOptions;
+    std::unique_ptr<ThreadPool> globalPool;
+
+#if defined(__linux__)
+    // CPUs of each NUMA node that the process may run on; one group of all allowed CPUs if the
+    // node topology is not available
+    std::vector<std::vector<int>> numaGroups() {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        sched_getaffinity(0, sizeof(allowed), &allowed);
+
+        std::vector<std::vector<int>> groups;
+        for (int node = 0; ; node++) {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!file) break;
+            // Ranges like "0-3,8-11"
+            std::vector<int> cpus;
+            std::string range;
+            while (std::getline(file, range, ',')) {
+                const size_t dash = range.find('-');
+                const int first = std::stoi(range.substr(0, dash));
+                const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; cpu++) {
+                    if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+                }
+            }
+            if (!cpus.empty()) groups.push_back(std::move(cpus));
+        }
+        if (groups.empty()) {
+            groups.emplace_back();
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &allowed)) groups.back().push_back(cpu);
+            }
+        }
+        return groups;
+    }
+#endif
+}
+
+ThreadPool::ThreadPool(const ThreadPoolOptions& options) : pinning(options.pinning) {
+    const unsigned workers = options.workers > 0 ? options.workers : resolveThreadCount(0) - 1;
+    for (unsigned w = 0; w <= workers; w++) slots.push_back(std::make_unique<Slot>());
+    threads.reserve(workers);
+    for (unsigned w = 0; w < workers; w++) threads.emplace_back([this, w] { workerLoop(w); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+ThreadPool& ThreadPool::global() {
+    std::lock_guard<std::mutex> lock(globalMutex);
+    if (!globalPool) globalPool = std::make_unique<ThreadPool>(globalOptions);
+    return *globalPool;
+}
+
+void ThreadPool::configureGlobal(const ThreadPoolOptions& options) {
+    std::lock_guard<std::mutex> lock(globalMutex);
+    if (globalPool) {
+        throw std::logic_error("The shared thread pool is already running");
+    }
+    globalOptions = options;
+}
+
+int ThreadPool::currentWorker() {
+    return currentIndex;
+}
+
+SchedulerStats ThreadPool::getStats() const {
+    SchedulerStats stats;
+    for (unsigned w = 0; w < slots.size(); w++) {
+        const SchedulerStats worker = getWorkerStats(w);
+        stats.tasks += worker.tasks;
+        stats.steals += worker.steals;
+        stats.idleMilliseconds += worker.idleMilliseconds;
+    }
+    stats.jobs = jobs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+SchedulerStats ThreadPool::getWorkerStats(unsigned worker) const {
+    const Slot& slot = *slots[worker];
+    SchedulerStats stats;
+    stats.tasks = slot.executed.load(std::memory_order_relaxed);
+    stats.steals = slot.stolen.load(std::memory_order_relaxed);
+    stats.idleMilliseconds = static_cast<double>(slot.idleNanoseconds.load(std::memory_order_relaxed)) * 1e-6;
+    return stats;
+}
+
+void ThreadPool::resetStats() {
+    for (const std::unique_ptr<Slot>& slot : slots) {
+        slot->executed = 0;
+        slot->stolen = 0;
+        slot->idleNanoseconds = 0;
+    }
+    jobs = 0;
+}
+
+void ThreadPool::submit(Job& job, unsigned numThreads) {
+    if (job.tiles <= 0) return;
+    jobs.fetch_add(1, std::memory_order_relaxed);
+
+    const unsigned workers = getWorkerCount();
+    const int worker = currentPool == this ? currentIndex : -1;
+    const size_t own = worker >= 0 ? static_cast<size_t>(worker) : workers;
+    const unsigned available = worker >= 0 ? workers : workers + 1;
+    const int participants = static_cast<int>(std::min({resolveThreadCount(numThreads), available, static_cast<unsigned>(job.tiles)}));
+
+    // One thread: run the tiles in order without touching the deques
+    if (participants <= 1) {
+        for (int t = 0; t < job.tiles; t++) {
+            job.invoke(job.body, job.begin + t * job.tileSize, std::min(job.end, job.begin + (t + 1) * job.tileSize));
+        }
+        slots[own]->executed.fetch_add(job.tiles, std::memory_order_relaxed);
+        return;
+    }
+
+    job.maxThreads = participants;
+    job.remaining.store(job.tiles, std::memory_order_relaxed);
+    queued.fetch_add(job.tiles, std::memory_order_relaxed);
+
+    // Contiguous groups of tiles, the caller's first; each group goes to the front of its deque in
+    // order, so a thread finishes the newest (innermost) loop before returning to older tiles
+    for (int g = participants - 1; g >= 0; g--) {
+        const int first = static_cast<int>(static_cast<long long>(job.tiles) * g / participants);
+        const int last = static_cast<int>(static_cast<long long>(job.tiles) * (g + 1) / participants);
+        const size_t target = g == 0 ? own : (worker >= 0 ? (worker + g) % workers : (g - 1) % workers);
+        Slot& slot = *slots[target];
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        for (int t = last - 1; t >= first; t--) slot.tasks.push_front({&job, t});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        epoch.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_all();
+
+    // Help until every tile of the loop has finished
+    while (job.remaining.load(std::memory_order_acquire) > 0) {
+        if (!runOne(own)) std::this_thread::yield();
+    }
+    if (job.error) std::rethrow_exception(job.error);
+}
+
+void ThreadPool::execute(const Task& task) {
+    Job& job = *task.job;
+    const int first = job.begin + task.tile * job.tileSize;
+    try {
+        job.invoke(job.body, first, std::min(job.end, first + job.tileSize));
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(job.errorMutex);
+        if (!job.error) job.error = std::current_exception();
+    }
+    job.running.fetch_sub(1, std::memory_order_relaxed);
+    // The job lives on the submitting thread's stack; it must not be touched after this
+    job.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool ThreadPool::take(Slot& slot, bool front, Task& task) {
+    std::lock_guard<std::mutex> lock(slot.mutex);
+    if (slot.tasks.empty()) return false;
+    const Task& candidate = front ? slot.tasks.front() : slot.tasks.back();
+    Job& job = *candidate.job;
+    int running = job.running.load(std::memory_order_relaxed);
+    do {
+        if (running >= job.maxThreads) return false;
+    } while (!job.running.compare_exchange_weak(running, running + 1, std::memory_order_relaxed));
+
+    task = candidate;
+    if (front) slot.tasks.pop_front();
+    else slot.tasks.pop_back();
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ThreadPool::runOne(size_t own) {
+    Task task;
+    if (take(*slots[own], true, task)) {
+        execute(task);
+        slots[own]->executed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    for (size_t k = 1; k < slots.size(); k++) {
+        const size_t victim = (own + k) % slots.size();
+        if (take(*slots[victim], false, task)) {
+            execute(task);
+            slots[own]->executed.fetch_add(1, std::memory_order_relaxed);
+            slots[own]->stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentIndex = static_cast<int>(index);
+    pin(index);
+
+    Slot& slot = *slots[index];
+    while (true) {
+        const uint64_t seen = epoch.load(std::memory_order_acquire);
+        if (runOne(index)) continue;
+
+        // Nothing this thread may run: sleep until new tiles are dealt out. Tiles held back by
+        // their loop's thread limit are finished by the threads already in that loop
+        const auto start = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [&] { return stopping || epoch.load(std::memory_order_acquire) != seen; });
+        if (stopping) return;
+        slot.idleNanoseconds.fetch_add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()),
+            std::memory_order_relaxed);
+    }
+}
+
+void ThreadPool::pin([[maybe_unused]] unsigned index) {
+#if defined(__linux__)
+    if (pinning == ThreadPinning::NONE) return;
+    const std::vector<std::vector<int>> groups = numaGroups();
+
+    std::vector<int> order;
+    if (pinning == ThreadPinning::COMPACT) {
+        for (const std::vector<int>& group : groups) order.insert(order.end(), group.begin(), group.end());
+    }
+    else {
+        size_t longest = 0;
+        for (const std::vector<int>& group : groups) longest = std::max(longest, group.size());
+        for (size_t k = 0; k < longest; k++) {
+            for (const std::vector<int>& group : groups) {
+                if (k < group.size()) order.push_back(group[k]);
+            }
+        }
+    }
+    if (order.empty()) return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(order[index % order.size()], &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "Polygon.h"
+#include <filesystem>
+#include <string>
+
+/**
+ * @brief Builds the demo domain from main.cpp: a non-convex polygon with concave notches.
+ * @return The polygon.
+ */
+inline Polygon makeNotchedPolygon() {
+    return Polygon({ {.3f,0.f}, {.5f,.5f}, {1.0f, .3f}, {1.2f , 1.0f} ,{1.0f,1.2f}, {.7f,.8f}, {0.6f,.6f}, {0.0f,.8f} });
+}
+
+/**
+ * @brief Path in the temporary directory, removed when the test ends.
+ */
+class TemporaryPath {
+private:
+    std::string path;  /// @brief The full path
+
+public:
+    explicit TemporaryPath(const std::string& name) : path((std::filesystem::temp_directory_path() / name).string()) {}
+    ~TemporaryPath() { std::filesystem::remove(path); }
+    const std::string& get() const { return path; }
+};
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "DistributedPoissonSolver.h"
+#include "test_common.h"
+#include <atomic>
+#include <cmath>
+
+TEST(TestDomainDecomposition, BlocksCoverTheGridOnce) {
+    DomainDecomposition decomposition(37, 29, 3, 2);
+    ASSERT_EQ(decomposition.getRankCount(), 6);
+
+    std::vector<int> owners(37 * 29, -1);
+    for (int rank = 0; rank < decomposition.getRankCount(); rank++) {
+        const Subdomain& s = decomposition.getSubdomain(rank);
+        EXPECT_EQ(s.rank, rank);
+        EXPECT_GE(s.getWidth(), 12);
+        EXPECT_GE(s.getHeight(), 14);
+        for (int j = s.jBegin; j < s.jEnd; j++) {
+            for (int i = s.iBegin; i < s.iEnd; i++) {
+                ASSERT_EQ(owners[j * 37 + i], -1);
+                owners[j * 37 + i] = rank;
+                ASSERT_EQ(decomposition.ownerOf(i, j), rank);
+            }
+        }
+        // Neighbours are mutual and own the adjacent nodes
+        if (s.east >= 0) {
+            EXPECT_EQ(decomposition.getSubdomain(s.east).west, rank);
+            EXPECT_EQ(decomposition.ownerOf(s.iEnd, s.jBegin), s.east);
+        }
+        if (s.north >= 0) {
+            EXPECT_EQ(decomposition.getSubdomain(s.north).south, rank);
+            EXPECT_EQ(decomposition.ownerOf(s.iBegin, s.jEnd), s.north);
+        }
+    }
+    EXPECT_EQ(std::count(owners.begin(), owners.end(), -1), 0);
+}
+
+TEST(TestDomainDecomposition, ChoosesTheShortestCut) {
+    EXPECT_EQ(DomainDecomposition(100, 100, 4).getPx(), 2);
+    EXPECT_EQ(DomainDecomposition(400, 50, 4).getPx(), 4);
+    EXPECT_EQ(DomainDecomposition(50, 400, 4).getPy(), 4);
+    EXPECT_EQ(DomainDecomposition(100, 100, 7).getRankCount(), 7);
+    EXPECT_THROW(DomainDecomposition(3, 3, 16), std::invalid_argument);
+    EXPECT_THROW(DomainDecomposition(10, 10, 0, 1), std::invalid_argument);
+}
+
+TEST(TestHaloExchange, FillsGhostLayerFromNeighbours) {
+    DomainDecomposition decomposition(23, 17, 3, 2);
+    SharedMemoryWorld world(decomposition.getRankCount());
+    auto value = [](int i, int j) { return i + 1000.0 * j; };
+
+    world.run([&](Communicator& comm) {
+        const Subdomain& s = decomposition.getSubdomain(comm.getRank());
+        HaloExchange halo(s, comm);
+        std::vector<double> local(halo.getLocalSize(), -1.0);
+        for (int lj = 0; lj < s.getHeight(); lj++) {
+            for (int li = 0; li < s.getWidth(); li++) local[halo.localIndex(li, lj)] = value(s.iBegin + li, s.jBegin + lj);
+        }
+        halo.exchange(local);
+
+        for (int lj = -1; lj <= s.getHeight(); lj++) {
+            for (int li = -1; li <= s.getWidth(); li++) {
+                const int i = s.iBegin + li, j = s.jBegin + lj;
+                const bool corner = (li < 0 || li == s.getWidth()) && (lj < 0 || lj == s.getHeight());
+                const bool outside = i < 0 || j < 0 || i >= 23 || j >= 17;
+                const double expected = corner || outside ? -1.0 : value(i, j);
+                ASSERT_EQ(local[halo.localIndex(li, lj)], expected) << "rank " << comm.getRank() << " node (" << i << ", " << j << ")";
+            }
+        }
+        EXPECT_EQ(halo.getStats().exchanges, 1);
+        EXPECT_EQ(halo.getStats().messages, (s.west >= 0) + (s.east >= 0) + (s.south >= 0) + (s.north >= 0));
+    });
+}
+
+TEST(TestSharedMemoryWorld, ReductionsAreOrderedAndFailuresPropagate) {
+    SharedMemoryWorld world(4);
+    world.run([](Communicator& comm) {
+        EXPECT_EQ(comm.allreduceSum(comm.getRank() + 1.0), 10.0);
+        comm.barrier();
+        EXPECT_EQ(comm.allreduceSum(0.1 * comm.getRank()), 0.0 + 0.1 + 0.2 + 0.30000000000000004);
+    });
+
+    // A rank that throws releases the ranks blocked in a reduction
+    EXPECT_THROW(world.run([](Communicator& comm) {
+        if (comm.getRank() == 2) throw std::runtime_error("rank failed");
+        comm.allreduceSum(1.0);
+    }), std::runtime_error);
+    EXPECT_THROW(SharedMemoryWorld(0), std::invalid_argument);
+}
+
+TEST(TestDistributedPoissonSolver, MatchesPoissonSolver) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(67, 61, polygon);
+    auto source = [](const Point2D& p) { return std::sin(3.0 * p.x) * std::cos(2.0 * p.y); };
+    auto boundary = [](const Point2D& p) { return static_cast<double>(p.x) - p.y; };
+
+    for (BoundaryStencil stencil : {BoundaryStencil::SNAPPED, BoundaryStencil::SHORTLEY_WELLER}) {
+        SolveResult expected = PoissonSolver(grid, stencil).solve(source, boundary, {1e-12, 10000});
+        ASSERT_TRUE(expected.converged);
+
+        for (int ranks : {1, 2, 4, 6}) {
+            DomainDecomposition decomposition(grid.getNx(), grid.getNy(), ranks);
+            SharedMemoryWorld world(ranks);
+            std::atomic<int64_t> unknowns = 0;
+            world.run([&](Communicator& comm) {
+                DistributedPoissonSolver solver(polygon, decomposition, comm, stencil, 1);
+                unknowns += static_cast<int64_t>(solver.getLocalUnknownCount());
+                SolveResult actual = solver.solve(source, boundary, {1e-12, 10000});
+
+                EXPECT_TRUE(actual.converged);
+                EXPECT_NEAR(actual.iterations, expected.iterations, 2);
+                EXPECT_EQ(actual.field.getNx(), 0);
+
+                // Each rank classifies only a window around its block, with the types and arms of the full grid
+                const FDMGrid& local = solver.getGrid();
+                if (ranks > 1) {
+                    EXPECT_LT(local.getCells().size(), grid.getCells().size());
+                }
+                const Subdomain& s = solver.getSubdomain();
+                const auto [iLocal, jLocal] = local.pointToIndex(grid.indexToPoint(s.iBegin, s.jBegin));
+                for (int j = s.jBegin; j < s.jEnd; j++) {
+                    for (int i = s.iBegin; i < s.iEnd; i++) {
+                        const int li = iLocal + i - s.iBegin, lj = jLocal + j - s.jBegin;
+                        ASSERT_EQ(local.getCellType(li, lj), grid.getCellType(i, j));
+                        ASSERT_EQ(local.getBoundaryArms(li, lj), grid.getBoundaryArms(i, j));
+                        ASSERT_EQ(local.indexToPoint(li, lj), grid.indexToPoint(i, j));
+                    }
+                }
+
+                GridField field = solver.gather(solver.getLocalSolution());
+                if (comm.getRank() != 0) {
+                    EXPECT_EQ(field.getNx(), 0);
+                    return;
+                }
+                EXPECT_EQ(solver.getGlobalUnknownCount(), PoissonOperator(grid).getUnknownCount());
+                std::span<const double> a = field.getValues();
+                std::span<const double> e = expected.field.getValues();
+                ASSERT_EQ(a.size(), e.size());
+                for (size_t c = 0; c < a.size(); c++) {
+                    ASSERT_NEAR(a[c], e[c], 1e-9) << ranks << " ranks, cell " << c;
+                }
+            });
+            EXPECT_EQ(unknowns, PoissonOperator(grid).getUnknownCount());
+        }
+    }
+}
+
+TEST(TestDistributedPoissonSolver, RejectsMismatchedDecomposition) {
+    Polygon polygon = makeNotchedPolygon();
+    SharedMemoryWorld world(2);
+    EXPECT_THROW(world.run([&](Communicator& comm) {
+        DistributedPoissonSolver solver(polygon, DomainDecomposition(31, 31, 4), comm);
+    }), std::invalid_argument);
+}
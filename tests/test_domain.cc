@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "Domain.h"
+#include "FDMGrid.h"
+#include "PoissonSolver.h"
+#include <cmath>
+
+namespace {
+    std::vector<Point2D> rectangle(float x0, float y0, float x1, float y1) {
+        return { {x0, y0}, {x1, y0}, {x1, y1}, {x0, y1} };
+    }
+
+    // Plate with two rectangular cut-outs and a triangular one wound clockwise
+    Domain makePlate(ValidationMethod method = ValidationMethod::SWEEP_LINE) {
+        return Domain(rectangle(0.f, 0.f, 2.f, 1.f),
+            { rectangle(.2f, .2f, .6f, .7f), rectangle(.9f, .3f, 1.1f, .5f), { {1.4f, .2f}, {1.6f, .8f}, {1.8f, .2f} } }, method);
+    }
+}
+
+TEST(TestDomain, ValidatesAllRingsTogether) {
+    for (ValidationMethod method : {ValidationMethod::SWEEP_LINE, ValidationMethod::BRUTE_FORCE}) {
+        EXPECT_NO_THROW(makePlate(method));
+        const std::vector<Point2D> outer = rectangle(0.f, 0.f, 2.f, 1.f);
+        // A hole crossing the outer boundary, another hole, or touching the outer boundary
+        EXPECT_THROW(Domain(outer, {rectangle(1.8f, .4f, 2.2f, .6f)}, method), std::invalid_argument);
+        EXPECT_THROW(Domain(outer, {rectangle(.2f, .2f, .6f, .6f), rectangle(.5f, .5f, .8f, .8f)}, method), std::invalid_argument);
+        EXPECT_THROW(Domain(outer, {rectangle(0.f, .2f, .5f, .6f)}, method), std::invalid_argument);
+        // A self-intersecting hole
+        EXPECT_THROW(Domain(outer, {{ {.2f, .2f}, {.6f, .6f}, {.6f, .2f}, {.2f, .6f} }}, method), std::invalid_argument);
+        EXPECT_THROW(Domain(outer, {{ {.2f, .2f}, {.6f, .6f} }}, method), std::invalid_argument);
+    }
+    // Disjoint rings in the wrong places
+    EXPECT_THROW(Domain(rectangle(0.f, 0.f, 1.f, 1.f), {rectangle(2.f, 2.f, 3.f, 3.f)}), std::invalid_argument);
+    EXPECT_THROW(Domain(rectangle(0.f, 0.f, 1.f, 1.f), {rectangle(.1f, .1f, .9f, .9f), rectangle(.3f, .3f, .6f, .6f)}), std::invalid_argument);
+}
+
+TEST(TestDomain, ContainsPointExcludesHoles) {
+    const Domain domain = makePlate();
+    EXPECT_EQ(domain.getHoles().size(), 3u);
+    EXPECT_EQ(domain.getEdgeCount(), 4u + 4u + 4u + 3u);
+    EXPECT_EQ(domain.getRings().size(), 4u);
+    EXPECT_TRUE(domain.containsPoint({.1f, .1f}));
+    EXPECT_FALSE(domain.containsPoint({.4f, .4f}));
+    EXPECT_FALSE(domain.containsPoint({1.f, .4f}));
+    EXPECT_FALSE(domain.containsPoint({1.6f, .4f}));
+    EXPECT_TRUE(domain.containsPoint({1.6f, .9f}));
+    EXPECT_FALSE(domain.containsPoint({2.5f, .5f}));
+    EXPECT_TRUE(domain.isOnBoundary({.4f, .2f}, 1e-6f));
+    EXPECT_TRUE(domain.isOnBoundary({2.f, .5f}, 1e-6f));
+    EXPECT_FALSE(domain.isOnBoundary({.1f, .1f}, 1e-6f));
+}
+
+TEST(TestDomain, GridClassifiesHolesInOnePass) {
+    const Domain domain = makePlate();
+    FDMGrid grid(161, 81, domain);
+    EXPECT_EQ(grid.getOriginX(), 0.f);
+    EXPECT_FLOAT_EQ(grid.getDx(), 2.f / 160);
+
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            const GridType type = grid.getCellType(i, j);
+            ASSERT_NE(type, UNDEFINED);
+            if (type == BOUNDARY) continue;
+            EXPECT_EQ(type == INTERIOR, domain.containsPoint(grid.indexToPoint(i, j))) << "cell (" << i << ", " << j << ")";
+            // Interior and exterior cells are always separated by a boundary cell
+            if (type == INTERIOR) {
+                EXPECT_NE(grid.getCellType(i + 1, j), EXTERIOR);
+                EXPECT_NE(grid.getCellType(i, j + 1), EXTERIOR);
+                EXPECT_NE(grid.getCellType(i - 1, j), EXTERIOR);
+                EXPECT_NE(grid.getCellType(i, j - 1), EXTERIOR);
+            }
+        }
+    }
+    EXPECT_GT(grid.getCellCount(EXTERIOR), 0u);
+
+    // A domain without holes classifies exactly like its polygon
+    Polygon outer({ {.3f,0.f}, {.5f,.5f}, {1.0f, .3f}, {1.2f , 1.0f} ,{1.0f,1.2f}, {.7f,.8f}, {0.6f,.6f}, {0.0f,.8f} });
+    FDMGrid expected(97, 83, outer);
+    FDMGrid actual(97, 83, Domain(outer));
+    EXPECT_TRUE(std::ranges::equal(expected.getCells(), actual.getCells()));
+    EXPECT_TRUE(std::ranges::equal(expected.getArmCells(), actual.getArmCells()));
+}
+
+TEST(TestDomain, PoissonSolverHandlesHoles) {
+    // A linear field is reproduced exactly by the 5-point stencil with Dirichlet values on every ring
+    FDMGrid grid(121, 61, makePlate());
+    auto exact = [](const Point2D& p) { return 1.0 + 2.0 * p.x - 3.0 * p.y; };
+    SolveResult result = PoissonSolver(grid).solve([](const Point2D&) { return 0.0; }, exact, {1e-12, 10000});
+    ASSERT_TRUE(result.converged);
+
+    double maxError = 0.0;
+    for (CellIndex c : grid.cellsOfType(INTERIOR)) {
+        maxError = std::max(maxError, std::abs(result.field(c.i, c.j) - exact(grid.indexToPoint(c.i, c.j))));
+    }
+    EXPECT_LT(maxError, 1e-6);
+}
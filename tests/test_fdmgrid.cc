@@ -0,0 +1,425 @@
+#include <gtest/gtest.h>
+#include "FDMGrid.h"
+#include "PackedCells.h"
+#include "test_common.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+    Polygon makeSquare() {
+        return Polygon({ {0.f, 0.f}, {1.f, 0.f}, {1.f, 1.f}, {0.f, 1.f} });
+    }
+}
+
+TEST(TestFDMGrid, CellsAreContiguousRowMajor) {
+    Polygon square = makeSquare();
+    FDMGrid grid(7, 5, square);
+
+    std::span<const GridType> cells = grid.getCells();
+    ASSERT_EQ(cells.size(), 7u * 5u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(cells.data()) % 64, 0u);
+
+    for (int j = 0; j < grid.getNy(); j++) {
+        std::span<const GridType> row = grid.getRow(j);
+        ASSERT_EQ(row.size(), 7u);
+        EXPECT_EQ(row.data(), cells.data() + grid.cellIndex(0, j));
+        for (int i = 0; i < grid.getNx(); i++) {
+            EXPECT_EQ(row[i], grid.getCellType(i, j));
+        }
+    }
+}
+
+TEST(TestFDMGrid, SquareClassification) {
+    Polygon square = makeSquare();
+    FDMGrid grid(5, 5, square);
+
+    for (int j = 0; j < 5; j++) {
+        for (int i = 0; i < 5; i++) {
+            const bool onEdge = i == 0 || j == 0 || i == 4 || j == 4;
+            EXPECT_EQ(grid.getCellType(i, j), onEdge ? BOUNDARY : INTERIOR) << "cell (" << i << ", " << j << ")";
+        }
+    }
+    EXPECT_EQ(grid.getCellType(-1, 0), EXTERIOR);
+    EXPECT_EQ(grid.getCellType(0, 5), EXTERIOR);
+}
+
+TEST(TestFDMGrid, PointsOfTypeInStorageOrder) {
+    Polygon square = makeSquare();
+    FDMGrid grid(5, 5, square);
+
+    std::vector<Point2D> interior = grid.getInteriorPoints();
+    ASSERT_EQ(interior.size(), 9u);
+    EXPECT_EQ(interior.front(), grid.indexToPoint(1, 1));
+    EXPECT_EQ(interior[1], grid.indexToPoint(2, 1));
+    EXPECT_EQ(interior.back(), grid.indexToPoint(3, 3));
+    EXPECT_EQ(grid.getBoundaryPoints().size(), 16u);
+    EXPECT_TRUE(grid.getExteriorPoints().empty());
+}
+
+TEST(TestFDMGrid, LazyViewsMatchPointsOfType) {
+    static_assert(std::ranges::forward_range<CellTypeView> && std::ranges::view<CellTypeView>);
+    Polygon polygon({ {.3f,0.f}, {.5f,.5f}, {1.0f, .3f}, {1.2f , 1.0f} ,{1.0f,1.2f}, {.7f,.8f}, {0.6f,.6f}, {0.0f,.8f} });
+    FDMGrid grid(61, 47, polygon);
+
+    size_t total = 0;
+    for (GridType type : {BOUNDARY, INTERIOR, EXTERIOR}) {
+        std::vector<CellIndex> expected;
+        for (int j = 0; j < grid.getNy(); j++) {
+            for (int i = 0; i < grid.getNx(); i++) {
+                if (grid.getCellType(i, j) == type) expected.push_back({i, j});
+            }
+        }
+        EXPECT_EQ(grid.getCellCount(type), expected.size());
+        total += grid.getCellCount(type);
+
+        size_t k = 0;
+        for (CellIndex c : grid.cellsOfType(type)) {
+            ASSERT_LT(k, expected.size());
+            EXPECT_EQ(c.i, expected[k].i);
+            EXPECT_EQ(c.j, expected[k].j);
+            k++;
+        }
+        EXPECT_EQ(k, expected.size());
+
+        const std::vector<Point2D> points = grid.getPointsOfType(type);
+        EXPECT_TRUE(std::ranges::equal(grid.pointsOfType(type), points));
+    }
+    EXPECT_EQ(total, grid.getCells().size());
+    EXPECT_EQ(grid.getCellCount(UNDEFINED), 0u);
+
+    std::span<const size_t> interior = grid.getInteriorCells();
+    ASSERT_EQ(interior.size(), grid.getCellCount(INTERIOR));
+    for (size_t c : interior) EXPECT_EQ(grid.getCells()[c], INTERIOR);
+    EXPECT_TRUE(std::is_sorted(interior.begin(), interior.end()));
+}
+
+TEST(TestFDMGrid, ParallelClassificationMatchesSerial) {
+    Polygon polygon({ {.3f,0.f}, {.5f,.5f}, {1.0f, .3f}, {1.2f , 1.0f} ,{1.0f,1.2f}, {.7f,.8f}, {0.6f,.6f}, {0.0f,.8f} });
+    FDMGrid serial(1031, 997, polygon, 1);
+
+    for (unsigned threads : {2u, 3u, 8u, 0u}) {
+        FDMGrid parallel(1031, 997, polygon, threads);
+        std::span<const GridType> expected = serial.getCells();
+        std::span<const GridType> actual = parallel.getCells();
+        ASSERT_EQ(expected.size(), actual.size());
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), actual.begin())) << threads << " threads";
+    }
+}
+
+namespace {
+    // Interior and exterior cells must always be separated by a boundary cell
+    void expectBoundarySeparates(const FDMGrid& grid) {
+        for (int j = 0; j < grid.getNy(); j++) {
+            for (int i = 0; i < grid.getNx(); i++) {
+                if (grid.getCellType(i, j) != INTERIOR) continue;
+                EXPECT_NE(grid.getCellType(i + 1, j), EXTERIOR) << "cell (" << i << ", " << j << ")";
+                EXPECT_NE(grid.getCellType(i - 1, j), EXTERIOR) << "cell (" << i << ", " << j << ")";
+                EXPECT_NE(grid.getCellType(i, j + 1), EXTERIOR) << "cell (" << i << ", " << j << ")";
+                EXPECT_NE(grid.getCellType(i, j - 1), EXTERIOR) << "cell (" << i << ", " << j << ")";
+            }
+        }
+    }
+}
+
+TEST(TestFDMGrid, ClassificationAgreesWithContainsPoint) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(97, 83, polygon);
+
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            const GridType type = grid.getCellType(i, j);
+            ASSERT_NE(type, UNDEFINED);
+            if (type == BOUNDARY) continue;
+            EXPECT_EQ(type == INTERIOR, polygon.containsPoint(grid.indexToPoint(i, j))) << "cell (" << i << ", " << j << ")";
+        }
+    }
+    expectBoundarySeparates(grid);
+}
+
+TEST(TestFDMGrid, VertexOnScanLine) {
+    // Every vertex of the diamond lies exactly on a scan line and a column
+    Polygon diamond({ {2.f, 0.f}, {4.f, 2.f}, {2.f, 4.f}, {0.f, 2.f} });
+    FDMGrid grid(9, 9, diamond);
+
+    for (int j = 0; j < 9; j++) {
+        for (int i = 0; i < 9; i++) {
+            // Cells next to the 45-degree edges tie between two nearest nodes, only check unambiguous ones
+            const int d = std::abs(i - 4) + std::abs(j - 4);
+            if (d == 3 || d == 5) continue;
+            const GridType expected = d < 4 ? INTERIOR : (d == 4 ? BOUNDARY : EXTERIOR);
+            EXPECT_EQ(grid.getCellType(i, j), expected) << "cell (" << i << ", " << j << ")";
+        }
+    }
+    expectBoundarySeparates(grid);
+}
+
+TEST(TestFDMGrid, HorizontalEdgesAndTouchingVertices) {
+    // A "W"-like outline: horizontal top edge and a reflex notch whose tip touches a scan line
+    Polygon polygon({ {0.f, 0.f}, {2.f, 2.f}, {4.f, 0.f}, {4.f, 4.f}, {0.f, 4.f} });
+    FDMGrid grid(9, 9, polygon);
+
+    for (int i = 0; i < 9; i++) {
+        EXPECT_EQ(grid.getCellType(i, 8), BOUNDARY) << "top edge cell " << i;
+    }
+    EXPECT_EQ(grid.getCellType(4, 4), BOUNDARY);
+    EXPECT_EQ(grid.getCellType(4, 5), INTERIOR);
+    EXPECT_EQ(grid.getCellType(4, 2), EXTERIOR);
+    EXPECT_EQ(grid.getCellType(1, 4), INTERIOR);
+    EXPECT_EQ(grid.getCellType(7, 4), INTERIOR);
+    expectBoundarySeparates(grid);
+}
+
+TEST(TestFDMGrid, BoundaryArmsEndOnThePolygon) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(73, 67, polygon);
+    const std::vector<Point2D>& vertices = polygon.getVertices();
+
+    // Distance from a point to the polygon outline
+    auto distance = [&](double x, double y) {
+        double best = 1e30;
+        for (size_t v = 0; v < vertices.size(); v++) {
+            const Point2D& a = vertices[v];
+            const Point2D& b = vertices[(v + 1) % vertices.size()];
+            const double ex = b.x - a.x, ey = b.y - a.y;
+            const double t = std::clamp(((x - a.x) * ex + (y - a.y) * ey) / (ex * ex + ey * ey), 0.0, 1.0);
+            best = std::min(best, std::hypot(x - a.x - t * ex, y - a.y - t * ey));
+        }
+        return best;
+    };
+
+    size_t cut = 0;
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (grid.getCellType(i, j) != INTERIOR) {
+                const BoundaryArms arms = grid.getBoundaryArms(i, j);
+                ASSERT_EQ(arms.west + arms.east + arms.south + arms.north, 4.0f);
+                continue;
+            }
+            const BoundaryArms arms = grid.getBoundaryArms(i, j);
+            const Point2D p = grid.indexToPoint(i, j);
+            const struct { int di, dj; float arm; double h; } directions[] = {
+                {-1, 0, arms.west, grid.getDx()}, {1, 0, arms.east, grid.getDx()},
+                {0, -1, arms.south, grid.getDy()}, {0, 1, arms.north, grid.getDy()}};
+            for (const auto& d : directions) {
+                ASSERT_GT(d.arm, 0.0f);
+                ASSERT_LT(d.arm, 8.0f);
+                if (grid.getCellType(i + d.di, j + d.dj) == INTERIOR) {
+                    ASSERT_EQ(d.arm, 1.0f);
+                    continue;
+                }
+                // The arm ends on an edge, unless it falls back to the neighbouring node
+                const double x = p.x + d.di * d.arm * d.h, y = p.y + d.dj * d.arm * d.h;
+                if (d.arm != 1.0f) {
+                    ASSERT_LT(distance(x, y), 1e-4 * d.h) << "cell (" << i << ", " << j << ")";
+                    cut++;
+                }
+            }
+        }
+    }
+    EXPECT_GT(cut, 0u);
+    EXPECT_EQ(grid.getArmCells().size(), grid.getArms().size());
+    EXPECT_TRUE(std::is_sorted(grid.getArmCells().begin(), grid.getArmCells().end()));
+}
+
+TEST(TestFDMGrid, MoveVerticesMatchesRebuild) {
+    // Star whose outer vertices fix the bounding box; only inner vertices move
+    const int n = 64;
+    std::vector<Point2D> vertices;
+    for (int k = 0; k < n; k++) {
+        const double angle = 2.0 * 3.14159265358979323846 * k / n;
+        const double radius = (k % 2 == 0) ? 1.0 : 0.7;
+        vertices.emplace_back(static_cast<float>(radius * std::cos(angle)), static_cast<float>(radius * std::sin(angle)));
+    }
+    Polygon polygon(vertices);
+    FDMGrid grid(181, 173, polygon);
+
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int> inner(0, n / 2 - 1);
+    std::uniform_real_distribution<double> radius(0.55, 0.9);
+    size_t changedTotal = 0;
+    for (int step = 0; step < 12; step++) {
+        std::vector<VertexMove> moves;
+        for (int m = 0; m < 1 + step % 3; m++) {
+            const size_t k = static_cast<size_t>(2 * inner(rng) + 1);
+            if (std::any_of(moves.begin(), moves.end(), [k](const VertexMove& move) { return move.index == k; })) continue;
+            const double angle = 2.0 * 3.14159265358979323846 * k / n, r = radius(rng);
+            moves.push_back({k, Point2D(static_cast<float>(r * std::cos(angle)), static_cast<float>(r * std::sin(angle)))});
+        }
+        const std::vector<GridType> before(grid.getCells().begin(), grid.getCells().end());
+        const std::vector<size_t> armCellsBefore(grid.getArmCells().begin(), grid.getArmCells().end());
+        const std::vector<BoundaryArms> armsBefore(grid.getArms().begin(), grid.getArms().end());
+
+        const GridUpdate update = grid.moveVertices(polygon, moves);
+        Polygon moved(polygon.getVertices());
+        const FDMGrid fresh(181, 173, moved);
+
+        ASSERT_TRUE(std::ranges::equal(grid.getCells(), fresh.getCells())) << "step " << step;
+        ASSERT_TRUE(std::ranges::equal(grid.getArmCells(), fresh.getArmCells())) << "step " << step;
+        ASSERT_TRUE(std::ranges::equal(grid.getArms(), fresh.getArms())) << "step " << step;
+        ASSERT_TRUE(std::ranges::equal(grid.getInteriorCells(), fresh.getInteriorCells())) << "step " << step;
+        for (GridType type : {BOUNDARY, INTERIOR, EXTERIOR}) {
+            ASSERT_EQ(grid.getCellCount(type), fresh.getCellCount(type));
+        }
+
+        // Exactly the cells whose type differs are reported, with both types
+        std::vector<size_t> expectedCells;
+        for (size_t c = 0; c < before.size(); c++) {
+            if (before[c] != grid.getCells()[c]) expectedCells.push_back(c);
+        }
+        ASSERT_EQ(update.changedCells.size(), expectedCells.size());
+        int classifiedArea = 0;
+        for (const CellBox& tile : update.classified) classifiedArea += (tile.iEnd - tile.iBegin) * (tile.jEnd - tile.jBegin);
+        EXPECT_LE(update.classified.size(), moves.size());
+        EXPECT_LT(classifiedArea, static_cast<int>(moves.size()) * grid.getNx() * grid.getNy() / 16);
+        for (size_t k = 0; k < expectedCells.size(); k++) {
+            const int i = static_cast<int>(expectedCells[k] % grid.getNx()), j = static_cast<int>(expectedCells[k] / grid.getNx());
+            EXPECT_TRUE(std::any_of(update.classified.begin(), update.classified.end(), [&](const CellBox& tile) {
+                return i >= tile.iBegin && i < tile.iEnd && j >= tile.jBegin && j < tile.jEnd;
+            })) << "cell (" << i << ", " << j << ")";
+            EXPECT_EQ(update.changedCells[k].cell, expectedCells[k]);
+            EXPECT_EQ(update.changedCells[k].previous, before[expectedCells[k]]);
+            EXPECT_EQ(update.changedCells[k].current, grid.getCells()[expectedCells[k]]);
+        }
+        changedTotal += expectedCells.size();
+
+        // And exactly the cut cells whose arms appeared, vanished or changed
+        std::vector<size_t> expectedArms;
+        std::set_symmetric_difference(armCellsBefore.begin(), armCellsBefore.end(),
+            grid.getArmCells().begin(), grid.getArmCells().end(), std::back_inserter(expectedArms));
+        for (size_t k = 0; k < armCellsBefore.size(); k++) {
+            const int i = static_cast<int>(armCellsBefore[k] % grid.getNx()), j = static_cast<int>(armCellsBefore[k] / grid.getNx());
+            const auto it = std::lower_bound(grid.getArmCells().begin(), grid.getArmCells().end(), armCellsBefore[k]);
+            if (it != grid.getArmCells().end() && *it == armCellsBefore[k] && grid.getBoundaryArms(i, j) != armsBefore[k]) {
+                expectedArms.push_back(armCellsBefore[k]);
+            }
+        }
+        std::sort(expectedArms.begin(), expectedArms.end());
+        ASSERT_EQ(update.changedArms, expectedArms) << "step " << step;
+    }
+    EXPECT_GT(changedTotal, 0u);
+}
+
+TEST(TestFDMGrid, MoveVerticesTilesFarApartRunsSeparately) {
+    // Star as above; two runs of vertices move on opposite sides, one of them across vertex 0,
+    // which stays put so the bounding box does not change
+    const int n = 64;
+    std::vector<Point2D> vertices;
+    for (int k = 0; k < n; k++) {
+        const double angle = 2.0 * 3.14159265358979323846 * k / n;
+        const double radius = (k % 2 == 0) ? 1.0 : 0.7;
+        vertices.emplace_back(static_cast<float>(radius * std::cos(angle)), static_cast<float>(radius * std::sin(angle)));
+    }
+    Polygon polygon(vertices);
+    FDMGrid grid(181, 173, polygon);
+    auto inward = [&](size_t k) {
+        return VertexMove{k, Point2D(0.8f * vertices[k].x, 0.8f * vertices[k].y)};
+    };
+    const std::vector<VertexMove> moves{inward(1), inward(33), inward(63), inward(34), {0, vertices[0]}};
+    const GridUpdate update = grid.moveVertices(polygon, moves);
+    Polygon moved(polygon.getVertices());
+    const FDMGrid fresh(181, 173, moved);
+    ASSERT_TRUE(std::ranges::equal(grid.getCells(), fresh.getCells()));
+    ASSERT_TRUE(std::ranges::equal(grid.getArms(), fresh.getArms()));
+    ASSERT_TRUE(std::ranges::equal(grid.getInteriorCells(), fresh.getInteriorCells()));
+    EXPECT_FALSE(update.changedCells.empty());
+
+    // One tile per run; neither covers the grid or the gap between the runs
+    ASSERT_EQ(update.classified.size(), 2u);
+    const auto [iCentre, jCentre] = grid.pointToIndex(Point2D(0.f, 0.f));
+    for (const CellBox& tile : update.classified) {
+        EXPECT_LT((tile.iEnd - tile.iBegin) * (tile.jEnd - tile.jBegin), grid.getNx() * grid.getNy() / 16);
+        EXPECT_FALSE(iCentre >= tile.iBegin && iCentre < tile.iEnd && jCentre >= tile.jBegin && jCentre < tile.jEnd);
+    }
+    const CellBox& a = update.classified[0];
+    const CellBox& b = update.classified[1];
+    EXPECT_TRUE(a.iEnd <= b.iBegin || b.iEnd <= a.iBegin || a.jEnd <= b.jBegin || b.jEnd <= a.jBegin);
+    EXPECT_EQ(update.measured.size(), 2u);
+}
+
+TEST(TestFDMGrid, MoveVerticesRejectedLeavesGridUnchanged) {
+    Polygon square = makeSquare();
+    FDMGrid grid(21, 21, square);
+    const std::vector<GridType> before(grid.getCells().begin(), grid.getCells().end());
+
+    // Pulling a corner across the opposite edge makes the outline cross itself
+    const std::vector<VertexMove> moves{{1, Point2D(-0.5f, 0.5f)}};
+    EXPECT_THROW(grid.moveVertices(square, moves), std::invalid_argument);
+    EXPECT_TRUE(std::ranges::equal(grid.getCells(), before));
+    EXPECT_EQ(square.getVertices()[1], Point2D(1.f, 0.f));
+}
+
+TEST(TestFDMGrid, WindowMatchesFullGrid) {
+    Polygon polygon = makeNotchedPolygon();
+    const FDMGrid full(97, 89, polygon);
+    const CellBox window{31, 70, 12, 53};
+    const FDMGrid grid(97, 89, polygon, window);
+    ASSERT_EQ(grid.getNx(), window.iEnd - window.iBegin);
+    ASSERT_EQ(grid.getNy(), window.jEnd - window.jBegin);
+    EXPECT_EQ(grid.getOriginX(), full.indexToPoint(window.iBegin, 0).x);
+
+    // Arms are exact wherever the window reaches armReach cells further than the cell
+    const int reach = FDMGrid::armReach;
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            const int fi = window.iBegin + i, fj = window.jBegin + j;
+            ASSERT_EQ(grid.getCellType(i, j), full.getCellType(fi, fj)) << "cell (" << fi << ", " << fj << ")";
+            ASSERT_EQ(grid.indexToPoint(i, j), full.indexToPoint(fi, fj));
+            ASSERT_EQ(grid.pointToIndex(full.indexToPoint(fi, fj)), std::make_pair(i, j));
+            if (i >= reach && i < grid.getNx() - reach && j >= reach && j < grid.getNy() - reach) {
+                ASSERT_EQ(grid.getBoundaryArms(i, j), full.getBoundaryArms(fi, fj)) << "cell (" << fi << ", " << fj << ")";
+            }
+        }
+    }
+    EXPECT_GT(grid.getCellCount(INTERIOR), 0u);
+
+    EXPECT_THROW(FDMGrid(97, 89, polygon, CellBox{-1, 10, 0, 10}), std::invalid_argument);
+    EXPECT_THROW(FDMGrid(97, 89, polygon, CellBox{90, 98, 0, 10}), std::invalid_argument);
+    EXPECT_THROW(FDMGrid(97, 89, polygon, CellBox{10, 10, 0, 10}), std::invalid_argument);
+}
+
+TEST(TestPackedCells, MatchesByteClassification) {
+    Polygon polygon = makeNotchedPolygon();
+    // Widths below, at and across the 64-cell word size
+    for (int nx : {7, 64, 65, 130}) {
+        FDMGrid grid(nx, 53, polygon);
+        PackedCells packed(grid);
+        ASSERT_EQ(packed.getWordsPerRow(), (nx + 63) / 64);
+        EXPECT_LE(packed.getMemoryBytes(), static_cast<size_t>(packed.getWordsPerRow()) * 53 * 16);
+
+        AlignedVector<GridType> cells = packed.unpack();
+        std::span<const GridType> expected = grid.getCells();
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), cells.begin(), cells.end())) << nx << " columns";
+        EXPECT_EQ(packed.getCellType(-1, 0), EXTERIOR);
+        EXPECT_EQ(packed.getCellType(nx, 0), EXTERIOR);
+
+        for (GridType type : {BOUNDARY, INTERIOR, EXTERIOR, UNDEFINED}) {
+            EXPECT_EQ(packed.count(type), static_cast<size_t>(std::count(expected.begin(), expected.end(), type)));
+            const std::vector<Point2D> a = packed.getPointsOfType(type);
+            const std::vector<Point2D> e = grid.getPointsOfType(type);
+            ASSERT_EQ(a.size(), e.size());
+            for (size_t k = 0; k < a.size(); k++) {
+                ASSERT_EQ(a[k].x, e[k].x);
+                ASSERT_EQ(a[k].y, e[k].y);
+            }
+        }
+    }
+}
+
+TEST(TestPackedCells, MatchesWindowPoints) {
+    Polygon polygon = makeNotchedPolygon();
+    const FDMGrid grid(197, 173, polygon, CellBox{61, 150, 23, 120});
+    const PackedCells packed(grid);
+
+    // Points of a window are offset from the full grid's origin, exactly as FDMGrid computes them
+    for (GridType type : {BOUNDARY, INTERIOR, EXTERIOR}) {
+        const std::vector<Point2D> a = packed.getPointsOfType(type);
+        const std::vector<Point2D> e = grid.getPointsOfType(type);
+        ASSERT_EQ(a.size(), e.size());
+        EXPECT_GT(a.size(), 0u);
+        for (size_t k = 0; k < a.size(); k++) {
+            ASSERT_EQ(a[k].x, e[k].x) << "point " << k;
+            ASSERT_EQ(a[k].y, e[k].y) << "point " << k;
+        }
+    }
+}
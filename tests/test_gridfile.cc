@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "GridFile.h"
+#include "GridField.h"
+#include "test_common.h"
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+
+TEST(TestGridFile, RoundTripIsZeroCopyAndAligned) {
+    Polygon polygon = makeNotchedPolygon();
+    const FDMGrid grid(61, 47, polygon);
+    GridField potential(grid.getNx(), grid.getNy());
+    GridField source(grid.getNx(), grid.getNy(), 2.5);
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) potential(i, j) = i - 0.5 * j;
+    }
+    const TemporaryPath path("pde_solver_roundtrip.grid");
+    const GridFileField fields[] = {{"potential", potential.getValues()}, {"source", source.getValues()}};
+    GridFile::write(path.get(), grid, fields);
+    EXPECT_FALSE(std::filesystem::exists(path.get() + ".tmp"));
+
+    const GridFile file(path.get());
+    EXPECT_EQ(file.getVersion(), GridFile::version);
+    EXPECT_EQ(file.getNx(), grid.getNx());
+    EXPECT_EQ(file.getNy(), grid.getNy());
+    EXPECT_EQ(file.getOriginX(), grid.getOriginX());
+    EXPECT_EQ(file.getDy(), grid.getDy());
+    EXPECT_TRUE(std::ranges::equal(file.getCells(), grid.getCells()));
+    EXPECT_TRUE(std::ranges::equal(file.getArmCells(), grid.getArmCells()));
+    EXPECT_TRUE(std::ranges::equal(file.getArms(), grid.getArms()));
+    EXPECT_TRUE(std::ranges::equal(file.getInteriorCells(), grid.getInteriorCells()));
+    EXPECT_TRUE(std::ranges::equal(file.getRow(5), grid.getRow(5)));
+    EXPECT_EQ(std::ranges::distance(file.cellsOfType(BOUNDARY)), static_cast<std::ptrdiff_t>(grid.getCellCount(BOUNDARY)));
+    for (GridType type : {BOUNDARY, INTERIOR, EXTERIOR}) {
+        EXPECT_EQ(file.getCellCount(type), grid.getCellCount(type));
+    }
+
+    EXPECT_EQ(file.getFieldNames(), (std::vector<std::string>{"potential", "source"}));
+    EXPECT_TRUE(std::ranges::equal(file.getField("potential"), potential.getValues()));
+    EXPECT_TRUE(std::ranges::equal(file.getField("source"), source.getValues()));
+    EXPECT_FALSE(file.hasField("velocity"));
+    EXPECT_THROW(file.getField("velocity"), std::invalid_argument);
+
+    // Every section is a cache-line aligned view into the mapping
+    for (const void* section : {static_cast<const void*>(file.getCells().data()), static_cast<const void*>(file.getArms().data()),
+                                static_cast<const void*>(file.getField("source").data())}) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(section) % 64, 0u);
+    }
+
+    // An owning grid built from the file matches the original
+    const FDMGrid loaded(file);
+    EXPECT_EQ(loaded.getDx(), grid.getDx());
+    EXPECT_TRUE(std::ranges::equal(loaded.getCells(), grid.getCells()));
+    EXPECT_TRUE(std::ranges::equal(loaded.getArms(), grid.getArms()));
+    EXPECT_TRUE(std::ranges::equal(loaded.getInteriorCells(), grid.getInteriorCells()));
+    EXPECT_EQ(loaded.getCellCount(INTERIOR), grid.getCellCount(INTERIOR));
+}
+
+TEST(TestGridFile, RejectsBadFieldsAndFiles) {
+    Polygon polygon = makeNotchedPolygon();
+    const FDMGrid grid(21, 17, polygon);
+    const TemporaryPath path("pde_solver_rejects.grid");
+    const std::vector<double> shortField(10, 0.0), values(grid.getCells().size(), 1.0);
+
+    const GridFileField wrongSize[] = {{"u", shortField}};
+    const GridFileField unnamed[] = {{"", values}};
+    const GridFileField repeated[] = {{"u", values}, {"u", values}};
+    EXPECT_THROW(GridFile::write(path.get(), grid, wrongSize), std::invalid_argument);
+    EXPECT_THROW(GridFile::write(path.get(), grid, unnamed), std::invalid_argument);
+    EXPECT_THROW(GridFile::write(path.get(), grid, repeated), std::invalid_argument);
+    EXPECT_THROW(GridFile(path.get() + ".missing"), std::runtime_error);
+
+    GridFile::write(path.get(), grid);
+    const auto size = std::filesystem::file_size(path.get());
+    auto patch = [&](std::streamoff offset, const void* bytes, std::streamsize length) {
+        std::fstream stream(path.get(), std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(offset);
+        stream.write(static_cast<const char*>(bytes), length);
+    };
+
+    // Wrong magic, then a newer version
+    patch(0, "XDEGRID", 7);
+    EXPECT_THROW(GridFile{path.get()}, std::runtime_error);
+    patch(0, "PDEGRID", 7);
+    const uint32_t newer = GridFile::version + 1;
+    patch(offsetof(GridFileHeader, version), &newer, sizeof(newer));
+    EXPECT_THROW(GridFile{path.get()}, std::runtime_error);
+    patch(offsetof(GridFileHeader, version), &GridFile::version, sizeof(GridFile::version));
+    EXPECT_NO_THROW(GridFile{path.get()});
+
+    // Type counts that sum to the cell count but disagree with the cells
+    GridFileHeader header;
+    std::ifstream(path.get(), std::ios::binary).read(reinterpret_cast<char*>(&header), sizeof(header));
+    const uint64_t counts[] = {header.typeCounts[0] + 1, header.typeCounts[1] - 1};
+    patch(offsetof(GridFileHeader, typeCounts), counts, sizeof(counts));
+    EXPECT_THROW(GridFile{path.get()}, std::runtime_error);
+    patch(offsetof(GridFileHeader, typeCounts), header.typeCounts, sizeof(header.typeCounts));
+    EXPECT_NO_THROW(GridFile{path.get()});
+
+    // An interior offset past the last cell, then the offsets out of order
+    std::vector<GridFileSection> table(header.sectionCount);
+    std::ifstream stream(path.get(), std::ios::binary);
+    stream.seekg(static_cast<std::streamoff>(header.sectionTable));
+    stream.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(GridFileSection)));
+    const auto interior = std::find_if(table.begin(), table.end(), [](const GridFileSection& s) { return std::string(s.name) == "interior_cells"; });
+    ASSERT_NE(interior, table.end());
+    const std::streamoff last = static_cast<std::streamoff>(interior->offset + (interior->count - 1) * sizeof(size_t));
+    const size_t outside = grid.getCells().size();
+    patch(last, &outside, sizeof(outside));
+    EXPECT_THROW(GridFile{path.get()}, std::runtime_error);
+    const size_t first = grid.getInteriorCells().front();
+    patch(last, &first, sizeof(first));
+    EXPECT_THROW(GridFile{path.get()}, std::runtime_error);
+    patch(last, &grid.getInteriorCells().back(), sizeof(size_t));
+    EXPECT_NO_THROW(GridFile{path.get()});
+
+    // Truncated: the last section no longer fits
+    std::filesystem::resize_file(path.get(), size - 8);
+    EXPECT_THROW(GridFile{path.get()}, std::runtime_error);
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "HeatStepper.h"
+#include "ImplicitHeatStepper.h"
+#include "RedBlackSmoother.h"
+#include "test_common.h"
+
+namespace {
+    // Smooth initial state on interior cells with fixed boundary data
+    GridField initialField(const FDMGrid& grid) {
+        GridField u = RedBlackSmoother::sample(grid, [](const Point2D& p) { return std::sin(5.0 * p.x) + p.y * p.y; });
+        for (int j = 0; j < grid.getNy(); j++) {
+            for (int i = 0; i < grid.getNx(); i++) {
+                if (grid.getCellType(i, j) == BOUNDARY) u(i, j) = 0.25;
+                if (grid.getCellType(i, j) == EXTERIOR) u(i, j) = -1.0;
+            }
+        }
+        return u;
+    }
+}
+
+TEST(TestHeatStepper, RejectsUnstableTimeStep) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(40, 40, polygon);
+    const double limit = HeatStepper::maxStableTimeStep(grid, 2.0);
+    EXPECT_NO_THROW(HeatStepper(grid, 2.0, limit));
+    EXPECT_THROW(HeatStepper(grid, 2.0, 1.01 * limit), std::invalid_argument);
+    EXPECT_THROW(HeatStepper(grid, 0.0, limit), std::invalid_argument);
+    EXPECT_THROW(HeatStepper(grid, 1.0, limit, {0, 8, 4}), std::invalid_argument);
+}
+
+TEST(TestHeatStepper, TiledMatchesNaive) {
+    Polygon polygon = makeNotchedPolygon();
+    const std::vector<HeatTiling> tilings = {{512, 32, 8}, {16, 16, 4}, {7, 5, 3}, {1000, 1000, 13}, {33, 9, 1}};
+    for (unsigned threads : {1u, 3u}) {
+        FDMGrid grid(83, 71, polygon, threads);
+        const double dt = 0.9 * HeatStepper::maxStableTimeStep(grid, 1.0);
+
+        GridField expected = initialField(grid);
+        HeatStepper(grid, 1.0, dt, {}, SimdLevel::SCALAR).stepNaive(expected, 37);
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+            for (const HeatTiling& tiling : tilings) {
+                GridField actual = initialField(grid);
+                HeatStepper(grid, 1.0, dt, tiling, level).step(actual, 37);
+
+                std::span<const double> a = actual.getValues();
+                std::span<const double> e = expected.getValues();
+                for (size_t c = 0; c < a.size(); c++) {
+                    ASSERT_EQ(a[c], e[c]) << "tile " << tiling.tileX << "x" << tiling.tileY << "x" << tiling.timeSteps << ", cell " << c;
+                }
+            }
+        }
+    }
+}
+
+TEST(TestHeatStepper, OnlyInteriorCellsEvolve) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(50, 50, polygon);
+    const GridField initial = initialField(grid);
+    GridField u = initial;
+    HeatStepper(grid, 0.5, HeatStepper::maxStableTimeStep(grid, 0.5)).step(u, 20);
+
+    bool changed = false;
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (grid.getCellType(i, j) != INTERIOR) {
+                ASSERT_EQ(u(i, j), initial(i, j));
+            }
+            else {
+                changed |= u(i, j) != initial(i, j);
+            }
+        }
+    }
+    EXPECT_TRUE(changed);
+}
+
+TEST(TestHeatStepper, ApproachesSteadyState) {
+    // With fixed boundary data the solution relaxes to the harmonic state, here the constant 0.25
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(31, 31, polygon);
+    GridField u = initialField(grid);
+    HeatStepper(grid, 1.0, HeatStepper::maxStableTimeStep(grid, 1.0)).step(u, 4000);
+
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (grid.getCellType(i, j) == INTERIOR) {
+                EXPECT_NEAR(u(i, j), 0.25, 1e-6);
+            }
+        }
+    }
+}
+
+namespace {
+    // Smooth data at every node, so the boundary values match the initial interior state
+    GridField smoothField(const FDMGrid& grid) {
+        return RedBlackSmoother::sample(grid, [](const Point2D& p) { return std::sin(5.0 * p.x) + p.y * p.y; });
+    }
+
+    double maxDifference(const GridField& a, const GridField& b) {
+        double difference = 0.0;
+        for (size_t c = 0; c < a.getValues().size(); c++) {
+            difference = std::max(difference, std::abs(a.getValues()[c] - b.getValues()[c]));
+        }
+        return difference;
+    }
+
+    GridField integrate(const FDMGrid& grid, TimeScheme scheme, double endTime, int steps) {
+        GridField u = smoothField(grid);
+        ImplicitHeatStepper(grid, 1.0, endTime / steps, scheme, PreconditionerType::IC0, {1e-13, 1000}).step(u, steps);
+        return u;
+    }
+}
+
+TEST(TestImplicitHeatStepper, RejectsInvalidParameters) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(40, 40, polygon);
+    EXPECT_THROW(ImplicitHeatStepper(grid, 0.0, 1e-3), std::invalid_argument);
+    EXPECT_THROW(ImplicitHeatStepper(grid, 1.0, -1e-3), std::invalid_argument);
+    EXPECT_THROW(ImplicitHeatStepper(grid, 1.0, 1e-3, TimeScheme::BACKWARD_EULER, PreconditionerType::MULTIGRID), std::invalid_argument);
+}
+
+TEST(TestImplicitHeatStepper, MatchesExplicitStepper) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(41, 41, polygon);
+    const double limit = HeatStepper::maxStableTimeStep(grid, 1.0);
+    const int steps = 400;
+
+    GridField expected = smoothField(grid);
+    HeatStepper(grid, 1.0, 0.25 * limit).step(expected, steps);
+    GridField actual = smoothField(grid);
+    ImplicitHeatStepper(grid, 1.0, 0.25 * limit, TimeScheme::CRANK_NICOLSON).step(actual, steps);
+    // Forward Euler is first order, so the two agree to O(dt)
+    EXPECT_LT(maxDifference(actual, expected), 1e-3);
+}
+
+TEST(TestImplicitHeatStepper, ConvergenceOrderInTime) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(41, 41, polygon);
+    const double endTime = 0.02;
+
+    const GridField reference = integrate(grid, TimeScheme::CRANK_NICOLSON, endTime, 1280);
+    for (TimeScheme scheme : {TimeScheme::BACKWARD_EULER, TimeScheme::CRANK_NICOLSON}) {
+        const double coarse = maxDifference(integrate(grid, scheme, endTime, 20), reference);
+        const double fine = maxDifference(integrate(grid, scheme, endTime, 40), reference);
+        const double order = std::log2(coarse / fine);
+        EXPECT_NEAR(order, scheme == TimeScheme::BACKWARD_EULER ? 1.0 : 2.0, 0.3) << "scheme " << static_cast<int>(scheme);
+    }
+}
+
+TEST(TestImplicitHeatStepper, LargeStepsReachSteadyState) {
+    // Far beyond the explicit limit; backward Euler is L-stable and lands on the harmonic solution
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(61, 61, polygon);
+    auto boundary = [](const Point2D& p) { return std::sin(5.0 * p.x) + p.y * p.y; };
+
+    GridField u = smoothField(grid);
+    ImplicitHeatStepper stepper(grid, 1.0, 1e4 * HeatStepper::maxStableTimeStep(grid, 1.0), TimeScheme::BACKWARD_EULER);
+    stepper.step(u, 5);
+
+    const SolveResult steady = PoissonSolver(grid).solve([](const Point2D&) { return 0.0; }, boundary, {1e-12, 10000});
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (grid.getCellType(i, j) == INTERIOR) {
+                ASSERT_NEAR(u(i, j), steady.field(i, j), 1e-6);
+            }
+        }
+    }
+}
+
+TEST(TestImplicitHeatStepper, WarmStartsAndRecordsEveryStep) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(81, 81, polygon);
+    GridField u = initialField(grid);
+    ImplicitHeatStepper stepper(grid, 1.0, 20 * HeatStepper::maxStableTimeStep(grid, 1.0));
+    stepper.step(u, 30);
+    stepper.step(u, 10);
+
+    const std::vector<TimeStepStats>& history = stepper.getHistory();
+    ASSERT_EQ(history.size(), 40u);
+    // The solution changes less every step, so warm-started solves get cheaper
+    EXPECT_LT(history.back().iterations, history.front().iterations);
+    for (const TimeStepStats& stats : history) {
+        EXPECT_LE(stats.residualNorm, 1e-10);
+        EXPECT_GE(stats.milliseconds, 0.0);
+    }
+    EXPECT_GT(stepper.getSetupMilliseconds(), 0.0);
+
+    stepper.clearHistory();
+    EXPECT_TRUE(stepper.getHistory().empty());
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "DistributedPoissonSolver.h"
+#include "MpiCommunicator.h"
+#include "test_common.h"
+#include <algorithm>
+#include <cmath>
+
+// Run under mpiexec; every process runs every test and reports its own failures
+
+TEST(TestMpiCommunicator, ReducesAndExchangesAcrossProcesses) {
+    MpiCommunicator comm;
+    const int size = comm.getSize(), rank = comm.getRank();
+    EXPECT_EQ(comm.allreduceSum(rank + 1.0), size * (size + 1) / 2.0);
+
+    // Pass rank ids along an open chain: the last rank sends nothing and the first receives nothing
+    const int right = rank + 1 < size ? rank + 1 : -1, left = rank - 1;
+    const double sent[] = {static_cast<double>(rank), -1.0 * rank};
+    double received[] = {-7.0, -7.0};
+    comm.sendReceive(right, sent, left, received, 3);
+    EXPECT_EQ(received[0], left < 0 ? -7.0 : left);
+    EXPECT_EQ(received[1], left < 0 ? -7.0 : -1.0 * left);
+    comm.barrier();
+}
+
+TEST(TestMpiCommunicator, DistributedSolveMatchesPoissonSolver) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(67, 61, polygon, 1);
+    auto source = [](const Point2D& p) { return std::sin(3.0 * p.x) * std::cos(2.0 * p.y); };
+    auto boundary = [](const Point2D& p) { return static_cast<double>(p.x) - p.y; };
+
+    MpiCommunicator comm;
+    const DomainDecomposition decomposition(grid.getNx(), grid.getNy(), comm.getSize());
+    for (BoundaryStencil stencil : {BoundaryStencil::SNAPPED, BoundaryStencil::SHORTLEY_WELLER}) {
+        DistributedPoissonSolver solver(polygon, decomposition, comm, stencil, 1);
+        SolveResult actual = solver.solve(source, boundary, {1e-12, 10000});
+        EXPECT_TRUE(actual.converged);
+
+        GridField field = solver.gather(solver.getLocalSolution());
+        if (comm.getRank() != 0) {
+            EXPECT_EQ(field.getNx(), 0);
+            continue;
+        }
+        // The other ranks enter the next solve, so the root may not return early
+        SolveResult expected = PoissonSolver(grid, stencil).solve(source, boundary, {1e-12, 10000});
+        EXPECT_TRUE(expected.converged);
+        EXPECT_NEAR(actual.iterations, expected.iterations, 2);
+        EXPECT_EQ(solver.getGlobalUnknownCount(), PoissonOperator(grid).getUnknownCount());
+        std::span<const double> a = field.getValues();
+        std::span<const double> e = expected.field.getValues();
+        EXPECT_EQ(a.size(), e.size());
+        double maxError = 0.0;
+        for (size_t c = 0; c < std::min(a.size(), e.size()); c++) maxError = std::max(maxError, std::abs(a[c] - e[c]));
+        EXPECT_LT(maxError, 1e-9) << comm.getSize() << " processes";
+    }
+}
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    testing::InitGoogleTest(&argc, argv);
+    const int failed = RUN_ALL_TESTS();
+
+    // The run fails if any process failed
+    int anyFailed = 0;
+    MPI_Allreduce(&failed, &anyFailed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return anyFailed;
+}
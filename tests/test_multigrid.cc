@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "MultigridSolver.h"
+#include "test_common.h"
+
+namespace {
+    double quadratic(const Point2D& p) {
+        return static_cast<double>(p.x) * p.x + static_cast<double>(p.y) * p.y;
+    }
+
+    double minusFour(const Point2D&) {
+        return -4.0;
+    }
+}
+
+TEST(TestMultigrid, HierarchyHalvesTheGrid) {
+    Polygon polygon = makeNotchedPolygon();
+    MultigridSolver solver(129, 129, polygon);
+
+    ASSERT_GT(solver.getLevelCount(), 2);
+    for (int l = 1; l < solver.getLevelCount(); l++) {
+        const FDMGrid& fine = *solver.getLevel(l - 1).grid;
+        const FDMGrid& coarse = *solver.getLevel(l).grid;
+        EXPECT_EQ(coarse.getNx(), (fine.getNx() - 1) / 2 + 1);
+        EXPECT_EQ(coarse.getNy(), (fine.getNy() - 1) / 2 + 1);
+        EXPECT_LT(solver.getLevel(l).op->getUnknownCount(), solver.getLevel(l - 1).op->getUnknownCount());
+    }
+    EXPECT_LE(solver.getLevel(solver.getLevelCount() - 1).op->getUnknownCount(), solver.getOptions().coarsestUnknowns);
+}
+
+TEST(TestMultigrid, QuadraticSolutionIsExact) {
+    Polygon polygon = makeNotchedPolygon();
+    for (MultigridCycle cycle : {MultigridCycle::V, MultigridCycle::W, MultigridCycle::F}) {
+        MultigridOptions options;
+        options.cycle = cycle;
+        MultigridSolver solver(97, 97, polygon, options);
+        SolveResult result = solver.solve(minusFour, quadratic, {1e-11, 100});
+
+        EXPECT_TRUE(result.converged);
+        const FDMGrid& grid = solver.getGrid();
+        for (int j = 0; j < grid.getNy(); j++) {
+            for (int i = 0; i < grid.getNx(); i++) {
+                if (grid.getCellType(i, j) != EXTERIOR) {
+                    ASSERT_NEAR(result.field(i, j), quadratic(grid.indexToPoint(i, j)), 1e-6);
+                }
+            }
+        }
+    }
+}
+
+TEST(TestMultigrid, MatchesConjugateGradient) {
+    Polygon polygon = makeNotchedPolygon();
+    auto source = [](const Point2D& p) { return std::sin(3.0 * p.x) * std::cos(2.0 * p.y); };
+    auto boundary = [](const Point2D& p) { return static_cast<double>(p.x) - p.y; };
+
+    MultigridSolver multigrid(80, 72, polygon);
+    SolveResult expected = PoissonSolver(multigrid.getGrid()).solve(source, boundary, {1e-12, 10000});
+    SolveResult actual = multigrid.solve(source, boundary, {1e-12, 100});
+
+    ASSERT_TRUE(expected.converged);
+    ASSERT_TRUE(actual.converged);
+    std::span<const double> a = actual.field.getValues();
+    std::span<const double> e = expected.field.getValues();
+    for (size_t c = 0; c < a.size(); c++) {
+        ASSERT_NEAR(a[c], e[c], 1e-9);
+    }
+}
+
+TEST(TestMultigrid, ShortleyWellerMatchesConjugateGradient) {
+    Polygon polygon = makeNotchedPolygon();
+    auto source = [](const Point2D& p) { return std::sin(3.0 * p.x) * std::cos(2.0 * p.y); };
+    auto boundary = [](const Point2D& p) { return static_cast<double>(p.x) - p.y; };
+
+    MultigridOptions options;
+    options.stencil = BoundaryStencil::SHORTLEY_WELLER;
+    MultigridSolver multigrid(81, 73, polygon, options);
+    SolveResult expected = PoissonSolver(multigrid.getGrid(), BoundaryStencil::SHORTLEY_WELLER).solve(source, boundary, {1e-12, 10000});
+    SolveResult actual = multigrid.solve(source, boundary, {1e-12, 100});
+
+    ASSERT_TRUE(expected.converged);
+    ASSERT_TRUE(actual.converged);
+    EXPECT_LT(actual.iterations, 30);
+    std::span<const double> a = actual.field.getValues();
+    std::span<const double> e = expected.field.getValues();
+    for (size_t c = 0; c < a.size(); c++) {
+        ASSERT_NEAR(a[c], e[c], 1e-9);
+    }
+}
+
+TEST(TestMultigrid, CycleCountIndependentOfResolution) {
+    Polygon polygon = makeNotchedPolygon();
+    auto source = [](const Point2D& p) { return 1.0 + p.x * p.y; };
+    auto boundary = [](const Point2D&) { return 0.0; };
+
+    std::vector<int> cycles;
+    for (int n : {65, 129, 257, 513}) {
+        MultigridSolver solver(n, n, polygon);
+        SolveResult result = solver.solve(source, boundary, {1e-8, 100});
+        ASSERT_TRUE(result.converged) << "n = " << n;
+        cycles.push_back(result.iterations);
+    }
+    for (int count : cycles) {
+        EXPECT_LE(count, cycles.front() + 3);
+    }
+}
+
+TEST(TestMultigrid, StationaryCyclesConverge) {
+    Polygon polygon = makeNotchedPolygon();
+    for (MultigridCycle cycle : {MultigridCycle::V, MultigridCycle::W, MultigridCycle::F}) {
+        MultigridOptions options;
+        options.cycle = cycle;
+        options.krylovAcceleration = false;
+        MultigridSolver solver(129, 129, polygon, options);
+        SolveResult result = solver.solve(minusFour, quadratic, {1e-8, 40});
+        EXPECT_TRUE(result.converged);
+    }
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "PcgSolver.h"
+#include "test_common.h"
+#include <cmath>
+
+namespace {
+    double source(const Point2D& p) {
+        return 1.0 + p.x * p.y;
+    }
+
+    double boundary(const Point2D& p) {
+        return std::sin(3.0 * p.x) + p.y;
+    }
+
+    const PreconditionerType allTypes[] = {PreconditionerType::NONE, PreconditionerType::JACOBI,
+        PreconditionerType::IC0, PreconditionerType::MULTIGRID};
+}
+
+TEST(TestPcgSolver, EveryPreconditionerMatchesConjugateGradient) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(97, 97, polygon);
+    const SolveResult reference = PoissonSolver(grid).solve(source, boundary, {1e-11, 10000});
+    ASSERT_TRUE(reference.converged);
+
+    for (PreconditionerType type : allTypes) {
+        PcgSolver solver(97, 97, polygon, type);
+        PcgResult result = solver.solve(source, boundary, {1e-11, 10000});
+        ASSERT_TRUE(result.converged) << "preconditioner " << static_cast<int>(type);
+
+        std::span<const double> expected = reference.field.getValues();
+        std::span<const double> actual = result.field.getValues();
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t c = 0; c < actual.size(); c++) {
+            ASSERT_NEAR(actual[c], expected[c], 1e-8) << "preconditioner " << static_cast<int>(type) << ", cell " << c;
+        }
+    }
+}
+
+TEST(TestPcgSolver, StrongerPreconditionersNeedFewerIterations) {
+    Polygon polygon = makeNotchedPolygon();
+    int iterations[4];
+    for (PreconditionerType type : allTypes) {
+        PcgSolver solver(257, 257, polygon, type);
+        iterations[static_cast<int>(type)] = solver.solve(source, boundary).iterations;
+    }
+    // The diagonal is constant, so Jacobi only rescales plain CG
+    EXPECT_NEAR(iterations[1], iterations[0], 2);
+    EXPECT_LT(iterations[2], iterations[0] / 2);
+    EXPECT_LT(iterations[3], iterations[2] / 2);
+}
+
+TEST(TestPcgSolver, RecordsHistoryAndTimings) {
+    Polygon polygon = makeNotchedPolygon();
+    PcgSolver solver(129, 129, polygon, PreconditionerType::IC0);
+    PcgResult result = solver.solve(source, boundary);
+
+    ASSERT_TRUE(result.converged);
+    ASSERT_EQ(result.history.size(), static_cast<size_t>(result.iterations) + 1);
+    EXPECT_DOUBLE_EQ(result.history.front().residualNorm, 1.0);
+    EXPECT_EQ(result.history.back().residualNorm, result.residualNorm);
+    for (size_t k = 1; k < result.history.size(); k++) {
+        EXPECT_GE(result.history[k].milliseconds, result.history[k - 1].milliseconds);
+    }
+    EXPECT_GE(result.solveMilliseconds, result.history.back().milliseconds);
+    EXPECT_GT(result.setupMilliseconds, 0.0);
+}
+
+TEST(TestPcgSolver, WarmStartFromSolutionNeedsNoIterations) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(65, 65, polygon);
+    PcgSolver solver(grid, PreconditionerType::JACOBI);
+    const AlignedVector<double> b = solver.getOperator().assembleRhs(source, boundary);
+
+    AlignedVector<double> x(b.size(), 0.0);
+    const PcgResult cold = solver.solve(b, x, {1e-10, 1000});
+    ASSERT_TRUE(cold.converged);
+    EXPECT_GT(cold.iterations, 0);
+    EXPECT_TRUE(cold.field.getValues().empty());
+
+    const PcgResult warm = solver.solve(b, x, {1e-9, 1000});
+    EXPECT_TRUE(warm.converged);
+    EXPECT_EQ(warm.iterations, 0);
+}
+
+TEST(TestPcgSolver, FlexibleUpdateHandlesFCycles) {
+    Polygon polygon = makeNotchedPolygon();
+    MultigridOptions options;
+    options.cycle = MultigridCycle::F;
+    PcgSolver solver(257, 257, polygon, PreconditionerType::MULTIGRID, options);
+    PcgResult result = solver.solve(source, boundary);
+    EXPECT_TRUE(result.converged);
+    EXPECT_LT(result.iterations, 20);
+}
+
+TEST(TestPcgSolver, RejectsMultigridWithoutPolygon) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(33, 33, polygon);
+    EXPECT_THROW(PcgSolver(grid, PreconditionerType::MULTIGRID), std::invalid_argument);
+}
+
+TEST(TestIncompleteCholesky, ExactForTridiagonalMatrix) {
+    // A tridiagonal matrix has no fill-in, so IC(0) is its exact Cholesky factor
+    const int32_t n = 50;
+    AlignedVector<int64_t> rowPtr{0};
+    AlignedVector<int32_t> columns;
+    AlignedVector<double> values;
+    for (int32_t i = 0; i < n; i++) {
+        for (int32_t j = std::max(0, i - 1); j <= std::min(n - 1, i + 1); j++) {
+            columns.push_back(j);
+            values.push_back(i == j ? 2.5 : -1.0);
+        }
+        rowPtr.push_back(static_cast<int64_t>(columns.size()));
+    }
+    CsrMatrix matrix(n, rowPtr, columns, values);
+    IncompleteCholesky ic(matrix);
+
+    AlignedVector<double> x(n), b(n), z(n);
+    for (int32_t i = 0; i < n; i++) x[i] = std::cos(0.3 * i);
+    matrix.multiply(x, b);
+    const double bz = ic.applyDot(b, z);
+
+    double expectedDot = 0.0;
+    for (int32_t i = 0; i < n; i++) {
+        ASSERT_NEAR(z[i], x[i], 1e-12);
+        expectedDot += b[i] * z[i];
+    }
+    EXPECT_NEAR(bz, expectedDot, 1e-12 * std::abs(expectedDot));
+}
+
+TEST(TestIncompleteCholesky, RejectsIndefiniteMatrix) {
+    CsrMatrix matrix(2, {0, 2, 4}, {0, 1, 0, 1}, {1.0, 2.0, 2.0, 1.0});
+    EXPECT_THROW(IncompleteCholesky{matrix}, std::invalid_argument);
+}
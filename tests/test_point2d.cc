@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "Point2D.h"
+#include <type_traits>
 
 TEST(TestPoint2D, PrintToStdOut) {
     Point2D p1 {1, 2};
@@ -42,6 +43,7 @@ TEST(TestPoint2D, ConstructFromPoint2D) {
     EXPECT_EQ(p2.x, 1);
     EXPECT_EQ(p2.y, 1);
     EXPECT_NE(&p1, &p2);
+    EXPECT_TRUE(std::is_trivially_copyable_v<Point2D>);
 }
 
 TEST(TestPoint2D, ConstructFromPair) {
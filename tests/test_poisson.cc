@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "PoissonSolver.h"
+#include "test_common.h"
+#include <algorithm>
+#include <cmath>
+
+TEST(TestInteriorIndexMap, NumbersInteriorCellsRowMajor) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(41, 37, polygon);
+    InteriorIndexMap map(grid);
+
+    int32_t expected = 0;
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (grid.getCellType(i, j) == INTERIOR) {
+                ASSERT_EQ(map.unknownAt(i, j), expected);
+                ASSERT_EQ(map.indexOf(expected), std::make_pair(i, j));
+                expected++;
+            }
+            else {
+                ASSERT_EQ(map.unknownAt(i, j), -1);
+            }
+        }
+    }
+    EXPECT_EQ(map.getUnknownCount(), expected);
+    EXPECT_EQ(map.unknownAt(-1, 0), -1);
+    EXPECT_EQ(map.unknownAt(0, grid.getNy()), -1);
+}
+
+TEST(TestPoissonSolver, QuadraticSolutionIsExact) {
+    // The 5-point stencil is exact for quadratics: u = x^2 + y^2 gives -∇²u = -4
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(61, 61, polygon);
+    PoissonSolver solver(grid);
+
+    auto exact = [](const Point2D& p) { return static_cast<double>(p.x) * p.x + static_cast<double>(p.y) * p.y; };
+    SolveResult result = solver.solve([](const Point2D&) { return -4.0; }, exact, {1e-12, 5000});
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_GT(result.iterations, 0);
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            const GridType type = grid.getCellType(i, j);
+            if (type == EXTERIOR) {
+                EXPECT_EQ(result.field(i, j), 0.0);
+            }
+            else {
+                EXPECT_NEAR(result.field(i, j), exact(grid.indexToPoint(i, j)), 1e-6) << "cell (" << i << ", " << j << ")";
+            }
+        }
+    }
+}
+
+TEST(TestPoissonSolver, OperatorIsSymmetric) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(31, 29, polygon);
+    PoissonOperator op(grid);
+
+    const int32_t n = op.getUnknownCount();
+    std::vector<double> x(n), y(n), ax(n), ay(n);
+    for (int32_t k = 0; k < n; k++) {
+        x[k] = std::sin(0.3 * k);
+        y[k] = std::cos(0.7 * k);
+    }
+    op.apply(x, ax);
+    op.apply(y, ay);
+
+    double xAy = 0.0, yAx = 0.0, xAx = 0.0;
+    for (int32_t k = 0; k < n; k++) {
+        xAy += x[k] * ay[k];
+        yAx += y[k] * ax[k];
+        xAx += x[k] * ax[k];
+    }
+    EXPECT_NEAR(xAy, yAx, 1e-9 * std::abs(xAy));
+    EXPECT_GT(xAx, 0.0);
+}
+
+namespace {
+    // Line through a and b scaled to unit normal, positive to its left
+    struct Edge {
+        double a, b, c;
+        Edge(const Point2D& p, const Point2D& q) {
+            const double ex = q.x - p.x, ey = q.y - p.y, length = std::hypot(ex, ey);
+            a = -ey / length;
+            b = ex / length;
+            c = -(a * p.x + b * p.y);
+        }
+        double operator()(const Point2D& p) const { return a * p.x + b * p.y + c; }
+    };
+
+    /**
+     * @brief Solves -∇²u = f on a triangle whose exact solution u = L1 L2 L3 vanishes on the
+     * true boundary, and returns the largest nodal error.
+     */
+    double triangleError(int n, BoundaryStencil stencil) {
+        const std::vector<Point2D> vertices = { {.1f, .15f}, {1.1f, .3f}, {.35f, 1.05f} };
+        const Edge l1(vertices[0], vertices[1]), l2(vertices[1], vertices[2]), l3(vertices[2], vertices[0]);
+        Polygon polygon(vertices);
+        FDMGrid grid(n, n, polygon);
+        PoissonSolver solver(grid, stencil);
+
+        auto exact = [&](const Point2D& p) { return l1(p) * l2(p) * l3(p); };
+        const double g12 = l1.a * l2.a + l1.b * l2.b, g13 = l1.a * l3.a + l1.b * l3.b, g23 = l2.a * l3.a + l2.b * l3.b;
+        auto source = [&](const Point2D& p) { return -2.0 * (g12 * l3(p) + g13 * l2(p) + g23 * l1(p)); };
+        SolveResult result = solver.solve(source, [](const Point2D&) { return 0.0; }, {1e-13, 20000});
+        EXPECT_TRUE(result.converged);
+
+        double error = 0.0;
+        for (int j = 0; j < grid.getNy(); j++) {
+            for (int i = 0; i < grid.getNx(); i++) {
+                if (grid.getCellType(i, j) == INTERIOR) {
+                    error = std::max(error, std::abs(result.field(i, j) - exact(grid.indexToPoint(i, j))));
+                }
+            }
+        }
+        return error;
+    }
+}
+
+TEST(TestPoissonSolver, ShortleyWellerConvergesAtSecondOrder) {
+    double snapped[3], shortleyWeller[3];
+    for (int r = 0; r < 3; r++) {
+        const int n = 40 * (1 << r) + 1;
+        snapped[r] = triangleError(n, BoundaryStencil::SNAPPED);
+        shortleyWeller[r] = triangleError(n, BoundaryStencil::SHORTLEY_WELLER);
+    }
+    for (int r = 1; r < 3; r++) {
+        EXPECT_GT(shortleyWeller[r - 1] / shortleyWeller[r], 3.0);
+        EXPECT_LT(shortleyWeller[r], snapped[r]);
+    }
+}
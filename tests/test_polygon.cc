@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include "Polygon.h"
+#include <cmath>
+#include <random>
+
+namespace {
+    bool isValid(const std::vector<Point2D>& vertices, ValidationMethod method) {
+        try {
+            Polygon polygon(vertices, method);
+            return true;
+        }
+        catch (const std::invalid_argument&) {
+            return false;
+        }
+    }
+}
+
+TEST(TestPolygon, RequiresThreeVertices) {
+    EXPECT_THROW(Polygon({ {0.f, 0.f}, {1.f, 0.f} }), std::invalid_argument);
+}
+
+TEST(TestPolygon, BoundingBox) {
+    Polygon polygon({ {.3f,0.f}, {.5f,.5f}, {1.0f, .3f}, {1.2f , 1.0f} ,{1.0f,1.2f}, {.7f,.8f}, {0.6f,.6f}, {0.0f,.8f} });
+
+    EXPECT_FLOAT_EQ(polygon.getMinX(), 0.f);
+    EXPECT_FLOAT_EQ(polygon.getMinY(), 0.f);
+    EXPECT_FLOAT_EQ(polygon.getMaxX(), 1.2f);
+    EXPECT_FLOAT_EQ(polygon.getMaxY(), 1.2f);
+}
+
+TEST(TestPolygon, SelfIntersectionDetected) {
+    for (ValidationMethod method : {ValidationMethod::SWEEP_LINE, ValidationMethod::BRUTE_FORCE}) {
+        // Bow tie: two edges cross properly
+        EXPECT_FALSE(isValid({ {0.f, 0.f}, {2.f, 2.f}, {2.f, 0.f}, {0.f, 2.f} }, method));
+        // A vertex touching a non-adjacent edge
+        EXPECT_FALSE(isValid({ {0.f, 0.f}, {4.f, 0.f}, {4.f, 4.f}, {2.f, 0.f}, {0.f, 4.f} }, method));
+        // Two vertices at the same location
+        EXPECT_FALSE(isValid({ {0.f, 0.f}, {2.f, 1.f}, {4.f, 0.f}, {4.f, 2.f}, {2.f, 1.f}, {0.f, 2.f} }, method));
+        // Collinear overlapping edges
+        EXPECT_FALSE(isValid({ {0.f, 0.f}, {3.f, 0.f}, {3.f, 1.f}, {1.f, 1.f}, {1.f, 0.f}, {2.f, 0.f}, {2.f, -1.f}, {0.f, -1.f} }, method));
+    }
+}
+
+TEST(TestPolygon, SimplePolygonsAccepted) {
+    for (ValidationMethod method : {ValidationMethod::SWEEP_LINE, ValidationMethod::BRUTE_FORCE}) {
+        EXPECT_TRUE(isValid({ {0.f, 0.f}, {1.f, 0.f}, {1.f, 1.f}, {0.f, 1.f} }, method));
+        EXPECT_TRUE(isValid({ {.3f,0.f}, {.5f,.5f}, {1.0f, .3f}, {1.2f , 1.0f} ,{1.0f,1.2f}, {.7f,.8f}, {0.6f,.6f}, {0.0f,.8f} }, method));
+        // Vertical edges and a comb of vertically aligned vertices
+        EXPECT_TRUE(isValid({ {0.f, 0.f}, {5.f, 0.f}, {5.f, 3.f}, {4.f, 3.f}, {4.f, 1.f}, {3.f, 1.f}, {3.f, 3.f},
+                              {2.f, 3.f}, {2.f, 1.f}, {1.f, 1.f}, {1.f, 3.f}, {0.f, 3.f} }, method));
+    }
+}
+
+TEST(TestPolygon, SweepLineMatchesBruteForce) {
+    // Random polygons on a small integer lattice produce many collinear and touching configurations
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> coordinate(0, 4);
+    std::uniform_int_distribution<int> count(3, 9);
+
+    int valid = 0;
+    for (int trial = 0; trial < 20000; trial++) {
+        std::vector<Point2D> vertices(count(rng));
+        for (Point2D& v : vertices) {
+            v = Point2D(static_cast<float>(coordinate(rng)), static_cast<float>(coordinate(rng)));
+        }
+        const bool expected = isValid(vertices, ValidationMethod::BRUTE_FORCE);
+        ASSERT_EQ(isValid(vertices, ValidationMethod::SWEEP_LINE), expected) << "trial " << trial;
+        valid += expected;
+    }
+    EXPECT_GT(valid, 0);
+}
+
+TEST(TestPolygon, MoveVerticesMatchesFullValidation) {
+    std::mt19937 rng(777);
+    std::uniform_int_distribution<int> coordinate(0, 4);
+    std::uniform_int_distribution<int> count(3, 9);
+
+    int accepted = 0, rejected = 0;
+    for (int trial = 0; trial < 5000; trial++) {
+        std::vector<Point2D> vertices(count(rng));
+        for (Point2D& v : vertices) {
+            v = Point2D(static_cast<float>(coordinate(rng)), static_cast<float>(coordinate(rng)));
+        }
+        if (!isValid(vertices, ValidationMethod::BRUTE_FORCE)) continue;
+        Polygon polygon(vertices);
+
+        // Move one or two distinct vertices to random lattice points
+        std::uniform_int_distribution<size_t> pick(0, vertices.size() - 1);
+        std::vector<VertexMove> moves{{pick(rng), Point2D(static_cast<float>(coordinate(rng)), static_cast<float>(coordinate(rng)))}};
+        const size_t second = pick(rng);
+        if (second != moves[0].index && trial % 2 == 0) {
+            moves.push_back({second, Point2D(static_cast<float>(coordinate(rng)), static_cast<float>(coordinate(rng)))});
+        }
+        std::vector<Point2D> moved = vertices;
+        for (const VertexMove& move : moves) moved[move.index] = move.position;
+
+        if (!isValid(moved, ValidationMethod::BRUTE_FORCE)) {
+            ASSERT_THROW(polygon.moveVertices(moves), std::invalid_argument) << "trial " << trial;
+            ASSERT_EQ(polygon.getVertices(), vertices);
+            rejected++;
+            continue;
+        }
+        ASSERT_NO_THROW(polygon.moveVertices(moves)) << "trial " << trial;
+        const Polygon fresh(moved);
+        ASSERT_EQ(polygon.getVertices(), moved);
+        ASSERT_EQ(polygon.getMinX(), fresh.getMinX());
+        ASSERT_EQ(polygon.getMaxY(), fresh.getMaxY());
+        ASSERT_EQ(polygon.getEdges().slope, fresh.getEdges().slope);
+        ASSERT_EQ(polygon.getEdges().yPrev, fresh.getEdges().yPrev);
+        for (float y = -0.25f; y < 5.f; y += 0.5f) {
+            for (float x = -0.25f; x < 5.f; x += 0.5f) {
+                ASSERT_EQ(polygon.containsPoint({x, y}), fresh.containsPoint({x, y})) << "trial " << trial;
+            }
+        }
+        accepted++;
+    }
+    EXPECT_GT(accepted, 0);
+    EXPECT_GT(rejected, 0);
+}
+
+TEST(TestPolygon, MoveVerticesRejectsBadIndices) {
+    Polygon polygon({ {0.f, 0.f}, {1.f, 0.f}, {1.f, 1.f}, {0.f, 1.f} });
+    const std::vector<VertexMove> outOfRange{{4, {0.5f, 0.5f}}};
+    const std::vector<VertexMove> repeated{{1, {1.1f, 0.f}}, {1, {1.2f, 0.f}}};
+    EXPECT_THROW(polygon.moveVertices(outOfRange), std::invalid_argument);
+    EXPECT_THROW(polygon.moveVertices(repeated), std::invalid_argument);
+    EXPECT_EQ(polygon.getVertices()[1], Point2D(1.f, 0.f));
+}
+
+TEST(TestPolygon, LargeStarPolygonAccepted) {
+    const int n = 20000;
+    std::vector<Point2D> vertices;
+    vertices.reserve(n);
+    for (int k = 0; k < n; k++) {
+        const double angle = 2.0 * 3.14159265358979323846 * k / n;
+        const double radius = (k % 2 == 0) ? 1.0 : 0.9;
+        vertices.emplace_back(static_cast<float>(radius * std::cos(angle)), static_cast<float>(radius * std::sin(angle)));
+    }
+    EXPECT_NO_THROW(Polygon{vertices});
+}
+
+TEST(TestPolygon, ContainsPoint) {
+    Polygon square({ {0.f, 0.f}, {2.f, 0.f}, {2.f, 2.f}, {0.f, 2.f} });
+
+    EXPECT_TRUE(square.containsPoint({1.f, 1.f}));
+    EXPECT_TRUE(square.containsPoint({0.5f, 1.5f}));
+    EXPECT_FALSE(square.containsPoint({3.f, 1.f}));
+    EXPECT_FALSE(square.containsPoint({-1.f, 1.f}));
+    EXPECT_FALSE(square.containsPoint({1.f, 2.5f}));
+}
+
+TEST(TestPolygon, BatchContainsMatchesScalar) {
+    Polygon polygon({ {.3f,0.f}, {.5f,.5f}, {1.0f, .3f}, {1.2f , 1.0f} ,{1.0f,1.2f}, {.7f,.8f}, {0.6f,.6f}, {0.0f,.8f} });
+
+    // An odd count exercises the scalar tails of the vector kernels
+    const size_t count = 10007;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> coordinate(-0.2f, 1.4f);
+    std::vector<float> xs(count), ys(count);
+    for (size_t p = 0; p < count; p++) {
+        xs[p] = coordinate(rng);
+        ys[p] = coordinate(rng);
+    }
+    // Include vertices and points on horizontal/vertical lines through them
+    for (size_t v = 0; v < polygon.getVertices().size(); v++) {
+        xs[v] = polygon.getVertices()[v].x;
+        ys[v] = polygon.getVertices()[v].y;
+        ys[v + 100] = polygon.getVertices()[v].y;
+    }
+
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        std::vector<uint8_t> inside(count, 2);
+        polygon.containsPoints(xs, ys, inside, level);
+        for (size_t p = 0; p < count; p++) {
+            ASSERT_EQ(inside[p] != 0, polygon.containsPoint({xs[p], ys[p]})) << "point " << p << " level " << static_cast<int>(level);
+            ASSERT_LE(inside[p], 1);
+        }
+    }
+}
+
+TEST(TestPolygon, BatchContainsRejectsMismatchedSpans) {
+    Polygon square({ {0.f, 0.f}, {2.f, 0.f}, {2.f, 2.f}, {0.f, 2.f} });
+    std::vector<float> xs(4), ys(3);
+    std::vector<uint8_t> inside(4);
+
+    EXPECT_THROW(square.containsPoints(xs, ys, inside), std::invalid_argument);
+}
+
+namespace {
+    // Comb: long vertical teeth make every horizontal ray cross many edges
+    std::vector<Point2D> combVertices(int teeth) {
+        std::vector<Point2D> vertices{ {0.f, 0.f}, {static_cast<float>(2 * teeth), 0.f} };
+        for (int t = teeth - 1; t >= 0; t--) {
+            vertices.emplace_back(static_cast<float>(2 * t + 2), 10.f);
+            vertices.emplace_back(static_cast<float>(2 * t + 1), 10.f);
+            vertices.emplace_back(static_cast<float>(2 * t + 1), 1.f);
+            vertices.emplace_back(static_cast<float>(2 * t), 1.f);
+        }
+        vertices.pop_back();
+        return vertices;
+    }
+
+    std::vector<Point2D> jitteredStarVertices(int n) {
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<double> noise(-0.2, 0.2);
+        std::vector<Point2D> vertices;
+        for (int k = 0; k < n; k++) {
+            const double angle = 2.0 * 3.14159265358979323846 * k / n;
+            const double radius = ((k % 2 == 0) ? 1.0 : 0.5) + noise(rng);
+            vertices.emplace_back(static_cast<float>(radius * std::cos(angle)), static_cast<float>(radius * std::sin(angle)));
+        }
+        return vertices;
+    }
+}
+
+TEST(TestPolygon, IndexedQueriesMatchLinearScan) {
+    for (const std::vector<Point2D>& vertices : {jitteredStarVertices(3000), combVertices(200)}) {
+        Polygon indexed(vertices);
+        Polygon linear(vertices);
+        indexed.setIndexMinEdges(0);
+        linear.setIndexMinEdges(SIZE_MAX);
+        ASSERT_TRUE(indexed.usesIndex());
+        ASSERT_FALSE(linear.usesIndex());
+
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> x(indexed.getMinX() - 0.1f, indexed.getMaxX() + 0.1f);
+        std::uniform_real_distribution<float> y(indexed.getMinY() - 0.1f, indexed.getMaxY() + 0.1f);
+        for (int q = 0; q < 20000; q++) {
+            const Point2D p(x(rng), y(rng));
+            ASSERT_EQ(indexed.containsPoint(p), linear.containsPoint(p)) << p;
+        }
+
+        // Points on and near every edge, for a tight and a loose tolerance
+        std::uniform_real_distribution<float> t(0.f, 1.f);
+        std::uniform_real_distribution<float> offset(-2e-3f, 2e-3f);
+        for (size_t i = 0; i < vertices.size(); i++) {
+            const Point2D& a = vertices[i];
+            const Point2D& b = vertices[(i + 1) % vertices.size()];
+            const float s = t(rng);
+            const Point2D onEdge = a + (b - a) * s;
+            const Point2D nearEdge = onEdge + Point2D(offset(rng), offset(rng));
+            for (float eps : {1e-6f, 1e-3f, 0.5f}) {
+                ASSERT_EQ(indexed.isOnBoundary(onEdge, eps), linear.isOnBoundary(onEdge, eps)) << onEdge << " eps " << eps;
+                ASSERT_EQ(indexed.isOnBoundary(nearEdge, eps), linear.isOnBoundary(nearEdge, eps)) << nearEdge << " eps " << eps;
+            }
+        }
+    }
+}
+
+TEST(TestPolygon, IndexIsBuiltLazilyAndReportsCost) {
+    Polygon polygon(jitteredStarVertices(1000));
+    ASSERT_TRUE(polygon.usesIndex());
+
+    Polygon copyBeforeBuild(polygon);
+    EXPECT_TRUE(polygon.containsPoint({0.f, 0.f}));
+
+    const PolygonIndexStats& stats = polygon.getIndex().getStats();
+    EXPECT_GT(stats.slabCount, 1);
+    EXPECT_GE(stats.slabEntries, 1000u);
+    EXPECT_GT(stats.gridCols * stats.gridRows, 1);
+    EXPECT_GT(stats.memoryBytes, 0u);
+    EXPECT_GE(stats.buildMilliseconds, 0.0);
+
+    // Copies made after the build share it, earlier copies build their own
+    Polygon copyAfterBuild(polygon);
+    EXPECT_EQ(&copyAfterBuild.getIndex(), &polygon.getIndex());
+    EXPECT_NE(&copyBeforeBuild.getIndex(), &polygon.getIndex());
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "PolygonFile.h"
+#include "test_common.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    const std::vector<Point2D> notched = makeNotchedPolygon().getVertices();
+
+    std::span<const std::byte> bytesOf(std::string_view text) {
+        return std::as_bytes(std::span<const char>(text.data(), text.size()));
+    }
+}
+
+TEST(TestPolygonFile, ParsesCsvAndWkt) {
+    const std::string csv =
+        "x,y\r\n"
+        "# notched outline\n"
+        ".3,0\n0.5; 0.5\n 1.0 0.3\t\n+1.2,1\n1,1.2\n\n0.7,0.8\n0.6,.6\n0,0.8\n0.3,0\n";
+    EXPECT_EQ(PolygonFile::parse(bytesOf(csv), PolygonFormat::CSV), notched);
+
+    const std::string wkt = "  polygon ((0.3 0, .5 .5, 1 0.3, 1.2 1,\n 1 1.2, 0.7 0.8, 0.6 0.6, 0 0.8, 0.3 0))\n";
+    EXPECT_EQ(PolygonFile::parse(bytesOf(wkt), PolygonFormat::WKT), notched);
+
+    EXPECT_THROW(PolygonFile::parse(bytesOf("x,y\n1,2\n3,abc\n"), PolygonFormat::CSV), std::runtime_error);
+    EXPECT_THROW(PolygonFile::parse(bytesOf("1,2\n3,4,5\n"), PolygonFormat::CSV), std::runtime_error);
+    // A first line with a number in it is a broken vertex, not a header, and is reported
+    for (const char* broken : {"0.3,abc\n0.5,0.5\n1,0.3\n", "0.3 0.1 7\n0.5,0.5\n1,0.3\n", "x;1\n0.5,0.5\n1,0.3\n"}) {
+        try {
+            PolygonFile::parse(bytesOf(broken), PolygonFormat::CSV);
+            ADD_FAILURE() << broken << " parsed";
+        } catch (const std::runtime_error& error) {
+            EXPECT_EQ(std::string(error.what()).rfind("Line 1 ", 0), 0u) << error.what();
+        }
+    }
+    EXPECT_EQ(PolygonFile::parse(bytesOf("x [m]; y [m]\n0.5,0.5\n1,0.3\n0,1\n"), PolygonFormat::CSV).size(), 3u);
+    EXPECT_THROW(PolygonFile::parse(bytesOf("LINESTRING (0 0, 1 1)"), PolygonFormat::WKT), std::runtime_error);
+    EXPECT_THROW(PolygonFile::parse(bytesOf("POLYGON ((0 0, 4 0, 0 4, 0 0), (1 1, 2 1, 1 2, 1 1))"), PolygonFormat::WKT), std::runtime_error);
+    EXPECT_THROW(PolygonFile::parse(bytesOf("POLYGON ((0 0, 4 0, 0 4)"), PolygonFormat::WKT), std::runtime_error);
+    EXPECT_THROW(PolygonFile::parse(bytesOf("1234567"), PolygonFormat::BINARY), std::runtime_error);
+}
+
+TEST(TestPolygonFile, ReadsFilesIntoPolygons) {
+    const TemporaryPath binary("pde_solver_outline.bin");
+    PolygonFile::writeBinary(binary.get(), notched);
+    EXPECT_EQ(std::filesystem::file_size(binary.get()), notched.size() * sizeof(Point2D));
+    EXPECT_EQ(PolygonFile::formatOf(binary.get()), PolygonFormat::BINARY);
+    const Polygon fromBinary = PolygonFile::read(binary.get(), PolygonFile::formatOf(binary.get()));
+    EXPECT_EQ(fromBinary.getVertices(), notched);
+    EXPECT_EQ(fromBinary.getMaxX(), 1.2f);
+
+    const TemporaryPath wkt("pde_solver_outline.WKT");
+    std::ofstream(wkt.get()) << "POLYGON ((0 0, 1 0, 1 1, 0 1, 0 0))";
+    EXPECT_EQ(PolygonFile::formatOf(wkt.get()), PolygonFormat::WKT);
+    EXPECT_EQ(PolygonFile::read(wkt.get(), PolygonFormat::WKT).getVertices().size(), 4u);
+
+    // Self-intersecting outlines are rejected by the Polygon, unreadable files by the loader
+    const TemporaryPath bowtie("pde_solver_bowtie.csv");
+    std::ofstream(bowtie.get()) << "0,0\n1,1\n1,0\n0,1\n";
+    EXPECT_THROW(PolygonFile::read(bowtie.get(), PolygonFormat::CSV), std::invalid_argument);
+    EXPECT_THROW(PolygonFile::read(bowtie.get() + ".missing", PolygonFormat::CSV), std::runtime_error);
+    EXPECT_THROW(PolygonFile::formatOf("outline.txt"), std::invalid_argument);
+
+    // A moved vertex array is adopted, not copied
+    std::vector<Point2D> vertices = notched;
+    const Point2D* storage = vertices.data();
+    const Polygon moved(std::move(vertices));
+    EXPECT_EQ(moved.getVertices().data(), storage);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "QuadtreeGrid.h"
+#include "test_common.h"
+
+namespace {
+    // Options with the given depths, set by name so the other fields keep their defaults
+    QuadtreeOptions depthOptions(int maxDepth, int minDepth, bool balance = true) {
+        QuadtreeOptions options;
+        options.maxDepth = maxDepth;
+        options.minDepth = minDepth;
+        options.balance = balance;
+        return options;
+    }
+
+    // A long sliver: thin features are where uniform grids waste the most cells
+    Polygon makeSliver() {
+        return Polygon({ {0.f, 0.f}, {1.f, .02f}, {1.f, .05f}, {0.f, .03f} });
+    }
+}
+
+TEST(TestQuadtreeGrid, MortonCodesRoundTrip) {
+    EXPECT_EQ(QuadtreeGrid::encodeMorton(0, 0), 0u);
+    EXPECT_EQ(QuadtreeGrid::encodeMorton(1, 0), 1u);
+    EXPECT_EQ(QuadtreeGrid::encodeMorton(0, 1), 2u);
+    EXPECT_EQ(QuadtreeGrid::encodeMorton(3, 3), 15u);
+    for (uint32_t v : {0u, 1u, 12345u, 0x7FFFFFFFu, 0xFFFFFFFFu}) {
+        const auto [ix, iy] = QuadtreeGrid::decodeMorton(QuadtreeGrid::encodeMorton(v, ~v));
+        EXPECT_EQ(ix, v);
+        EXPECT_EQ(iy, ~v);
+    }
+}
+
+TEST(TestQuadtreeGrid, LeavesTileTheSquareInMortonOrder) {
+    Polygon polygon = makeNotchedPolygon();
+    QuadtreeGrid tree(polygon, depthOptions(8, 2));
+
+    uint64_t next = 0;
+    for (const QuadtreeLeaf& leaf : tree.getLeaves()) {
+        const uint64_t cells = uint64_t{1} << (2 * (tree.getMaxDepth() - leaf.depth));
+        ASSERT_EQ(leaf.code, next);
+        ASSERT_EQ(leaf.code % cells, 0u);
+        ASSERT_GE(leaf.depth, 2);
+        next += cells;
+    }
+    EXPECT_EQ(next, tree.getFinestCellCount());
+}
+
+TEST(TestQuadtreeGrid, ClassifiesLeavesAgainstThePolygon) {
+    Polygon polygon = makeNotchedPolygon();
+    QuadtreeGrid tree(polygon, depthOptions(9, 2));
+
+    for (size_t k = 0; k < tree.getLeafCount(); k++) {
+        const QuadtreeLeaf& leaf = tree.getLeaves()[k];
+        const Point2D center = tree.leafCenter(k);
+        if (leaf.type == BOUNDARY) {
+            ASSERT_EQ(leaf.depth, tree.getMaxDepth());
+            ASSERT_TRUE(polygon.isOnBoundary(center, tree.leafSize(k)));
+            continue;
+        }
+        ASSERT_EQ(leaf.type == INTERIOR, polygon.containsPoint(center)) << "leaf " << k;
+        // A leaf away from the boundary lies entirely on one side of it
+        const float h = 0.49f * tree.leafSize(k);
+        for (const Point2D corner : {Point2D(center.x - h, center.y - h), Point2D(center.x + h, center.y + h)}) {
+            ASSERT_EQ(leaf.type == INTERIOR, polygon.containsPoint(corner)) << "leaf " << k;
+        }
+    }
+    EXPECT_GT(tree.countLeaves(BOUNDARY), 0u);
+    EXPECT_GT(tree.countLeaves(INTERIOR), 0u);
+    EXPECT_EQ(tree.countLeaves(BOUNDARY) + tree.countLeaves(INTERIOR) + tree.countLeaves(EXTERIOR), tree.getLeafCount());
+}
+
+TEST(TestQuadtreeGrid, NeighboursDifferByAtMostOneLevel) {
+    Polygon polygon = makeNotchedPolygon();
+    QuadtreeGrid tree(polygon, depthOptions(9, 1));
+
+    for (size_t k = 0; k < tree.getLeafCount(); k++) {
+        for (QuadDirection direction : {QuadDirection::WEST, QuadDirection::EAST, QuadDirection::SOUTH, QuadDirection::NORTH}) {
+            const int64_t n = tree.findNeighbour(k, direction);
+            if (n < 0) continue;
+            ASSERT_LE(std::abs(tree.getLeaves()[n].depth - tree.getLeaves()[k].depth), 1);
+        }
+    }
+}
+
+TEST(TestQuadtreeGrid, FindsNeighboursAndLeaves) {
+    Polygon polygon = makeNotchedPolygon();
+    QuadtreeGrid tree(polygon, depthOptions(7, 2, false));
+
+    for (size_t k = 0; k < tree.getLeafCount(); k++) {
+        const Point2D center = tree.leafCenter(k);
+        ASSERT_EQ(tree.findLeaf(center), static_cast<int64_t>(k));
+
+        // Stepping across an edge lands in the leaf containing the point just beyond it
+        const float step = 0.5f * tree.leafSize(k) + 1e-3f * tree.getSize() / (1 << tree.getMaxDepth());
+        const float lower = center.y - 0.5f * tree.leafSize(k) + 1e-4f * tree.getSize() / (1 << tree.getMaxDepth());
+        const int64_t west = tree.findNeighbour(k, QuadDirection::WEST);
+        ASSERT_EQ(west, tree.findLeaf(Point2D(center.x - step, lower)));
+        if (west >= 0 && tree.getLeaves()[west].depth == tree.getLeaves()[k].depth) {
+            ASSERT_EQ(tree.findNeighbour(west, QuadDirection::EAST), static_cast<int64_t>(k));
+        }
+    }
+    EXPECT_EQ(tree.findNeighbour(0, QuadDirection::WEST), -1);
+    EXPECT_EQ(tree.findNeighbour(0, QuadDirection::SOUTH), -1);
+    EXPECT_EQ(tree.findLeaf(Point2D(tree.getOriginX() - 1.0f, tree.getOriginY())), -1);
+}
+
+TEST(TestQuadtreeGrid, IndicatorRefinesAwayFromTheBoundary) {
+    Polygon polygon = makeNotchedPolygon();
+    const Point2D target(0.9f, 0.8f);
+    QuadtreeOptions options = depthOptions(8, 2);
+    options.indicator = [&](const Point2D& center, float size) {
+        return std::abs(center.x - target.x) < size && std::abs(center.y - target.y) < size;
+    };
+    QuadtreeGrid plain(polygon, depthOptions(8, 2));
+    QuadtreeGrid refined(polygon, options);
+
+    ASSERT_EQ(plain.getLeaves()[plain.findLeaf(target)].type, INTERIOR);
+    EXPECT_LT(plain.getLeaves()[plain.findLeaf(target)].depth, 8);
+    EXPECT_EQ(refined.getLeaves()[refined.findLeaf(target)].depth, 8);
+    EXPECT_EQ(refined.getLeaves()[refined.findLeaf(target)].type, INTERIOR);
+    EXPECT_GT(refined.getLeafCount(), plain.getLeafCount());
+}
+
+TEST(TestQuadtreeGrid, ThinFeaturesNeedFarFewerCells) {
+    Polygon polygon = makeSliver();
+    QuadtreeGrid tree(polygon, depthOptions(10, 2));
+
+    EXPECT_GT(tree.countLeaves(INTERIOR), 0u);
+    EXPECT_LT(tree.getLeafCount() * 10, tree.getFinestCellCount());
+}
+
+TEST(TestQuadtreeGrid, RejectsInvalidDepths) {
+    Polygon polygon = makeNotchedPolygon();
+    EXPECT_THROW(QuadtreeGrid(polygon, depthOptions(32, 2)), std::invalid_argument);
+    EXPECT_THROW(QuadtreeGrid(polygon, depthOptions(4, 5)), std::invalid_argument);
+    EXPECT_THROW(QuadtreeGrid(polygon, depthOptions(4, -1)), std::invalid_argument);
+}
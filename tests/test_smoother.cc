@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "RedBlackSmoother.h"
+#include "test_common.h"
+
+namespace {
+    double source(const Point2D& p) {
+        return std::sin(3.0 * p.x) * std::cos(2.0 * p.y);
+    }
+
+    double boundary(const Point2D& p) {
+        return static_cast<double>(p.x) - p.y;
+    }
+}
+
+TEST(TestRedBlackSmoother, RejectsInvalidRelaxationFactor) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(16, 16, polygon);
+    EXPECT_THROW(RedBlackSmoother(grid, 0.0), std::invalid_argument);
+    EXPECT_THROW(RedBlackSmoother(grid, 2.0), std::invalid_argument);
+    EXPECT_NO_THROW(RedBlackSmoother(grid, RedBlackSmoother::optimalOmega(grid)));
+}
+
+TEST(TestRedBlackSmoother, SimdKernelsMatchScalar) {
+    // Odd widths exercise the kernel tails
+    Polygon polygon = makeNotchedPolygon();
+    for (int nx : {37, 64, 101}) {
+        FDMGrid grid(nx, 53, polygon);
+        const GridField f = RedBlackSmoother::sample(grid, source);
+        const GridField initial = RedBlackSmoother::sample(grid, boundary, BOUNDARY);
+
+        GridField expected = initial;
+        RedBlackSmoother(grid, 1.5, SimdLevel::SCALAR).sweep(expected, f, 5);
+        for (SimdLevel level : {SimdLevel::AVX2, SimdLevel::AVX512}) {
+            GridField actual = initial;
+            RedBlackSmoother(grid, 1.5, level).sweep(actual, f, 5);
+            std::span<const double> a = actual.getValues();
+            std::span<const double> e = expected.getValues();
+            for (size_t c = 0; c < a.size(); c++) {
+                ASSERT_EQ(a[c], e[c]) << "nx = " << nx << ", level " << static_cast<int>(level) << ", cell " << c;
+            }
+        }
+    }
+}
+
+TEST(TestRedBlackSmoother, OnlyInteriorCellsChange) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(45, 45, polygon);
+    const GridField f = RedBlackSmoother::sample(grid, source);
+    GridField u = RedBlackSmoother::sample(grid, boundary, BOUNDARY);
+    const GridField before = u;
+
+    RedBlackSmoother(grid).sweep(u, f, 3);
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (grid.getCellType(i, j) != INTERIOR) {
+                ASSERT_EQ(u(i, j), before(i, j));
+            }
+        }
+    }
+}
+
+TEST(TestRedBlackSmoother, FusedSweepMatchesColorPasses) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(70, 300, polygon, 3);
+    RedBlackSmoother smoother(grid, 1.3);
+    const GridField f = RedBlackSmoother::sample(grid, source);
+
+    GridField fused = RedBlackSmoother::sample(grid, boundary, BOUNDARY);
+    GridField passes = fused;
+    smoother.sweep(fused, f, 3);
+    for (int s = 0; s < 3; s++) {
+        smoother.relaxColor(passes, f, 0);
+        smoother.relaxColor(passes, f, 1);
+    }
+
+    std::span<const double> a = fused.getValues();
+    std::span<const double> b = passes.getValues();
+    for (size_t c = 0; c < a.size(); c++) {
+        ASSERT_EQ(a[c], b[c]);
+    }
+}
+
+TEST(TestRedBlackSmoother, ParallelSweepsMatchSerial) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid serialGrid(300, 1000, polygon, 1);
+    FDMGrid parallelGrid(300, 1000, polygon, 4);
+    const GridField f = RedBlackSmoother::sample(serialGrid, source);
+
+    GridField serial = RedBlackSmoother::sample(serialGrid, boundary, BOUNDARY);
+    GridField parallel = serial;
+    RedBlackSmoother(serialGrid, 1.2).sweep(serial, f, 4);
+    RedBlackSmoother(parallelGrid, 1.2).sweep(parallel, f, 4);
+
+    std::span<const double> s = serial.getValues();
+    std::span<const double> p = parallel.getValues();
+    for (size_t c = 0; c < s.size(); c++) {
+        ASSERT_EQ(s[c], p[c]);
+    }
+}
+
+TEST(TestRedBlackSmoother, SolveMatchesAssembledSolver) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(81, 73, polygon);
+    SolveResult expected = PoissonSolver(grid).solve(source, boundary, {1e-12, 10000});
+
+    RedBlackSmoother smoother(grid, RedBlackSmoother::optimalOmega(grid));
+    SolveResult actual = smoother.solve(source, boundary, {1e-11, 20000});
+    ASSERT_TRUE(actual.converged);
+    EXPECT_EQ(actual.iterations % 10, 0);
+
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            if (grid.getCellType(i, j) != EXTERIOR) {
+                ASSERT_NEAR(actual.field(i, j), expected.field(i, j), 1e-8);
+            }
+        }
+    }
+}
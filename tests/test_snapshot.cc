@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "SnapshotWriter.h"
+#include "HeatStepper.h"
+#include "test_common.h"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    // Directory in the temporary directory, removed with its contents when the test ends
+    class TemporaryDirectory {
+    private:
+        std::filesystem::path path;
+
+    public:
+        explicit TemporaryDirectory(const std::string& name) : path(std::filesystem::temp_directory_path() / name) {
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directory(path);
+        }
+        ~TemporaryDirectory() { std::filesystem::remove_all(path); }
+        std::string get() const { return path.string(); }
+    };
+
+    std::string readFile(const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream text;
+        text << in.rdbuf();
+        return text.str();
+    }
+
+    // The float64 values of the raw appended block of a .vti file
+    std::vector<double> appendedValues(const std::string& file) {
+        const size_t start = file.find("<AppendedData encoding=\"raw\">");
+        const size_t marker = file.find('_', start);
+        uint64_t length = 0;
+        std::memcpy(&length, file.data() + marker + 1, sizeof(length));
+        std::vector<double> values(length / sizeof(double));
+        std::memcpy(values.data(), file.data() + marker + 1 + sizeof(length), length);
+        return values;
+    }
+}
+
+TEST(TestSnapshotWriter, WritesCroppedTimeSeries) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(61, 53, polygon);
+    // Pulling in the right-most vertex leaves EXTERIOR columns the writer crops away
+    const VertexMove move[] = {{3, {0.95f, 0.9f}}};
+    grid.moveVertices(polygon, move);
+    GridField u(grid.getNx(), grid.getNy(), -1.0);
+    for (size_t cell : grid.getInteriorCells()) u.getValues()[cell] = 1.0;
+    const HeatStepper stepper(grid, 1.0, 0.5 * HeatStepper::maxStableTimeStep(grid, 1.0));
+    const TemporaryDirectory directory("pde_solver_snapshots");
+
+    SnapshotWriter writer(grid, directory.get(), "temperature");
+    const CellBox box = writer.getBox();
+    std::vector<GridField> expected;
+    for (int s = 0; s < 4; s++) {
+        writer.submit(u, s * 5 * stepper.getTimeStep());
+        expected.push_back(u);
+        stepper.step(u, 5);
+    }
+    writer.close();
+    EXPECT_THROW(writer.submit(u, 1.0), std::logic_error);
+
+    // The box is the tightest one around the INTERIOR and BOUNDARY cells
+    size_t inside = 0;
+    for (int j = 0; j < grid.getNy(); j++) {
+        for (int i = 0; i < grid.getNx(); i++) {
+            const GridType type = grid.getCellType(i, j);
+            if (type != INTERIOR && type != BOUNDARY) continue;
+            EXPECT_TRUE(i >= box.iBegin && i < box.iEnd && j >= box.jBegin && j < box.jEnd);
+            inside++;
+        }
+    }
+    EXPECT_EQ(inside, grid.getCellCount(INTERIOR) + grid.getCellCount(BOUNDARY));
+    EXPECT_LT(static_cast<size_t>(box.iEnd - box.iBegin) * (box.jEnd - box.jBegin), grid.getCells().size());
+
+    const std::string series = readFile(writer.getSeriesPath());
+    for (int s = 0; s < 4; s++) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "temperature_%06d.vti", s);
+        EXPECT_NE(series.find(name), std::string::npos);
+
+        const std::string file = readFile(std::filesystem::path(directory.get()) / name);
+        std::ostringstream extent;
+        extent << "WholeExtent=\"" << box.iBegin << ' ' << box.iEnd - 1 << ' ' << box.jBegin << ' ' << box.jEnd - 1 << " 0 0\"";
+        EXPECT_NE(file.find(extent.str()), std::string::npos);
+
+        const std::vector<double> values = appendedValues(file);
+        ASSERT_EQ(values.size(), static_cast<size_t>(box.iEnd - box.iBegin) * (box.jEnd - box.jBegin));
+        size_t k = 0;
+        for (int j = box.jBegin; j < box.jEnd; j++) {
+            for (int i = box.iBegin; i < box.iEnd; i++, k++) {
+                const GridType type = grid.getCellType(i, j);
+                if (type == INTERIOR || type == BOUNDARY) {
+                    EXPECT_EQ(values[k], expected[s](i, j));
+                } else {
+                    EXPECT_TRUE(std::isnan(values[k]));
+                }
+            }
+        }
+    }
+
+    const SnapshotStats stats = writer.getStats();
+    EXPECT_EQ(stats.submitted, 4u);
+    EXPECT_EQ(stats.written, 4u);
+    EXPECT_LE(stats.maxPending, 2u);
+    EXPECT_GT(stats.bytesWritten, 4 * sizeof(double) * inside);
+    // One entry per snapshot; every entry after the first rewrote only the closing tags
+    const std::string tail = "  </Collection>\n</VTKFile>\n";
+    EXPECT_EQ(stats.seriesWrites, 4u);
+    EXPECT_EQ(stats.seriesBytesWritten, series.size() + 3 * tail.size());
+}
+
+TEST(TestSnapshotWriter, AppendsToTheSeriesInPlace) {
+    Polygon polygon = makeNotchedPolygon();
+    const FDMGrid grid(31, 29, polygon);
+    const TemporaryDirectory directory("pde_solver_snapshot_series");
+    const GridField u(grid.getNx(), grid.getNy(), 1.0);
+    const std::string tail = "  </Collection>\n</VTKFile>\n";
+
+    // After every flush the collection is complete and lists every snapshot so far
+    SnapshotWriter writer(grid, directory.get());
+    uint64_t previousBytes = 0;
+    for (int s = 0; s < 7; s++) {
+        writer.submit(u, s);
+        writer.flush();
+        const std::string series = readFile(writer.getSeriesPath());
+        ASSERT_GE(series.size(), tail.size());
+        EXPECT_EQ(series.substr(series.size() - tail.size()), tail);
+        size_t entries = 0;
+        for (size_t at = series.find("<DataSet"); at != std::string::npos; at = series.find("<DataSet", at + 1)) entries++;
+        EXPECT_EQ(entries, static_cast<size_t>(s + 1));
+
+        // An entry costs its own line and the closing tags, however long the list
+        const uint64_t bytes = writer.getStats().seriesBytesWritten;
+        if (s > 0) {
+            EXPECT_LT(bytes - previousBytes, 2 * tail.size() + 64);
+        }
+        previousBytes = bytes;
+    }
+    writer.close();
+    EXPECT_EQ(writer.getStats().seriesWrites, 7u);
+}
+
+TEST(TestSnapshotWriter, RejectsBadArgumentsAndReportsWriteErrors) {
+    Polygon polygon = makeNotchedPolygon();
+    const FDMGrid grid(31, 29, polygon);
+    const TemporaryDirectory directory("pde_solver_snapshot_errors");
+    EXPECT_THROW(SnapshotWriter(grid, directory.get(), ""), std::invalid_argument);
+    EXPECT_THROW(SnapshotWriter(grid, directory.get(), "u", 0), std::invalid_argument);
+    EXPECT_THROW(SnapshotWriter(grid, directory.get() + "/missing"), std::runtime_error);
+
+    SnapshotWriter writer(grid, directory.get(), "u", 1);
+    EXPECT_THROW(writer.submit(GridField(grid.getNx() + 1, grid.getNy()), 0.0), std::invalid_argument);
+
+    // The directory vanishes under the writer; the failure surfaces on the solver thread
+    const GridField u(grid.getNx(), grid.getNy(), 1.0);
+    writer.submit(u, 0.0);
+    writer.flush();
+    std::filesystem::remove_all(directory.get());
+    writer.submit(u, 1.0);
+    EXPECT_THROW(writer.flush(), std::runtime_error);
+    EXPECT_THROW(writer.submit(u, 2.0), std::runtime_error);
+    EXPECT_THROW(writer.close(), std::runtime_error);
+    EXPECT_EQ(writer.getStats().written, 1u);
+}
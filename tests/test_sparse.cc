@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "SparseMatrix.h"
+#include "test_common.h"
+#include <cmath>
+#include <random>
+
+namespace {
+    AlignedVector<double> randomVector(size_t n, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        AlignedVector<double> v(n);
+        for (double& x : v) x = dist(rng);
+        return v;
+    }
+}
+
+TEST(TestCsrMatrix, MatchesStencilOperator) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(57, 49, polygon);
+    PoissonOperator op(grid);
+    CsrMatrix csr(op);
+
+    const int32_t n = op.getUnknownCount();
+    ASSERT_EQ(csr.getRowCount(), n);
+    EXPECT_EQ(csr.getNonzeroCount(), 5 * static_cast<int64_t>(n) - static_cast<int64_t>(op.getBoundaryCouplings().size()));
+
+    const AlignedVector<double> x = randomVector(n, 7);
+    AlignedVector<double> expected(n), actual(n);
+    op.apply(x, expected);
+    csr.multiply(x, actual);
+    for (int32_t k = 0; k < n; k++) {
+        ASSERT_NEAR(actual[k], expected[k], 1e-12 * std::abs(op.getDiagonal()[k])) << "row " << k;
+    }
+}
+
+TEST(TestCsrMatrix, IsSymmetricWithSortedRows) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(33, 41, polygon);
+    PoissonOperator op(grid);
+    CsrMatrix csr(op);
+
+    auto entry = [&](int32_t row, int32_t column) {
+        std::span<const int32_t> columns = csr.getRowColumns(row);
+        auto it = std::lower_bound(columns.begin(), columns.end(), column);
+        return it != columns.end() && *it == column ? csr.getRowValues(row)[it - columns.begin()] : 0.0;
+    };
+    for (int32_t k = 0; k < csr.getRowCount(); k++) {
+        std::span<const int32_t> columns = csr.getRowColumns(k);
+        ASSERT_TRUE(std::is_sorted(columns.begin(), columns.end()));
+        for (int32_t column : columns) {
+            ASSERT_EQ(entry(k, column), entry(column, k));
+        }
+    }
+}
+
+TEST(TestCsrMatrix, RejectsInconsistentArrays) {
+    EXPECT_NO_THROW(CsrMatrix(2, {0, 1, 2}, {0, 1}, {1.0, 1.0}));
+    EXPECT_THROW(CsrMatrix(2, {0, 1}, {0}, {1.0}), std::invalid_argument);
+    EXPECT_THROW(CsrMatrix(2, {0, 1, 2}, {0, 2}, {1.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(CsrMatrix(2, {0, 2, 2}, {1, 0}, {1.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(CsrMatrix(2, {0, 1, 3}, {0, 1}, {1.0, 1.0}), std::invalid_argument);
+}
+
+TEST(TestSellMatrix, MatchesCsrBitwise) {
+    Polygon polygon = makeNotchedPolygon();
+    for (unsigned threads : {1u, 3u}) {
+        FDMGrid grid(301, 287, polygon, threads);
+        PoissonOperator op(grid);
+        CsrMatrix csr(op);
+
+        const int32_t n = csr.getRowCount();
+        const AlignedVector<double> x = randomVector(n, 11);
+        AlignedVector<double> expected(n);
+        csr.multiply(x, expected);
+
+        for (int c : {1, 4, 8, 16}) {
+            for (int sigma : {1, 4 * c, 256}) {
+                for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+                    SellMatrix sell(csr, c, sigma, level);
+                    EXPECT_EQ(sell.getNonzeroCount(), csr.getNonzeroCount());
+                    AlignedVector<double> actual(n, std::nan(""));
+                    sell.multiply(x, actual);
+                    for (int32_t k = 0; k < n; k++) {
+                        ASSERT_EQ(actual[k], expected[k]) << "C = " << c << ", sigma = " << sigma << ", row " << k;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(TestSellMatrix, SortingReducesPadding) {
+    Polygon polygon = makeNotchedPolygon();
+    FDMGrid grid(200, 200, polygon);
+    CsrMatrix csr{PoissonOperator(grid)};
+
+    const SellMatrix unsorted(csr, 8, 1);
+    const SellMatrix sorted(csr, 8, 256);
+    EXPECT_GT(unsorted.getPaddingRatio(), 0.0);
+    EXPECT_LT(sorted.getPaddingRatio(), unsorted.getPaddingRatio());
+    EXPECT_GE(sorted.getStoredCount(), sorted.getNonzeroCount());
+}
+
+TEST(TestSellMatrix, RejectsInvalidShape) {
+    CsrMatrix csr(2, {0, 1, 2}, {0, 1}, {1.0, 1.0});
+    EXPECT_THROW(SellMatrix(csr, 0), std::invalid_argument);
+    EXPECT_THROW(SellMatrix(csr, 6), std::invalid_argument);
+    EXPECT_THROW(SellMatrix(csr, 128), std::invalid_argument);
+    EXPECT_THROW(SellMatrix(csr, 8, 12), std::invalid_argument);
+    EXPECT_NO_THROW(SellMatrix(csr, 8, 1));
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "Parallel.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+TEST(TestThreadPool, RunsEveryTileOnce) {
+    ThreadPool pool({3});
+    ASSERT_EQ(pool.getWorkerCount(), 3u);
+    std::vector<std::atomic<int>> visits(1005);
+    pool.run(5, 1005, 7, 4, [&](int first, int last) {
+        EXPECT_EQ((first - 5) % 7, 0);
+        EXPECT_EQ(last, std::min(1005, first + 7));
+        for (int k = first; k < last; k++) visits[k]++;
+    });
+    for (int k = 0; k < 1005; k++) ASSERT_EQ(visits[k], k >= 5 ? 1 : 0) << k;
+
+    const SchedulerStats stats = pool.getStats();
+    EXPECT_EQ(stats.jobs, 1u);
+    EXPECT_EQ(stats.tasks, 143u);
+    pool.resetStats();
+    EXPECT_EQ(pool.getStats().tasks, 0u);
+}
+
+TEST(TestThreadPool, LoopsNest) {
+    ThreadPool pool({3});
+    std::atomic<int> total = 0;
+    pool.run(0, 16, 1, 4, [&](int first, int last) {
+        for (int outer = first; outer < last; outer++) {
+            pool.run(0, 100, 10, 4, [&](int a, int b) { total += b - a; });
+        }
+    });
+    EXPECT_EQ(total, 1600);
+    EXPECT_EQ(pool.getStats().jobs, 17u);
+}
+
+TEST(TestThreadPool, RespectsThreadLimit) {
+    ThreadPool pool({4});
+    std::atomic<int> running = 0, peak = 0;
+    std::atomic<int> lastWorker = -2;
+    pool.run(0, 40, 1, 2, [&](int, int) {
+        const int now = ++running;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+        lastWorker = ThreadPool::currentWorker();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        running--;
+    });
+    EXPECT_LE(peak, 2);
+    EXPECT_GE(lastWorker, -1);
+    EXPECT_LT(lastWorker, 4);
+    EXPECT_EQ(ThreadPool::currentWorker(), -1);
+}
+
+TEST(TestThreadPool, PropagatesExceptions) {
+    ThreadPool pool({2});
+    std::atomic<int> ran = 0;
+    EXPECT_THROW(pool.run(0, 64, 1, 3, [&](int first, int) {
+        ran++;
+        if (first == 13) throw std::runtime_error("tile failed");
+    }), std::runtime_error);
+    // Every tile still ran and the pool stays usable
+    EXPECT_EQ(ran, 64);
+    std::atomic<int> after = 0;
+    pool.run(0, 10, 1, 3, [&](int first, int last) { after += last - first; });
+    EXPECT_EQ(after, 10);
+}
+
+TEST(TestThreadPool, IdleThreadsStealFromBusyOnes) {
+    ThreadPool pool({3});
+    // The caller's group holds every slow tile; the workers finish theirs and steal
+    pool.run(0, 32, 1, 4, [&](int first, int) {
+        if (first < 8) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+    const SchedulerStats stats = pool.getStats();
+    EXPECT_EQ(stats.tasks, 32u);
+    EXPECT_GT(stats.steals, 0u);
+    EXPECT_GE(stats.idleMilliseconds, 0.0);
+
+    uint64_t perWorker = 0;
+    for (unsigned w = 0; w <= pool.getWorkerCount(); w++) perWorker += pool.getWorkerStats(w).tasks;
+    EXPECT_EQ(perWorker, stats.tasks);
+}
+
+TEST(TestParallel, ReduceIsIndependentOfThreadCount) {
+    const int n = 100003, grain = 997;
+    auto term = [](int k) { return std::sin(0.001 * k) / (1.0 + k); };
+
+    double expected = 0.0;
+    for (int first = 0; first < n; first += grain) {
+        double partial = 0.0;
+        for (int k = first; k < std::min(n, first + grain); k++) partial += term(k);
+        expected += partial;
+    }
+    for (unsigned threads : {1u, 2u, 3u, 4u, 0u}) {
+        const double actual = parallelReduce(0, n, grain, threads, 0.0, [&](int first, int last) {
+            double partial = 0.0;
+            for (int k = first; k < last; k++) partial += term(k);
+            return partial;
+        }, [](double a, double b) { return a + b; });
+        EXPECT_EQ(actual, expected) << threads << " threads";
+    }
+    EXPECT_EQ(parallelReduce(3, 3, 10, 2, 7, [](int, int) { return 1; }, [](int a, int b) { return a + b; }), 7);
+
+    // Neighbouring bool partials are written by different threads
+    for (int round = 0; round < 20; round++) {
+        const bool all = parallelReduce(0, 4096, 1, 4, true, [](int, int) { return true; }, [](bool a, bool b) { return a && b; });
+        ASSERT_TRUE(all) << "round " << round;
+    }
+}
+
+TEST(TestParallel, GlobalPoolIsConfiguredBeforeUse) {
+    std::vector<int> values(1000, 0);
+    parallelFor(0, 1000, 16, 4, [&](int first, int last) {
+        for (int k = first; k < last; k++) values[k] = k;
+    });
+    for (int k = 0; k < 1000; k++) ASSERT_EQ(values[k], k);
+    EXPECT_THROW(ThreadPool::configureGlobal({2}), std::logic_error);
+}